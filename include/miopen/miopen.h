@@ -2842,6 +2842,47 @@ MIOPEN_EXPORT miopenStatus_t miopenDestroyFusionPlan(miopenFusionPlanDescriptor_
 MIOPEN_EXPORT miopenStatus_t miopenCompileFusionPlan(miopenHandle_t handle,
                                                      miopenFusionPlanDescriptor_t fusePlanDesc);
 
+/*! @enum miopenFusionCompileMode_t
+ * @brief Which of the applicable fused solutions miopenCompileFusionPlan builds
+ *
+ * Executing a plan always runs the solution with the highest weight that could be built.
+ */
+typedef enum
+{
+    miopenFusionCompileAll = 0, /*!< Build all of them before returning (default) */
+    miopenFusionCompileBestFirst =
+        1, /*!< Build the solution with the highest weight before returning, or the next one if
+              it fails to build, and the others on a background thread */
+    miopenFusionCompileBestOnly =
+        2, /*!< Build the solution with the highest weight, or the next one if it fails to build,
+              and nothing else */
+} miopenFusionCompileMode_t;
+
+/*! @brief Sets how the next miopenCompileFusionPlan call builds the fused solutions
+ *
+ * With miopenFusionCompileBestFirst, the background thread uses the handle passed to
+ * miopenCompileFusionPlan, and miopenDestroy waits for it to finish. The plan may be destroyed
+ * meanwhile. The next compilation of the plan waits for the background thread too, and with the
+ * same handle does not build the solutions it built again.
+ *
+ * @param fusePlanDesc A fusion plan descriptor (input)
+ * @param mode         Compile mode (input)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFusionPlanSetCompileMode(
+    miopenFusionPlanDescriptor_t fusePlanDesc, miopenFusionCompileMode_t mode);
+
+/*! @brief Reports the progress of the fusion plan compilation
+ *
+ * @param fusePlanDesc A fusion plan descriptor (input)
+ * @param built        Number of applicable solutions that have been built (output)
+ * @param pending      Number of applicable solutions that are waiting for or being built on the
+ *                     background thread (output)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFusionPlanGetCompileStatus(
+    miopenFusionPlanDescriptor_t fusePlanDesc, size_t* built, size_t* pending);
+
 /*!
  * @brief Allows access to the operators in a fusion plan
  * @details This api call does bounds checking on the supplied op_idx and would
@@ -4769,10 +4810,27 @@ typedef enum
  */
 typedef enum
 {
-    miopenTensorArgumentIdInvalid = 0,
-    miopenTensorConvolutionX      = 1,
-    miopenTensorConvolutionW      = 2,
-    miopenTensorConvolutionY      = 3,
+    miopenTensorArgumentIdInvalid         = 0,
+    miopenTensorConvolutionX              = 1,
+    miopenTensorConvolutionW              = 2,
+    miopenTensorConvolutionY              = 3,
+    miopenTensorPoolingX                  = 4,
+    miopenTensorPoolingY                  = 5,
+    miopenTensorPoolingDX                 = 6,
+    miopenTensorPoolingDY                 = 7,
+    miopenTensorPoolingIndices            = 8,
+    miopenTensorBatchnormX                = 9,
+    miopenTensorBatchnormY                = 10,
+    miopenTensorBatchnormDX               = 11,
+    miopenTensorBatchnormDY               = 12,
+    miopenTensorBatchnormScale            = 13,
+    miopenTensorBatchnormBias             = 14,
+    miopenTensorBatchnormScaleDiff        = 15,
+    miopenTensorBatchnormBiasDiff         = 16,
+    miopenTensorBatchnormRunningMean      = 17,
+    miopenTensorBatchnormRunningVariance  = 18,
+    miopenTensorBatchnormSavedMean        = 19,
+    miopenTensorBatchnormSavedInvVariance = 20,
 } miopenTensorArgumentId_t;
 
 /*! @enum miopenTensorArgumentId_t
@@ -4901,6 +4959,30 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                    size_t* numSolutions,
                                    size_t maxSolutions);
 
+/*! @brief Finds solutions to several problems at once, such as all convolutions of a network.
+ *
+ * Problems with the same configuration are solved only once, and the kernels of all the problems
+ * are built in a single parallel pass before the benchmarks. The results of the problem i are
+ * written starting from solutions[i * maxSolutions].
+ *
+ * @param handle       Handle to execute the kernels
+ * @param problems     Problems to solve
+ * @param numProblems  Number of the problems
+ * @param options      Find options. When null default values would be used. Preallocated tensors
+ *                     are used by all the problems and must fit the largest of them
+ * @param solutions    Array of numProblems * maxSolutions results. Must not be null
+ * @param numSolutions Array of numProblems amounts of results. Ignored if null
+ * @param maxSolutions Limits the amount of results of each problem
+ * @return             miopenStatus_t
+ */
+miopenStatus_t miopenFindSolutionsBatched(miopenHandle_t handle,
+                                          const miopenProblem_t* problems,
+                                          size_t numProblems,
+                                          miopenFindOptions_t options,
+                                          miopenSolution_t* solutions,
+                                          size_t* numSolutions,
+                                          size_t maxSolutions);
+
 /*! @brief Values of a tensor argument for the miopenRunSolution function.
  */
 struct miopenTensorArgument_t
@@ -4969,6 +5051,18 @@ miopenStatus_t miopenSaveSolution(miopenSolution_t solution, char* data);
  */
 miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size);
 
+/*! @brief Embeds the code objects of the solution kernels into the solution.
+ *
+ * Kernels that were not built yet are compiled. The code objects are saved with the solution by
+ * miopenSaveSolution, so a solution loaded on another node of the same target runs without
+ * compiling kernels or reading the databases.
+ *
+ * @param handle   Handle to build the kernels with
+ * @param solution Solution to embed the kernels into
+ * @return         miopenStatus_t
+ */
+miopenStatus_t miopenEmbedSolutionKernels(miopenHandle_t handle, miopenSolution_t solution);
+
 /*! @brief Reads the amount of workspace required to exectute the solution.
  *
  * @param solution      Solution to get required workspace size
@@ -4985,6 +5079,223 @@ miopenStatus_t miopenGetSolutionWorkspaceSize(miopenSolution_t solution, size_t*
  */
 miopenStatus_t miopenGetSolutionTime(miopenSolution_t solution, float* time);
 
+/*! @brief Builds ahead of time the kernels immediate mode would use to solve the problems.
+ *
+ * Resolves the solution of every problem the same way the immediate mode does and compiles all
+ * the kernels required into the kernel cache in parallel. Kernels shared by several problems are
+ * compiled once. Calling it with all the layers of a network before its first run hides most of
+ * the compilation latency of the first iteration.
+ *
+ * @param handle      Handle to compile the kernels for
+ * @param problems    Pointer to the first problem
+ * @param numProblems Amount of problems
+ * @return            miopenStatus_t
+ */
+miopenStatus_t miopenPrecompileProblems(miopenHandle_t handle,
+                                        const miopenProblem_t* problems,
+                                        size_t numProblems);
+
+/*! @brief Same as miopenPrecompileProblems, with the problems read from a file.
+ *
+ * Each line of the file is an MIOpenDriver convolution command, like the ones in the perf_models
+ * directory. One problem is made for each direction enabled by the --forw flag. Other lines are
+ * ignored.
+ *
+ * @param handle  Handle to compile the kernels for
+ * @param path    Path to the file with the driver commands
+ * @return        miopenStatus_t
+ */
+miopenStatus_t miopenPrecompileDriverCommands(miopenHandle_t handle, const char* path);
+
+/*! @brief The miopenPlan object holds a problem resolved once for repeated execution.
+ *
+ * A plan keeps the prepared kernels, the workspace requirement and the validated tensor
+ * descriptors of the problem, so running it only binds the buffers. A plan must not be run from
+ * several threads at the same time.
+ */
+MIOPEN_DECLARE_OBJECT(miopenPlan);
+
+/*! @brief Creates a plan for a convolution problem, with the solution immediate mode would use.
+ *
+ * @param plan    Pointer to the plan to create
+ * @param handle  Handle to prepare the kernels with
+ * @param problem Convolution problem with all the tensor descriptors set
+ * @return        miopenStatus_t
+ */
+miopenStatus_t
+miopenCreateConvolutionPlan(miopenPlan_t* plan, miopenHandle_t handle, miopenProblem_t problem);
+
+/*! @brief Creates a plan from a solution returned by miopenFindSolutions or miopenLoadSolution.
+ *
+ * @param plan     Pointer to the plan to create
+ * @param handle   Handle to prepare the kernels with
+ * @param solution Solution to create the plan from
+ * @return         miopenStatus_t
+ */
+miopenStatus_t
+miopenCreatePlanFromSolution(miopenPlan_t* plan, miopenHandle_t handle, miopenSolution_t solution);
+
+/*! @brief Creates a plan for a forward pooling.
+ *
+ * The plan takes miopenTensorPoolingX and miopenTensorPoolingY arguments. When the indices are
+ * saved, it also takes miopenTensorPoolingIndices of the size reported by
+ * miopenPoolingGetWorkSpaceSizeV2.
+ *
+ * @param plan      Pointer to the plan to create
+ * @param handle    Handle to prepare the kernels with
+ * @param poolDesc  Descriptor of the pooling
+ * @param xDesc     Descriptor of the input tensor
+ * @param yDesc     Descriptor of the output tensor
+ * @param saveIndex Whether the indices of the max values are saved for the backward pooling
+ * @return          miopenStatus_t
+ */
+miopenStatus_t miopenCreatePoolingForwardPlan(miopenPlan_t* plan,
+                                              miopenHandle_t handle,
+                                              const miopenPoolingDescriptor_t poolDesc,
+                                              const miopenTensorDescriptor_t xDesc,
+                                              const miopenTensorDescriptor_t yDesc,
+                                              bool saveIndex);
+
+/*! @brief Creates a plan for a backward pooling.
+ *
+ * The plan takes miopenTensorPoolingDY and miopenTensorPoolingDX arguments, and also
+ * miopenTensorPoolingIndices for the max pooling.
+ *
+ * @param plan     Pointer to the plan to create
+ * @param handle   Handle to prepare the kernels with
+ * @param poolDesc Descriptor of the pooling
+ * @param yDesc    Descriptor of the output tensor of the forward pooling
+ * @param dyDesc   Descriptor of the output gradient tensor
+ * @param xDesc    Descriptor of the input tensor of the forward pooling
+ * @param dxDesc   Descriptor of the input gradient tensor
+ * @return         miopenStatus_t
+ */
+miopenStatus_t miopenCreatePoolingBackwardPlan(miopenPlan_t* plan,
+                                               miopenHandle_t handle,
+                                               const miopenPoolingDescriptor_t poolDesc,
+                                               const miopenTensorDescriptor_t yDesc,
+                                               const miopenTensorDescriptor_t dyDesc,
+                                               const miopenTensorDescriptor_t xDesc,
+                                               const miopenTensorDescriptor_t dxDesc);
+
+/*! @brief Creates a plan for a forward inference batch normalization.
+ *
+ * The plan takes miopenTensorBatchnormX, miopenTensorBatchnormY, miopenTensorBatchnormScale,
+ * miopenTensorBatchnormBias, and the estimated statistics as miopenTensorBatchnormRunningMean and
+ * miopenTensorBatchnormRunningVariance arguments.
+ *
+ * @param plan                   Pointer to the plan to create
+ * @param handle                 Handle to prepare the kernels with
+ * @param bn_mode                Batch normalization mode
+ * @param xDesc                  Descriptor of the input tensor
+ * @param yDesc                  Descriptor of the output tensor
+ * @param bnScaleBiasMeanVarDesc Descriptor of the scale, bias, mean and variance tensors
+ * @param epsilon                Value added to the variance
+ * @return                       miopenStatus_t
+ */
+miopenStatus_t
+miopenCreateBatchNormForwardInferencePlan(miopenPlan_t* plan,
+                                          miopenHandle_t handle,
+                                          miopenBatchNormMode_t bn_mode,
+                                          const miopenTensorDescriptor_t xDesc,
+                                          const miopenTensorDescriptor_t yDesc,
+                                          const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                          double epsilon);
+
+/*! @brief Creates a plan for a forward training batch normalization.
+ *
+ * The plan takes miopenTensorBatchnormX, miopenTensorBatchnormY, miopenTensorBatchnormScale and
+ * miopenTensorBatchnormBias arguments. It also takes miopenTensorBatchnormRunningMean and
+ * miopenTensorBatchnormRunningVariance when updateRunning is set, and
+ * miopenTensorBatchnormSavedMean and miopenTensorBatchnormSavedInvVariance when saveResults is set.
+ *
+ * @param plan                   Pointer to the plan to create
+ * @param handle                 Handle to prepare the kernels with
+ * @param bn_mode                Batch normalization mode
+ * @param xDesc                  Descriptor of the input tensor
+ * @param yDesc                  Descriptor of the output tensor
+ * @param bnScaleBiasMeanVarDesc Descriptor of the scale, bias, mean and variance tensors
+ * @param expAvgFactor           Factor of the running average
+ * @param epsilon                Value added to the variance
+ * @param updateRunning          Whether the running mean and variance are updated
+ * @param saveResults            Whether the mean and inverse variance are saved for the backward
+ * @return                       miopenStatus_t
+ */
+miopenStatus_t
+miopenCreateBatchNormForwardTrainingPlan(miopenPlan_t* plan,
+                                         miopenHandle_t handle,
+                                         miopenBatchNormMode_t bn_mode,
+                                         const miopenTensorDescriptor_t xDesc,
+                                         const miopenTensorDescriptor_t yDesc,
+                                         const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                         double expAvgFactor,
+                                         double epsilon,
+                                         bool updateRunning,
+                                         bool saveResults);
+
+/*! @brief Creates a plan for a backward batch normalization.
+ *
+ * The plan takes miopenTensorBatchnormX, miopenTensorBatchnormDY, miopenTensorBatchnormDX,
+ * miopenTensorBatchnormScale, miopenTensorBatchnormScaleDiff and miopenTensorBatchnormBiasDiff
+ * arguments. It also takes miopenTensorBatchnormSavedMean and
+ * miopenTensorBatchnormSavedInvVariance when useSaved is set.
+ *
+ * @param plan                Pointer to the plan to create
+ * @param handle              Handle to prepare the kernels with
+ * @param bn_mode             Batch normalization mode
+ * @param xDesc               Descriptor of the input tensor
+ * @param dyDesc              Descriptor of the output gradient tensor
+ * @param dxDesc              Descriptor of the input gradient tensor
+ * @param bnScaleBiasDiffDesc Descriptor of the scale, bias and their gradient tensors
+ * @param epsilon             Value added to the variance
+ * @param useSaved            Whether the mean and inverse variance saved by the forward are used
+ * @return                    miopenStatus_t
+ */
+miopenStatus_t miopenCreateBatchNormBackwardPlan(miopenPlan_t* plan,
+                                                 miopenHandle_t handle,
+                                                 miopenBatchNormMode_t bn_mode,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const miopenTensorDescriptor_t dyDesc,
+                                                 const miopenTensorDescriptor_t dxDesc,
+                                                 const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                                 double epsilon,
+                                                 bool useSaved);
+
+/*! @brief Reads the amount of workspace required to run the plan.
+ *
+ * @param plan          Plan to get the required workspace size
+ * @param workspaceSize Pointer to a location where to write the workspace size
+ * @return              miopenStatus_t
+ */
+miopenStatus_t miopenGetPlanWorkspaceSize(miopenPlan_t plan, size_t* workspaceSize);
+
+/*! @brief Runs the plan using the passed in buffers.
+ *
+ * Overriding the tensor descriptors is not supported, the descriptor of each argument must be
+ * null.
+ *
+ * @param handle        Handle to execute the kernels
+ * @param plan          Plan to run
+ * @param nArguments    Amount of the tensor arguments
+ * @param arguments     Tensor arguments described by miopenTensorArgument_t
+ * @param workspace     Pointer to device buffer used as workspace. May be null when not required
+ * @param workspaceSize Size of the workspace buffer
+ * @return              miopenStatus_t
+ */
+miopenStatus_t miopenRunPlan(miopenHandle_t handle,
+                             miopenPlan_t plan,
+                             size_t nArguments,
+                             const miopenTensorArgument_t* arguments,
+                             void* workspace,
+                             size_t workspaceSize);
+
+/*! @brief Destroys plan object.
+ *
+ * @param plan Plan to destroy
+ * @return     miopenStatus_t
+ */
+miopenStatus_t miopenDestroyPlan(miopenPlan_t plan);
+
 /** @} */
 // CLOSEOUT find2 DOXYGEN GROUP
 
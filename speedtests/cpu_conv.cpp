@@ -0,0 +1,137 @@
+#include <cpu_conv.hpp>
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_conv {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch_size, "batch-size");
+        add(naive, "naive");
+    }
+
+    void run()
+    {
+        struct Shape
+        {
+            std::string name;
+            std::vector<std::size_t> in;
+            std::vector<std::size_t> wei;
+            std::vector<int> pads;
+            std::vector<int> strides;
+        };
+        const auto n = static_cast<std::size_t>(batch_size);
+        // clang-format off
+        const auto shapes = std::vector<Shape>{
+            {"resnet 7x7 s2",  {n, 3, 224, 224},  {64, 3, 7, 7},    {3, 3}, {2, 2}},
+            {"resnet 3x3",     {n, 64, 56, 56},   {64, 64, 3, 3},   {1, 1}, {1, 1}},
+            {"resnet 1x1",     {n, 256, 56, 56},  {64, 256, 1, 1},  {0, 0}, {1, 1}},
+            {"resnet 3x3 s2",  {n, 128, 56, 56},  {128, 128, 3, 3}, {1, 1}, {2, 2}},
+            {"resnet 3x3 7x7", {n, 512, 7, 7},    {512, 512, 3, 3}, {1, 1}, {1, 1}},
+        };
+        // clang-format on
+
+        for(const auto& shape : shapes)
+        {
+            const auto dilations = std::vector<int>{1, 1};
+            auto rng             = std::mt19937{42};
+            const auto in        = Random(shape.in, rng);
+            const auto wei       = Random(shape.wei, rng);
+            auto out_lens        = std::vector<std::size_t>{shape.in[0], shape.wei[0]};
+            for(auto i = 0; i < 2; ++i)
+            {
+                const auto padded = shape.in[i + 2] + 2 * shape.pads[i];
+                out_lens.push_back((padded - shape.wei[i + 2]) / shape.strides[i] + 1);
+            }
+            const auto out = Random(out_lens, rng);
+
+            const auto& pads    = shape.pads;
+            const auto& strides = shape.strides;
+
+            const auto fwd = [&](auto& y) {
+                cpu_convolution_forward(2, in, wei, y, pads, strides, dilations, 1);
+            };
+            const auto fwd_naive = [&](auto& y) {
+                cpu_convolution_forward_impl<2, double>(in, wei, y, pads, strides, dilations, 1);
+            };
+            const auto bwd = [&](auto& x) {
+                cpu_convolution_backward_data(2, x, wei, out, pads, strides, dilations, 1);
+            };
+            const auto bwd_naive = [&](auto& x) {
+                cpu_convolution_backward_data_impl<2, double>(
+                    x, wei, out, pads, strides, dilations, 1);
+            };
+            const auto wrw = [&](auto& w) {
+                cpu_convolution_backward_weight(2, in, w, out, pads, strides, dilations, 1);
+            };
+            const auto wrw_naive = [&](auto& w) {
+                cpu_convolution_backward_weight_impl<2, double>(
+                    in, w, out, pads, strides, dilations, 1);
+            };
+
+            std::cout << shape.name << ":" << std::endl;
+            Time("fwd", fwd, fwd_naive, out);
+            Time("bwd", bwd, bwd_naive, in);
+            Time("wrw", wrw, wrw_naive, wei);
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Measures the CPU reference convolutions on ResNet-50 layers. --naive 1 also "
+                     "times the naive loops and reports the speedup."
+                  << std::endl;
+    }
+
+private:
+    int batch_size = 1;
+    int naive      = 1;
+
+    static tensor<float> Random(const std::vector<std::size_t>& lens, std::mt19937& rng)
+    {
+        auto ret  = tensor<float>{lens};
+        auto dist = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+        for(auto& x : ret.data)
+            x = dist(rng);
+        return ret;
+    }
+
+    template <typename Gemm, typename Naive>
+    void Time(const std::string& name, Gemm gemm, Naive naive_fn, tensor<float> result) const
+    {
+        const auto gemm_time = Seconds([&]() { gemm(result); });
+        std::cout << "    " << name << ": im2col+gemm " << gemm_time << " s";
+        if(naive != 0)
+        {
+            const auto naive_time = Seconds([&]() { naive_fn(result); });
+            std::cout << ", naive " << naive_time << " s, speedup " << naive_time / gemm_time;
+        }
+        std::cout << std::endl;
+    }
+
+    template <typename F>
+    static double Seconds(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+} // namespace cpu_conv
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_conv::SpeedTestDriver>(argc, argv);
+    return 0;
+}
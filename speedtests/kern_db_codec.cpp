@@ -0,0 +1,143 @@
+#include <miopen/config.h>
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if MIOPEN_ENABLE_SQLITE
+namespace miopen {
+namespace kern_db_codec {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(kernels, "kernels");
+        add(blob_size, "blob-size");
+        add(blob_path, "blob");
+    }
+
+    void run()
+    {
+        const auto blobs = MakeBlobs();
+
+        std::cout << "Kernels: " << blobs.size() << ", blob size: " << blobs.front().size()
+                  << std::endl;
+
+        Test("bz2", KernelCodec::Bzip2, blobs);
+        Test("lz4", KernelCodec::Lz4, blobs);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Measures the time to load the kernels from a kernel database with each "
+                     "codec. --blob replaces the synthetic kernels by copies of a code object."
+                  << std::endl;
+    }
+
+private:
+    int iterations        = 10;
+    int kernels           = 256;
+    int blob_size         = 256 * 1024;
+    std::string blob_path = "";
+
+    /// Code objects are mostly instructions, with a limited set of distinct words.
+    std::vector<std::string> MakeBlobs() const
+    {
+        auto ret = std::vector<std::string>{};
+
+        if(!blob_path.empty())
+        {
+            std::ifstream file{blob_path, std::ios::binary};
+            const auto blob = std::string{std::istreambuf_iterator<char>{file}, {}};
+            ret.assign(kernels, blob);
+            return ret;
+        }
+
+        auto rng   = std::mt19937{42};
+        auto words = std::vector<std::uint64_t>(512);
+        for(auto& word : words)
+            word = (std::uint64_t{rng()} << 32) | rng();
+
+        for(auto i = 0; i < kernels; ++i)
+        {
+            auto blob = std::string(blob_size, '\0');
+            for(std::size_t j = 0; j + sizeof(std::uint64_t) <= blob.size();
+                j += sizeof(std::uint64_t))
+            {
+                const auto word = words[rng() % words.size()];
+                std::memcpy(&blob[j], &word, sizeof(word));
+            }
+            ret.push_back(std::move(blob));
+        }
+
+        return ret;
+    }
+
+    void Test(const std::string& name, KernelCodec codec, const std::vector<std::string>& blobs)
+    {
+        TempFile temp_file{"kern_db_codec"};
+        auto db = KernDb{temp_file.Path(), false, codec};
+
+        auto configs = std::vector<KernelConfig>{};
+        for(std::size_t i = 0; i < blobs.size(); ++i)
+            configs.push_back({"kernel" + std::to_string(i) + ".o", "-DCODEC_TEST", blobs[i]});
+
+        const auto store_start = std::chrono::steady_clock::now();
+        for(const auto& config : configs)
+            db.StoreRecordUnsafe(config);
+        const auto store_time = Seconds(store_start);
+
+        auto loaded           = std::size_t{0};
+        const auto load_start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+        {
+            for(const auto& config : configs)
+            {
+                const auto key = KernelConfig{config.kernel_name, config.kernel_args, ""};
+                loaded += db.FindRecordUnsafe(key)->size();
+            }
+        }
+        const auto load_time = Seconds(load_start);
+
+        std::cout << name << ": db size " << boost::filesystem::file_size(temp_file.Path())
+                  << " bytes, store " << store_time << " s, load "
+                  << load_time * 1000 * 1000 / (iterations * configs.size()) << " us/kernel ("
+                  << loaded / load_time / 1024 / 1024 << " MB/s)" << std::endl;
+    }
+
+    static double Seconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+} // namespace kern_db_codec
+} // namespace miopen
+#endif
+
+int main(int argc, const char* argv[])
+{
+#if MIOPEN_ENABLE_SQLITE
+    test_drive<miopen::kern_db_codec::SpeedTestDriver>(argc, argv);
+#else
+    std::ignore = argc;
+    std::ignore = argv;
+    std::cout << "Kernel databases require MIOPEN_ENABLE_SQLITE" << std::endl;
+#endif
+    return 0;
+}
@@ -26,6 +26,7 @@
 
 #include <miopen/activ/problem_description.hpp>
 #include <miopen/names.hpp>
+#include <miopen/problem_key.hpp>
 
 #include <sstream>
 
@@ -76,6 +77,14 @@ NetworkConfig ProblemDescription::MakeNetworkConfig() const
     return NetworkConfig{ss.str()};
 }
 
+ProblemKey ProblemDescription::MakeProblemKey() const
+{
+    auto key = ProblemKey{'a'};
+    // Alpha, beta and gamma are passed at invoke time and left out like in the network config.
+    key.Add(direction).Add(xDesc).Add(yDesc).Add(dxDesc).Add(dyDesc).Add(activDesc.GetMode());
+    return key;
+}
+
 } // namespace activ
 
 } // namespace miopen
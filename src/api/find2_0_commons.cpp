@@ -29,7 +29,11 @@
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/batch_norm.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/plan.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/precompile.hpp>
 #include <miopen/problem.hpp>
 #include <miopen/search_options.hpp>
 #include <miopen/solution.hpp>
@@ -37,6 +41,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <fstream>
+
 extern "C" {
 miopenStatus_t miopenCreateConvProblem(miopenProblem_t* problem,
                                        miopenConvolutionDescriptor_t operatorDesc,
@@ -164,6 +170,47 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
     });
 }
 
+miopenStatus_t miopenFindSolutionsBatched(miopenHandle_t handle,
+                                          const miopenProblem_t* problems,
+                                          size_t numProblems,
+                                          miopenFindOptions_t options,
+                                          miopenSolution_t* solutions,
+                                          size_t* numSolutions,
+                                          size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, problems, numProblems, options, solutions, numSolutions, maxSolutions);
+
+    return miopen::try_([&] {
+        if(problems == nullptr && numProblems != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Problems parameter should not be a nullptr.");
+
+        auto problems_deref = std::vector<miopen::Problem>{};
+        problems_deref.reserve(numProblems);
+        for(std::size_t i = 0; i < numProblems; ++i)
+        {
+            problems_deref.push_back(miopen::deref(problems[i]));
+            problems_deref.back().LogDriverCommand();
+        }
+
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+
+        auto solutions_deref = miopen::FindSolutions(
+            miopen::deref(handle), problems_deref, options_deref, maxSolutions);
+
+        for(std::size_t i = 0; i < solutions_deref.size(); ++i)
+        {
+            for(std::size_t j = 0; j < solutions_deref[i].size(); ++j)
+                miopen::deref(solutions + i * maxSolutions + j) =
+                    new miopen::Solution{std::move(solutions_deref[i][j])};
+
+            if(numSolutions != nullptr)
+                numSolutions[i] = solutions_deref[i].size();
+        }
+    });
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument_t& tensor)
 {
     switch(tensor.id)
@@ -171,6 +218,23 @@ inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument
     case miopenTensorConvolutionW: stream << "ConvW"; break;
     case miopenTensorConvolutionX: stream << "ConvX"; break;
     case miopenTensorConvolutionY: stream << "ConvY"; break;
+    case miopenTensorPoolingX: stream << "PoolingX"; break;
+    case miopenTensorPoolingY: stream << "PoolingY"; break;
+    case miopenTensorPoolingDX: stream << "PoolingDX"; break;
+    case miopenTensorPoolingDY: stream << "PoolingDY"; break;
+    case miopenTensorPoolingIndices: stream << "PoolingIndices"; break;
+    case miopenTensorBatchnormX: stream << "BatchnormX"; break;
+    case miopenTensorBatchnormY: stream << "BatchnormY"; break;
+    case miopenTensorBatchnormDX: stream << "BatchnormDX"; break;
+    case miopenTensorBatchnormDY: stream << "BatchnormDY"; break;
+    case miopenTensorBatchnormScale: stream << "BatchnormScale"; break;
+    case miopenTensorBatchnormBias: stream << "BatchnormBias"; break;
+    case miopenTensorBatchnormScaleDiff: stream << "BatchnormScaleDiff"; break;
+    case miopenTensorBatchnormBiasDiff: stream << "BatchnormBiasDiff"; break;
+    case miopenTensorBatchnormRunningMean: stream << "BatchnormRunningMean"; break;
+    case miopenTensorBatchnormRunningVariance: stream << "BatchnormRunningVariance"; break;
+    case miopenTensorBatchnormSavedMean: stream << "BatchnormSavedMean"; break;
+    case miopenTensorBatchnormSavedInvVariance: stream << "BatchnormSavedInvVariance"; break;
     case miopenTensorArgumentIdInvalid: stream << "Invalid"; break;
     }
 
@@ -280,6 +344,13 @@ miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size)
     });
 }
 
+miopenStatus_t miopenEmbedSolutionKernels(miopenHandle_t handle, miopenSolution_t solution)
+{
+    MIOPEN_LOG_FUNCTION(handle, solution);
+
+    return miopen::try_([&] { miopen::deref(solution).EmbedKernels(miopen::deref(handle)); });
+}
+
 miopenStatus_t miopenGetSolutionWorkspaceSize(miopenSolution_t solution, size_t* workspaceSize)
 {
     MIOPEN_LOG_FUNCTION(solution, workspaceSize);
@@ -299,4 +370,220 @@ miopenStatus_t miopenGetSolutionTime(miopenSolution_t solution, float* time)
         *time                      = solution_deref.GetTime();
     });
 }
+
+miopenStatus_t miopenPrecompileProblems(miopenHandle_t handle,
+                                        const miopenProblem_t* problems,
+                                        size_t numProblems)
+{
+    MIOPEN_LOG_FUNCTION(handle, problems, numProblems);
+
+    return miopen::try_([&] {
+        if(problems == nullptr && numProblems != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "problems cannot be nullptr");
+
+        auto problems_deref = std::vector<miopen::Problem>{};
+        problems_deref.reserve(numProblems);
+        for(auto i = std::size_t{0}; i < numProblems; ++i)
+            problems_deref.push_back(miopen::deref(problems[i]));
+
+        miopen::PrecompileProblems(miopen::deref(handle), problems_deref);
+    });
+}
+
+miopenStatus_t miopenPrecompileDriverCommands(miopenHandle_t handle, const char* path)
+{
+    MIOPEN_LOG_FUNCTION(handle, path);
+
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "path cannot be nullptr");
+
+        auto file = std::ifstream{path};
+        if(!file)
+            MIOPEN_THROW(miopenStatusBadParm, std::string{"Unable to open "} + path);
+
+        miopen::PrecompileProblems(miopen::deref(handle), miopen::ParseDriverCommands(file));
+    });
+}
+
+miopenStatus_t
+miopenCreateConvolutionPlan(miopenPlan_t* plan, miopenHandle_t handle, miopenProblem_t problem)
+{
+    MIOPEN_LOG_FUNCTION(plan, handle, problem);
+
+    return miopen::try_([&] {
+        auto plan_deref = miopen::MakeConvolutionPlan(
+            miopen::deref(handle), miopen::deref(problem), miopen::solver::Id{});
+        miopen::deref(plan) = new miopen::Plan{std::move(plan_deref)};
+    });
+}
+
+miopenStatus_t
+miopenCreatePlanFromSolution(miopenPlan_t* plan, miopenHandle_t handle, miopenSolution_t solution)
+{
+    MIOPEN_LOG_FUNCTION(plan, handle, solution);
+
+    return miopen::try_([&] {
+        const auto& solution_deref = miopen::deref(solution);
+        solution_deref.LoadKernels(miopen::deref(handle));
+        auto plan_deref =
+            miopen::MakeConvolutionPlan(miopen::deref(handle),
+                                        solution_deref.GetProblem(),
+                                        solution_deref.GetSolver(),
+                                        solution_deref.GetPerfConfig().value_or(""));
+        miopen::deref(plan) = new miopen::Plan{std::move(plan_deref)};
+    });
+}
+
+miopenStatus_t miopenCreatePoolingForwardPlan(miopenPlan_t* plan,
+                                              miopenHandle_t handle,
+                                              const miopenPoolingDescriptor_t poolDesc,
+                                              const miopenTensorDescriptor_t xDesc,
+                                              const miopenTensorDescriptor_t yDesc,
+                                              bool saveIndex)
+{
+    MIOPEN_LOG_FUNCTION(plan, handle, poolDesc, xDesc, yDesc, saveIndex);
+
+    return miopen::try_([&] {
+        auto plan_deref = miopen::deref(poolDesc).MakeForwardPlan(
+            miopen::deref(handle), miopen::deref(xDesc), miopen::deref(yDesc), saveIndex);
+        miopen::deref(plan) = new miopen::Plan{std::move(plan_deref)};
+    });
+}
+
+miopenStatus_t miopenCreatePoolingBackwardPlan(miopenPlan_t* plan,
+                                               miopenHandle_t handle,
+                                               const miopenPoolingDescriptor_t poolDesc,
+                                               const miopenTensorDescriptor_t yDesc,
+                                               const miopenTensorDescriptor_t dyDesc,
+                                               const miopenTensorDescriptor_t xDesc,
+                                               const miopenTensorDescriptor_t dxDesc)
+{
+    MIOPEN_LOG_FUNCTION(plan, handle, poolDesc, yDesc, dyDesc, xDesc, dxDesc);
+
+    return miopen::try_([&] {
+        auto plan_deref = miopen::deref(poolDesc).MakeBackwardPlan(miopen::deref(handle),
+                                                                   miopen::deref(yDesc),
+                                                                   miopen::deref(dyDesc),
+                                                                   miopen::deref(xDesc),
+                                                                   miopen::deref(dxDesc));
+        miopen::deref(plan) = new miopen::Plan{std::move(plan_deref)};
+    });
+}
+
+miopenStatus_t
+miopenCreateBatchNormForwardInferencePlan(miopenPlan_t* plan,
+                                          miopenHandle_t handle,
+                                          miopenBatchNormMode_t bn_mode,
+                                          const miopenTensorDescriptor_t xDesc,
+                                          const miopenTensorDescriptor_t yDesc,
+                                          const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                          double epsilon)
+{
+    MIOPEN_LOG_FUNCTION(plan, handle, bn_mode, xDesc, yDesc, bnScaleBiasMeanVarDesc, epsilon);
+
+    return miopen::try_([&] {
+        auto plan_deref =
+            miopen::MakeBatchNormForwardInferencePlan(miopen::deref(handle),
+                                                      bn_mode,
+                                                      miopen::deref(xDesc),
+                                                      miopen::deref(yDesc),
+                                                      miopen::deref(bnScaleBiasMeanVarDesc),
+                                                      epsilon);
+        miopen::deref(plan) = new miopen::Plan{std::move(plan_deref)};
+    });
+}
+
+miopenStatus_t
+miopenCreateBatchNormForwardTrainingPlan(miopenPlan_t* plan,
+                                         miopenHandle_t handle,
+                                         miopenBatchNormMode_t bn_mode,
+                                         const miopenTensorDescriptor_t xDesc,
+                                         const miopenTensorDescriptor_t yDesc,
+                                         const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                         double expAvgFactor,
+                                         double epsilon,
+                                         bool updateRunning,
+                                         bool saveResults)
+{
+    MIOPEN_LOG_FUNCTION(plan,
+                        handle,
+                        bn_mode,
+                        xDesc,
+                        yDesc,
+                        bnScaleBiasMeanVarDesc,
+                        expAvgFactor,
+                        epsilon,
+                        updateRunning,
+                        saveResults);
+
+    return miopen::try_([&] {
+        auto plan_deref =
+            miopen::MakeBatchNormForwardTrainingPlan(miopen::deref(handle),
+                                                     bn_mode,
+                                                     miopen::deref(xDesc),
+                                                     miopen::deref(yDesc),
+                                                     miopen::deref(bnScaleBiasMeanVarDesc),
+                                                     expAvgFactor,
+                                                     epsilon,
+                                                     updateRunning,
+                                                     saveResults);
+        miopen::deref(plan) = new miopen::Plan{std::move(plan_deref)};
+    });
+}
+
+miopenStatus_t miopenCreateBatchNormBackwardPlan(miopenPlan_t* plan,
+                                                 miopenHandle_t handle,
+                                                 miopenBatchNormMode_t bn_mode,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const miopenTensorDescriptor_t dyDesc,
+                                                 const miopenTensorDescriptor_t dxDesc,
+                                                 const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                                 double epsilon,
+                                                 bool useSaved)
+{
+    MIOPEN_LOG_FUNCTION(
+        plan, handle, bn_mode, xDesc, dyDesc, dxDesc, bnScaleBiasDiffDesc, epsilon, useSaved);
+
+    return miopen::try_([&] {
+        auto plan_deref = miopen::MakeBatchNormBackwardPlan(miopen::deref(handle),
+                                                            bn_mode,
+                                                            miopen::deref(xDesc),
+                                                            miopen::deref(dyDesc),
+                                                            miopen::deref(dxDesc),
+                                                            miopen::deref(bnScaleBiasDiffDesc),
+                                                            epsilon,
+                                                            useSaved);
+        miopen::deref(plan) = new miopen::Plan{std::move(plan_deref)};
+    });
+}
+
+miopenStatus_t miopenGetPlanWorkspaceSize(miopenPlan_t plan, size_t* workspaceSize)
+{
+    MIOPEN_LOG_FUNCTION(plan, workspaceSize);
+
+    return miopen::try_(
+        [&] { miopen::deref(workspaceSize) = miopen::deref(plan).GetWorkspaceSize(); });
+}
+
+miopenStatus_t miopenRunPlan(miopenHandle_t handle,
+                             miopenPlan_t plan,
+                             size_t nArguments,
+                             const miopenTensorArgument_t* arguments,
+                             void* workspace,
+                             size_t workspaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, plan, nArguments, arguments, workspace, workspaceSize);
+
+    return miopen::try_([&] {
+        miopen::deref(plan).Run(
+            miopen::deref(handle), arguments, nArguments, DataCast(workspace), workspaceSize);
+    });
+}
+
+miopenStatus_t miopenDestroyPlan(miopenPlan_t plan)
+{
+    MIOPEN_LOG_FUNCTION(plan);
+    return miopen::try_([&] { miopen_destroy_object(plan); });
+}
 }
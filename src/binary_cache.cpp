@@ -41,13 +41,20 @@
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CUSTOM_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERN_CACHE_SIZE_LIMIT_MB)
 
 static boost::filesystem::path ComputeSysCachePath()
 {
@@ -112,22 +119,153 @@ bool IsCacheDisabled()
 #endif
 }
 
+std::size_t GetCacheSizeLimit()
+{
+    static const auto limit =
+        static_cast<std::size_t>(Value(MIOPEN_KERN_CACHE_SIZE_LIMIT_MB{}, 0)) * 1024 * 1024;
+    return limit;
+}
+
+namespace {
+
+struct CachedFile
+{
+    boost::filesystem::path path;
+    std::size_t size;
+    std::time_t last_access;
+};
+
+/// Lists the binaries (*.o) in the subdirectories of cache_dir and adds up their sizes.
+std::vector<CachedFile> ListCacheFiles(const boost::filesystem::path& cache_dir,
+                                       std::size_t& total)
+{
+    namespace fs = boost::filesystem;
+
+    auto files = std::vector<CachedFile>{};
+    auto ec    = boost::system::error_code{};
+    total      = 0;
+    for(auto it = fs::recursive_directory_iterator{cache_dir, ec};
+        it != fs::recursive_directory_iterator{};
+        it.increment(ec))
+    {
+        if(ec)
+            break;
+        const auto& path = it->path();
+        if(path.parent_path() == cache_dir || path.extension() != ".o" ||
+           !fs::is_regular_file(path))
+            continue;
+        const auto size        = fs::file_size(path, ec);
+        const auto last_access = fs::last_write_time(path, ec);
+        if(ec)
+            continue;
+        files.push_back({path, static_cast<std::size_t>(size), last_access});
+        total += size;
+    }
+    return files;
+}
+
+/// Also returns the size of the binaries left in total.
+std::size_t
+EvictCacheFiles(const boost::filesystem::path& cache_dir, std::size_t limit, std::size_t& total)
+{
+    namespace fs = boost::filesystem;
+
+    auto files = ListCacheFiles(cache_dir, total);
+    if(total <= limit)
+        return 0;
+
+    std::sort(files.begin(), files.end(), [](const auto& l, const auto& r) {
+        return l.last_access < r.last_access;
+    });
+
+    const auto target = limit / 4 * 3;
+    auto evicted      = std::size_t{0};
+    auto ec           = boost::system::error_code{};
+    for(const auto& file : files)
+    {
+        if(total <= target)
+            break;
+        if(!fs::remove(file.path, ec) || ec)
+            continue;
+        total -= file.size;
+        ++evicted;
+        // The binaries of one configuration share a directory.
+        if(fs::is_empty(file.path.parent_path(), ec) && !ec)
+            fs::remove(file.path.parent_path(), ec);
+    }
+
+    MIOPEN_LOG_I("Evicted " << evicted << " binaries from " << cache_dir);
+    return evicted;
+}
+
+} // namespace
+
+std::size_t EvictCacheFiles(const boost::filesystem::path& cache_dir, std::size_t limit)
+{
+    auto total = std::size_t{0};
+    return EvictCacheFiles(cache_dir, limit, total);
+}
+
+CacheSizeTracker::CacheSizeTracker(boost::filesystem::path cache_dir_, std::size_t limit_)
+    : cache_dir(std::move(cache_dir_)), limit(limit_)
+{
+}
+
+std::size_t CacheSizeTracker::Add(std::size_t added, std::size_t replaced)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    if(!seeded)
+    {
+        // The binary is already in place, so the scan accounts for it.
+        ListCacheFiles(cache_dir, total);
+        seeded = true;
+    }
+    else
+    {
+        total = total - std::min(total, replaced) + added;
+    }
+
+    if(total <= limit)
+        return 0;
+    // Other processes may have added or evicted binaries meanwhile, so the eviction rescans
+    // the cache and resynchronizes the total with it.
+    return EvictCacheFiles(cache_dir, limit, total);
+}
+
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
-KDb GetDb(const TargetProperties& target, size_t num_cu)
+
+/// Kernel databases are opened once per (target, num_cu) and kept for the lifetime of the
+/// process, so that LoadBinary/SaveBinary do not recompute the paths, stat the system db,
+/// and re-prepare SQL statements on every call.
+static KDb& GetDb(const TargetProperties& target, size_t num_cu)
 {
     static const auto user_dir = ComputeUserCachePath();
     static const auto sys_dir  = ComputeSysCachePath();
-    boost::filesystem::path user_path =
-        user_dir / (Handle::GetDbBasename(target, num_cu) + ".ukdb");
-    boost::filesystem::path sys_path = sys_dir / (Handle::GetDbBasename(target, num_cu) + ".kdb");
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::unordered_map<std::string, std::unique_ptr<KDb>> instances;
+
+    const auto basename = Handle::GetDbBasename(target, num_cu);
+    const std::lock_guard<std::mutex> lock{mutex};
+    auto& db = instances[basename];
+    if(db)
+        return *db;
+
+    // Earlier versions of MIOpen expect the code objects inline and can not read records
+    // referring to the shared code object table, so such user databases use another file.
+    boost::filesystem::path user_path = user_dir / (basename + ".v2.ukdb");
+    boost::filesystem::path sys_path  = sys_dir / (basename + ".kdb");
     if(user_dir.empty())
         user_path = user_dir;
 #if !MIOPEN_EMBED_DB
     if(!boost::filesystem::exists(sys_path))
         sys_path = boost::filesystem::path{};
 #endif
-    return {sys_path.string(), user_path.string()};
+    db = std::make_unique<KDb>(sys_path.string(), user_path.string());
+    return *db;
 }
 #endif
 
@@ -161,7 +299,7 @@ std::string LoadBinary(const TargetProperties& target,
     if(miopen::IsCacheDisabled())
         return {};
 
-    auto db = GetDb(target, num_cu);
+    auto& db = GetDb(target, num_cu);
 
     const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     const KernelConfig cfg{filename, args, ""};
@@ -191,7 +329,7 @@ void SaveBinary(const std::string& hsaco,
     if(miopen::IsCacheDisabled())
         return;
 
-    auto db = GetDb(target, num_cu);
+    auto& db = GetDb(target, num_cu);
 
     const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     KernelConfig cfg{filename, args, hsaco};
@@ -214,6 +352,15 @@ boost::filesystem::path LoadBinary(const TargetProperties& target,
     auto f = GetCacheFile(target.DbId(), name, args, is_kernel_str);
     if(boost::filesystem::exists(f))
     {
+        // The modification time tracks the last use of the binary for the eviction. It is only
+        // refreshed hourly to keep loads from writing to the file system every time.
+        if(GetCacheSizeLimit() != 0)
+        {
+            auto ec        = boost::system::error_code{};
+            const auto now = std::time(nullptr);
+            if(now - boost::filesystem::last_write_time(f, ec) > 60 * 60 && !ec)
+                boost::filesystem::last_write_time(f, now, ec);
+        }
         return f.string();
     }
     else
@@ -236,7 +383,21 @@ void SaveBinary(const boost::filesystem::path& binary_path,
     {
         auto p = GetCacheFile(target.DbId(), name, args, is_kernel_str);
         boost::filesystem::create_directories(p.parent_path());
+        if(GetCacheSizeLimit() == 0)
+        {
+            boost::filesystem::rename(binary_path, p);
+            return;
+        }
+
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static CacheSizeTracker tracker{GetCachePath(false), GetCacheSizeLimit()};
+        auto ec       = boost::system::error_code{};
+        auto replaced = boost::filesystem::file_size(p, ec);
+        if(ec)
+            replaced = 0;
+        const auto added = boost::filesystem::file_size(binary_path, ec);
         boost::filesystem::rename(binary_path, p);
+        tracker.Add(ec ? 0 : added, replaced);
     }
 }
 #endif
@@ -53,6 +53,7 @@
 #include <exception>
 #include <cstddef>
 #include <cstring>
+#include <string_view>
 #include <tuple> // std::ignore
 #include <vector>
 
@@ -570,7 +571,7 @@ public:
     {
         ECI_THROW(amd_comgr_set_data_name(handle, s.c_str()), s);
     }
-    void SetBytes(const std::string& bytes) const
+    void SetBytes(std::string_view bytes) const
     {
         ECI_THROW(amd_comgr_set_data(handle, bytes.size(), bytes.data()), bytes.size());
     }
@@ -617,7 +618,7 @@ public:
     auto GetHandle() const { return handle; }
     void AddData(const Data& d) const { EC_THROW(amd_comgr_data_set_add(handle, d.GetHandle())); }
     void AddData(const std::string& name,
-                 const std::string& content,
+                 std::string_view content,
                  const amd_comgr_data_kind_t type) const
     {
         const Data d(type);
@@ -631,7 +632,7 @@ public:
            (type == AMD_COMGR_DATA_KIND_SOURCE || type == AMD_COMGR_DATA_KIND_INCLUDE))
         {
             const auto text_length = (content.size() > show_first) ? show_first : content.size();
-            const std::string text(content, 0, text_length);
+            const std::string text(content.substr(0, text_length));
             MIOPEN_LOG_I(text);
         }
     }
@@ -793,7 +794,8 @@ void BuildHip(const std::string& name,
         // of the addkernels tool. We don't do that for HIP sources, and, therefore
         // have to export include files prior compilation.
         // Note that we do not need any "subdirs" in the include "pathnames" so far.
-        const auto incNames = miopen::GetHipKernelIncList();
+        // Only the headers that the source actually includes are exported.
+        const auto incNames = miopen::GetHipKernelIncDeps(text);
         for(const auto& inc : incNames)
             inputs.AddData(inc, miopen::GetKernelInc(inc), AMD_COMGR_DATA_KIND_INCLUDE);
 
@@ -1160,7 +1162,8 @@ class HiprtcProgram
         string_ptr_array(const string_ptr_array&) = delete;
         std::size_t size() const { return c_strs.size(); }
         const char** data() { return c_strs.data(); }
-        void push_back(const std::string* s) { c_strs.push_back(s->c_str()); }
+        // Embedded kernel includes are null-terminated.
+        void push_back(std::string_view s) { c_strs.push_back(s.data()); }
     };
 
     struct string_array
@@ -1193,12 +1196,12 @@ public:
         : src_name(src_name_), src_text(src_text_)
     {
         LogInputFile(src_name, src_text);
-        const auto inc_names = miopen::GetHipKernelIncList();
+        const auto inc_names = miopen::GetHipKernelIncDeps(src_text);
         include_names.reserve(inc_names.size());
         for(const auto& inc_name : inc_names)
         {
-            const auto inc_text = miopen::GetKernelIncPtr(inc_name);
-            LogInputFile(inc_name, *inc_text);
+            const auto inc_text = miopen::GetKernelInc(inc_name);
+            LogInputFile(inc_name, inc_text);
             include_names.push_back(inc_name);
             include_texts.push_back(inc_text);
         }
@@ -1236,7 +1239,7 @@ public:
     }
 
 private:
-    void LogInputFile(const std::string& name, const std::string& content)
+    void LogInputFile(const std::string& name, std::string_view content)
     {
         if(miopen::IsEnabled(MIOPEN_DEBUG_COMGR_LOG_SOURCE_NAMES{}))
             MIOPEN_LOG_I(name << ' ' << content.size() << " bytes");
@@ -1247,7 +1250,7 @@ private:
             {
                 const auto text_length =
                     (content.size() > show_first) ? show_first : content.size();
-                const std::string text(content, 0, text_length);
+                const std::string text(content.substr(0, text_length));
                 MIOPEN_LOG_I(text);
             }
         }
@@ -0,0 +1,429 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compiled_db.hpp>
+
+#include <miopen/db_record.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+constexpr char compiled_db_magic[8]        = {'M', 'I', 'O', 'P', 'R', 'O', 'D', 'B'};
+constexpr std::uint32_t compiled_db_version = 2;
+constexpr std::uint32_t byte_order_mark     = 0x01020304;
+} // namespace
+
+struct CompiledDb::Memory
+{
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+CompiledDb::CompiledDb(std::unique_ptr<Memory> memory_, std::string name_)
+    : memory(std::move(memory_)), name(std::move(name_))
+{
+}
+
+CompiledDb::~CompiledDb() = default;
+
+std::string CompiledDb::GetCompiledPath(const std::string& text_path)
+{
+    if(EndsWith(text_path, ".txt"))
+        return text_path.substr(0, text_path.size() - 4) + ".bin";
+    return text_path + ".bin";
+}
+
+bool CompiledDb::Compile(std::istream& text,
+                         const SourceStamp& source,
+                         std::ostream& out,
+                         const std::string& name)
+{
+    if(!text)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << name);
+        return false;
+    }
+
+    auto parsed = std::map<std::string, std::pair<int, DbRecord>>{};
+    auto line   = std::string{};
+    auto n_line = 0;
+
+    while(std::getline(text, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+
+        if(!is_key)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << name << "#" << n_line);
+            continue;
+        }
+
+        const auto key = line.substr(0, key_size);
+        auto record    = DbRecord{key};
+
+        if(!record.ParseContents(line.substr(key_size + 1)))
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << name
+                                                                 << "#" << n_line);
+            // Keeps the key occupied, so following duplicates are ignored as in the text db.
+            record.map.clear();
+        }
+
+        parsed.emplace(key, std::make_pair(n_line, std::move(record)));
+    }
+
+    auto records = std::vector<Record>{};
+    auto items   = std::vector<Item>{};
+    auto strings = std::vector<char>{};
+
+    const auto add_string = [&](const std::string& str) {
+        const auto offset = strings.size();
+        strings.insert(strings.end(), str.begin(), str.end());
+        return offset;
+    };
+
+    for(const auto& entry : parsed)
+    {
+        const auto& record = entry.second.second;
+
+        if(record.map.empty())
+            continue;
+
+        auto ids_and_values = std::vector<std::pair<std::string, std::string>>{record.map.begin(),
+                                                                               record.map.end()};
+        std::sort(ids_and_values.begin(), ids_and_values.end());
+
+        records.push_back({add_string(entry.first),
+                           static_cast<std::uint32_t>(entry.first.size()),
+                           static_cast<std::uint32_t>(entry.second.first),
+                           items.size(),
+                           ids_and_values.size()});
+
+        for(const auto& id_and_values : ids_and_values)
+        {
+            const auto id_offset = add_string(id_and_values.first);
+            items.push_back({id_offset,
+                             add_string(id_and_values.second),
+                             static_cast<std::uint32_t>(id_and_values.first.size()),
+                             static_cast<std::uint32_t>(id_and_values.second.size())});
+        }
+    }
+
+    auto header = Header{};
+    std::copy(std::begin(compiled_db_magic), std::end(compiled_db_magic), header.magic);
+    header.version        = compiled_db_version;
+    header.byte_order     = byte_order_mark;
+    header.record_count   = records.size();
+    header.item_count     = items.size();
+    header.records_offset = sizeof(Header);
+    header.items_offset   = header.records_offset + records.size() * sizeof(Record);
+    header.strings_offset = header.items_offset + items.size() * sizeof(Item);
+    header.strings_size   = strings.size();
+    header.source_size    = source.size;
+    header.source_mtime   = source.mtime;
+    std::fill(std::begin(header.source_md5), std::end(header.source_md5), '\0');
+    std::copy_n(source.md5.begin(),
+                std::min(source.md5.size(), sizeof(header.source_md5)),
+                header.source_md5);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    out.write(reinterpret_cast<const char*>(items.data()), items.size() * sizeof(Item));
+    out.write(strings.data(), strings.size());
+
+    MIOPEN_LOG_I("Compiled " << records.size() << " records from " << name);
+    return static_cast<bool>(out);
+}
+
+namespace {
+// Readers shall never see a partially written file.
+bool ReplaceFile(const std::string& tmp_path, const std::string& path)
+{
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmp_path, path, ec);
+    if(!ec)
+        return true;
+
+    MIOPEN_LOG_E("Unable to rename " << tmp_path << " to " << path << ": " << ec.message());
+    std::remove(tmp_path.c_str());
+    return false;
+}
+} // namespace
+
+bool CompiledDb::Restamp(const std::string& path, const SourceStamp& source)
+{
+    auto contents = LoadFile(path);
+    if(contents.size() < sizeof(Header))
+        return false;
+
+    auto hdr = Header{};
+    std::memcpy(&hdr, contents.data(), sizeof(hdr));
+
+    if(!std::equal(std::begin(compiled_db_magic), std::end(compiled_db_magic), hdr.magic) ||
+       hdr.version != compiled_db_version || hdr.byte_order != byte_order_mark ||
+       hdr.source_size != source.size ||
+       std::string(hdr.source_md5, sizeof(hdr.source_md5)) != source.md5)
+        return false;
+
+    hdr.source_mtime = source.mtime;
+    std::memcpy(&contents[0], &hdr, sizeof(hdr));
+
+    const auto tmp_path = path + ".tmp";
+    {
+        auto out = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+        if(!out.write(contents.data(), contents.size()))
+        {
+            MIOPEN_LOG_E("File is unwritable: " << tmp_path);
+            out.close();
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    MIOPEN_LOG_I("Contents of the source are unchanged, updated the stamp of " << path);
+    return ReplaceFile(tmp_path, path);
+}
+
+bool CompiledDb::Compile(const std::string& text_path, const std::string& out_path)
+{
+    boost::system::error_code ec;
+    auto source  = SourceStamp{};
+    source.size  = boost::filesystem::file_size(text_path, ec);
+    source.mtime = ec ? 0 : boost::filesystem::last_write_time(text_path, ec);
+    if(ec)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << text_path);
+        return false;
+    }
+
+    auto contents = LoadFile(text_path);
+    source.md5    = md5(contents);
+
+    // Modification times are not always preserved on installation, so the hash allows to skip
+    // the compilation when only those have changed.
+    if(boost::filesystem::exists(out_path, ec) && Restamp(out_path, source))
+        return true;
+
+    auto text           = std::istringstream{std::move(contents)};
+    const auto tmp_path = out_path + ".tmp";
+
+    {
+        auto out = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+        if(!out)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << tmp_path);
+            return false;
+        }
+
+        if(!Compile(text, source, out, text_path))
+        {
+            out.close();
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    return ReplaceFile(tmp_path, out_path);
+}
+
+std::unique_ptr<CompiledDb> CompiledDb::Open(const std::string& path)
+{
+    boost::system::error_code ec;
+    if(!boost::filesystem::exists(path, ec) || boost::filesystem::file_size(path, ec) == 0)
+        return nullptr;
+
+    auto memory = std::make_unique<Memory>();
+
+    try
+    {
+        memory->file   = boost::interprocess::file_mapping(path.c_str(),
+                                                         boost::interprocess::read_only);
+        memory->region = boost::interprocess::mapped_region(memory->file,
+                                                            boost::interprocess::read_only);
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map file " << path << ": " << ex.what());
+        return nullptr;
+    }
+
+    const auto data = static_cast<const char*>(memory->region.get_address());
+    const auto size = memory->region.get_size();
+    auto db         = std::make_unique<CompiledDb>(std::move(memory), path);
+
+    if(!db->Validate(data, size))
+        return nullptr;
+    return db;
+}
+
+bool CompiledDb::Validate(const char* data, std::size_t size)
+{
+    if(size < sizeof(Header))
+    {
+        MIOPEN_LOG_W("Compiled db is truncated: " << name);
+        return false;
+    }
+
+    const auto hdr = reinterpret_cast<const Header*>(data);
+
+    if(!std::equal(std::begin(compiled_db_magic), std::end(compiled_db_magic), hdr->magic) ||
+       hdr->version != compiled_db_version || hdr->byte_order != byte_order_mark)
+    {
+        MIOPEN_LOG_W("Unsupported compiled db format: " << name);
+        return false;
+    }
+
+    // Counts are limited by the size first to avoid overflows.
+    const auto is_valid = hdr->record_count <= size / sizeof(Record) &&
+                          hdr->item_count <= size / sizeof(Item) &&
+                          hdr->records_offset >= sizeof(Header) &&
+                          hdr->records_offset % alignof(Record) == 0 &&
+                          hdr->items_offset % alignof(Item) == 0 &&
+                          hdr->records_offset + hdr->record_count * sizeof(Record) <=
+                              hdr->items_offset &&
+                          hdr->items_offset + hdr->item_count * sizeof(Item) <=
+                              hdr->strings_offset &&
+                          hdr->strings_offset <= size &&
+                          hdr->strings_size <= size - hdr->strings_offset;
+
+    if(!is_valid)
+    {
+        MIOPEN_LOG_W("Compiled db is ill-formed: " << name);
+        return false;
+    }
+
+    header  = hdr;
+    records = reinterpret_cast<const Record*>(data + hdr->records_offset);
+    items   = reinterpret_cast<const Item*>(data + hdr->items_offset);
+    strings = data + hdr->strings_offset;
+
+    return true;
+}
+
+bool CompiledDb::IsValidRecord(const Record& record) const
+{
+    const auto is_valid_item = [&](const Item& item) {
+        return IsValidString(item.id_offset, item.id_size) &&
+               IsValidString(item.value_offset, item.value_size);
+    };
+
+    return record.first_item <= header->item_count &&
+           record.item_count <= header->item_count - record.first_item &&
+           std::all_of(GetItems(record), GetItems(record) + record.item_count, is_valid_item);
+}
+
+bool CompiledDb::IsValidString(std::uint64_t offset, std::uint32_t size) const
+{
+    return offset <= header->strings_size && size <= header->strings_size - offset;
+}
+
+bool CompiledDb::IsOutdated(const std::string& text_path) const
+{
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(text_path, ec);
+    if(ec)
+        return false;
+    if(size != header->source_size)
+        return true;
+
+    const auto mtime = boost::filesystem::last_write_time(text_path, ec);
+    return !ec && mtime != header->source_mtime;
+}
+
+int CompiledDb::Compare(const Record& record, const std::string& key) const
+{
+    const auto cmp = std::memcmp(strings + record.key_offset,
+                                 key.data(),
+                                 std::min<std::size_t>(record.key_size, key.size()));
+    if(cmp != 0)
+        return cmp;
+    if(record.key_size == key.size())
+        return 0;
+    return record.key_size < key.size() ? -1 : 1;
+}
+
+const CompiledDb::Record* CompiledDb::Find(const std::string& key) const
+{
+    // Records are validated only when visited, so opening a db does not touch all of them. An
+    // out of order record can only make the lookup fail.
+    auto first = std::uint64_t{0};
+    auto last  = header->record_count;
+
+    while(first < last)
+    {
+        const auto middle  = first + (last - first) / 2;
+        const auto& record = records[middle];
+
+        if(!IsValidString(record.key_offset, record.key_size))
+        {
+            MIOPEN_LOG_W("Compiled db is ill-formed: " << name << ", record #" << middle);
+            return nullptr;
+        }
+
+        const auto cmp = Compare(record, key);
+
+        if(cmp < 0)
+        {
+            first = middle + 1;
+        }
+        else if(cmp > 0)
+        {
+            last = middle;
+        }
+        else
+        {
+            if(IsValidRecord(record))
+                return &record;
+            MIOPEN_LOG_W("Compiled db is ill-formed: " << name << ", record #" << middle);
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace miopen
@@ -0,0 +1,259 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compiler_workers.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ; // NOLINT (readability-redundant-declaration)
+#endif // __linux__
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILER_WORKERS)
+
+namespace miopen {
+
+#ifdef __linux__
+
+namespace {
+
+/// Writing to a worker that has died raises SIGPIPE, which terminates the process by default.
+/// The signal is blocked for this thread during the write and discarded if it was raised.
+bool WriteAll(int fd, const std::string& data)
+{
+    sigset_t pipe_set;
+    sigset_t old_set;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+
+    auto ok        = true;
+    const auto* p  = data.data();
+    auto remaining = data.size();
+    while(remaining > 0)
+    {
+        const auto written = write(fd, p, remaining);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            if(errno == EPIPE)
+            {
+                const timespec no_wait{};
+                sigtimedwait(&pipe_set, nullptr, &no_wait);
+            }
+            ok = false;
+            break;
+        }
+        p += written;
+        remaining -= written;
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+    return ok;
+}
+
+} // namespace
+
+struct CompilerWorkers::Worker
+{
+    pid_t pid        = -1;
+    int to_shell     = -1;
+    FILE* from_shell = nullptr;
+
+    explicit Worker(const std::string& shell)
+    {
+        int in[2];
+        int out[2];
+        if(pipe2(in, O_CLOEXEC) != 0)
+            MIOPEN_THROW("Can't create a pipe for a compiler worker");
+        if(pipe2(out, O_CLOEXEC) != 0)
+        {
+            close(in[0]);
+            close(in[1]);
+            MIOPEN_THROW("Can't create a pipe for a compiler worker");
+        }
+
+        // dup2 clears close-on-exec for the shell's ends only, so workers do not inherit
+        // the pipes of each other. Otherwise closing a pipe would not end its worker.
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, in[0], STDIN_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+        char* argv[] = {const_cast<char*>(shell.c_str()), nullptr}; // NOLINT
+        const auto rc = posix_spawn(&pid, shell.c_str(), &actions, nullptr, argv, environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(in[0]);
+        close(out[1]);
+
+        if(rc != 0)
+        {
+            close(in[1]);
+            close(out[0]);
+            MIOPEN_THROW("Can't start a compiler worker: " + shell);
+        }
+
+        to_shell   = in[1];
+        from_shell = fdopen(out[0], "r");
+        MIOPEN_LOG_I2("Started compiler worker " << pid);
+    }
+
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    ~Worker()
+    {
+        // The shell exits once its input is closed.
+        close(to_shell);
+        if(from_shell != nullptr)
+            fclose(from_shell);
+        waitpid(pid, nullptr, 0);
+    }
+
+    /// Returns boost::none if the worker has died.
+    boost::optional<int> Run(const std::string& cmd, const boost::filesystem::path& dir)
+    {
+        // The subshell keeps cd and exit local to the command. Its stdout goes to stderr,
+        // so the worker's stdout only carries the exit codes.
+        const auto line = "(cd " + dir.string() + " && " + cmd + ") </dev/null 1>&2; echo $?\n";
+        if(from_shell == nullptr || !WriteAll(to_shell, line))
+            return boost::none;
+
+        char status[32];
+        if(std::fgets(status, sizeof(status), from_shell) == nullptr)
+            return boost::none;
+        return static_cast<int>(std::strtol(status, nullptr, 10));
+    }
+};
+
+#else
+
+struct CompilerWorkers::Worker
+{
+    explicit Worker(const std::string&) {}
+
+    boost::optional<int> Run(const std::string& cmd, const boost::filesystem::path&)
+    {
+        MIOPEN_THROW("Compiler workers are not supported on this platform: " + cmd);
+    }
+};
+
+#endif // __linux__
+
+CompilerWorkers::CompilerWorkers(std::size_t max_workers_, std::string shell_)
+    : shell(std::move(shell_)), max_workers(std::max<std::size_t>(max_workers_, 1))
+{
+}
+
+CompilerWorkers::~CompilerWorkers() = default;
+
+int CompilerWorkers::Run(const std::string& cmd, const boost::filesystem::path& dir)
+{
+    if(cmd.find('\n') != std::string::npos)
+        MIOPEN_THROW("Compiler worker commands must fit in one line: " + cmd);
+    MIOPEN_LOG_I2(cmd);
+
+    auto worker       = Acquire();
+    const auto status = worker->Run(cmd, dir);
+    if(!status)
+    {
+        worker.reset();
+        Release(nullptr);
+        MIOPEN_THROW("Compiler worker has exited unexpectedly: " + cmd);
+    }
+    Release(std::move(worker));
+    return *status;
+}
+
+std::unique_ptr<CompilerWorkers::Worker> CompilerWorkers::Acquire()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        worker_released.wait(lock, [&] { return !idle.empty() || started < max_workers; });
+        if(!idle.empty())
+        {
+            auto worker = std::move(idle.back());
+            idle.pop_back();
+            return worker;
+        }
+        ++started;
+    }
+
+    try
+    {
+        return std::make_unique<Worker>(shell);
+    }
+    catch(...)
+    {
+        Release(nullptr);
+        throw;
+    }
+}
+
+void CompilerWorkers::Release(std::unique_ptr<Worker> worker)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(worker)
+            idle.push_back(std::move(worker));
+        else
+            --started;
+    }
+    worker_released.notify_one();
+}
+
+CompilerWorkers& CompilerWorkers::Get()
+{
+    static CompilerWorkers workers{std::thread::hardware_concurrency()};
+    return workers;
+}
+
+bool CompilerWorkers::IsAvailable()
+{
+#ifdef __linux__
+    return !miopen::IsDisabled(MIOPEN_DEBUG_COMPILER_WORKERS{});
+#else
+    return false;
+#endif
+}
+
+} // namespace miopen
@@ -0,0 +1,261 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/heuristic_model/solver_ranking.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+#include <miopen/db_path.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+#include <nlohmann/json.hpp>
+#include <fdeep/fdeep.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <mutex>
+#endif
+
+namespace miopen {
+namespace ai {
+namespace ranking {
+
+namespace {
+
+bool ParseValue(const std::string& str, float& value)
+{
+    if(str.empty())
+        return false;
+    char* end         = nullptr;
+    const auto parsed = std::strtol(str.c_str(), &end, 10);
+    if(*end != '\0' || parsed < 0)
+        return false;
+    value = static_cast<float>(parsed);
+    return true;
+}
+
+/// Parses the parts of a size (h, w or d, h, w) into depth, height and width. 2D sizes get the
+/// given depth.
+bool ParseDHW(const std::vector<std::string>& parts, int spatial_dims, float* dhw, float depth)
+{
+    if(parts.size() != static_cast<std::size_t>(spatial_dims))
+        return false;
+    dhw[0] = depth;
+    for(auto i = 0; i < spatial_dims; ++i)
+    {
+        if(!ParseValue(parts[i], dhw[3 - spatial_dims + i]))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool ParseConvDbKey(const std::string& key, ConvDbKeyFeatures& features)
+{
+    auto main_part          = key;
+    auto group_count        = 1.0f;
+    const auto optional_pos = key.find('_');
+    if(optional_pos != std::string::npos)
+    {
+        main_part                = key.substr(0, optional_pos);
+        const auto optional_part = key.substr(optional_pos + 1);
+        if(!StartsWith(optional_part, "g") || !ParseValue(optional_part.substr(1), group_count))
+            return false;
+    }
+
+    const auto tokens  = SplitDelim(main_part, '-');
+    const auto count_x = [&](std::size_t i) {
+        return std::count(tokens[i].begin(), tokens[i].end(), 'x');
+    };
+    auto spatial_dims = 0;
+    if(tokens.size() > 3 && count_x(3) == 1)
+        spatial_dims = 2;
+    else if(tokens.size() > 4 && count_x(4) == 2)
+        spatial_dims = 3;
+    else
+        return false;
+
+    // Tokens up to and including the bias, then one or three layouts, the data type and the
+    // direction.
+    const std::size_t num_fixed = spatial_dims == 2 ? 12 : 14;
+    if(tokens.size() != num_fixed + 3 && tokens.size() != num_fixed + 5)
+        return false;
+
+    auto& v  = features.values;
+    auto tok = tokens.begin();
+
+    const auto spatial = [&](char sep, float* dhw, float depth) {
+        std::vector<std::string> parts;
+        if(sep == '-')
+        {
+            parts.assign(tok, tok + spatial_dims);
+            tok += spatial_dims;
+        }
+        else
+            parts = SplitDelim(*tok++, sep);
+        return ParseDHW(parts, spatial_dims, dhw, depth);
+    };
+
+    // clang-format off
+    if(!ParseValue(*tok++, v[0]) || !spatial('-', &v[1], 1) || !spatial('x', &v[4], 1) ||
+       !ParseValue(*tok++, v[7]) || !spatial('-', &v[8], 1) || !ParseValue(*tok++, v[11]) ||
+       !spatial('x', &v[12], 0) || !spatial('x', &v[15], 1) || !spatial('x', &v[18], 1) ||
+       !ParseValue(*tok++, v[21]))
+        return false;
+    // clang-format on
+    v[22] = group_count;
+
+    features.layout    = *tok;
+    features.data_type = *(tokens.end() - 2);
+    const auto& dir    = tokens.back();
+    if(dir != "F" && dir != "B" && dir != "W")
+        return false;
+    features.direction = dir[0];
+    return true;
+}
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+
+struct SolverRankingModel::impl
+{
+    static std::string GetPath(const std::string& arch, const std::string& suffix)
+    {
+        return GetSystemDbPath() + "/" + arch + "_SolverRanking" + suffix + ".model";
+    }
+
+    impl(const std::string& arch)
+        : model(fdeep::load_model(GetPath(arch, ""), true, fdeep::dev_null_logger))
+    {
+        const auto metadata = nlohmann::json::parse(std::ifstream(GetPath(arch, "_metadata")));
+        mean       = metadata.at("mean").get<std::vector<float>>();
+        stddev     = metadata.at("std").get<std::vector<float>>();
+        data_types = metadata.at("data_types").get<std::vector<std::string>>();
+        layouts    = metadata.at("layouts").get<std::vector<std::string>>();
+        solvers    = metadata.at("solvers").get<std::vector<std::string>>();
+        if(mean.size() != ConvDbKeyFeatures::num_values ||
+           stddev.size() != ConvDbKeyFeatures::num_values)
+            MIOPEN_THROW("Solver ranking model for " + arch + " has wrong number of features");
+    }
+
+    bool Predict(const std::string& db_key, std::unordered_map<std::string, float>& times) const
+    {
+        auto features = ConvDbKeyFeatures{};
+        if(!ParseConvDbKey(db_key, features))
+            return false;
+
+        auto input = std::vector<float>{};
+        input.reserve(ConvDbKeyFeatures::num_values + 3 + data_types.size() + layouts.size());
+        for(auto i = std::size_t{0}; i < ConvDbKeyFeatures::num_values; ++i)
+            input.push_back((std::log1p(features.values[i]) - mean[i]) / stddev[i]);
+
+        const auto one_hot = [&](const std::vector<std::string>& categories,
+                                 const std::string& value) {
+            const auto it = std::find(categories.begin(), categories.end(), value);
+            for(const auto& category : categories)
+                input.push_back(category == value ? 1.0f : 0.0f);
+            return it != categories.end();
+        };
+        if(!one_hot({"F", "B", "W"}, std::string(1, features.direction)) ||
+           !one_hot(data_types, features.data_type) || !one_hot(layouts, features.layout))
+            return false;
+
+        const auto output =
+            model.predict({fdeep::tensor(fdeep::tensor_shape(input.size()), input)})[0]
+                .to_vector();
+        if(output.size() != solvers.size())
+            MIOPEN_THROW("Solver ranking model output does not match its metadata");
+        for(auto i = std::size_t{0}; i < solvers.size(); ++i)
+            times[solvers[i]] = std::exp(output[i]);
+        return true;
+    }
+
+    fdeep::model model;
+    std::vector<float> mean;
+    std::vector<float> stddev;
+    std::vector<std::string> data_types;
+    std::vector<std::string> layouts;
+    std::vector<std::string> solvers;
+};
+
+SolverRankingModel::SolverRankingModel() : pImpl(nullptr) {}
+SolverRankingModel::SolverRankingModel(const std::string& arch)
+    : pImpl{std::make_unique<impl>(arch)}
+{
+}
+SolverRankingModel::~SolverRankingModel()                             = default;
+SolverRankingModel::SolverRankingModel(SolverRankingModel&&) noexcept = default;
+SolverRankingModel& SolverRankingModel::operator=(SolverRankingModel&&) noexcept = default;
+
+const SolverRankingModel* SolverRankingModel::Get(const std::string& arch)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<SolverRankingModel>> models;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = models.find(arch);
+    if(found != models.end())
+        return found->second.get();
+
+    auto& model = models[arch];
+    if(!boost::filesystem::exists(impl::GetPath(arch, "")))
+    {
+        MIOPEN_LOG_I2("No solver ranking model for " << arch);
+        return nullptr;
+    }
+    try
+    {
+        model = std::make_unique<SolverRankingModel>(arch);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to load the solver ranking model for " << arch << ": " << ex.what());
+    }
+    return model.get();
+}
+
+bool SolverRankingModel::Predict(const std::string& db_key,
+                                 std::unordered_map<std::string, float>& times) const
+{
+    return this->pImpl->Predict(db_key, times);
+}
+
+const std::vector<std::string>& SolverRankingModel::GetSolvers() const
+{
+    return this->pImpl->solvers;
+}
+
+#endif
+
+} // namespace ranking
+} // namespace ai
+} // namespace miopen
@@ -24,7 +24,9 @@
  *
  *******************************************************************************/
 #include <miopen/db.hpp>
+#include <miopen/db_index.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -44,15 +46,26 @@
 #include <ios>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
 #include <vector>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PLAINTEXT_DB_INDEX)
+
 namespace miopen {
 
+static PlainTextDbIndex* GetIndex(const std::string& filename)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_PLAINTEXT_DB_INDEX{}))
+        return nullptr;
+    return &PlainTextDbIndex::GetCached(filename);
+}
+
 PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
-      warning_if_unreadable(is_system)
+      warning_if_unreadable(is_system),
+      index(GetIndex(filename_))
 {
     if(is_system)
     {
@@ -75,6 +88,10 @@ PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
     }
 }
 
+PlainTextDb::PlainTextDb(const PlainTextDb& other)     = default;
+PlainTextDb::PlainTextDb(PlainTextDb&& other) noexcept = default;
+PlainTextDb::~PlainTextDb()                            = default;
+
 #define MIOPEN_VALIDATE_LOCK(lock)                       \
     do                                                   \
     {                                                    \
@@ -147,6 +164,9 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         pos->end   = -1;
     }
 
+    if(index != nullptr)
+        return FindRecordIndexedUnsafe(key, pos);
+
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
     std::ifstream file(filename);
@@ -218,6 +238,49 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
     return boost::none;
 }
 
+boost::optional<DbRecord> PlainTextDb::FindRecordIndexedUnsafe(const std::string& key,
+                                                               RecordPositions* pos)
+{
+    MIOPEN_LOG_I2("Looking for key " << key << " in index of file " << filename);
+
+    const std::lock_guard<std::mutex> index_lock{index->GetMutex()};
+
+    if(!index->Refresh(filename))
+    {
+        const auto log_level = IsWarningIfUnreadable() && !MIOPEN_DISABLE_SYSDB
+                                   ? LoggingLevel::Warning
+                                   : LoggingLevel::Info2;
+        MIOPEN_LOG(log_level, "File is unreadable: " << filename);
+        return boost::none;
+    }
+
+    const auto entry = index->Find(key);
+
+    if(entry == nullptr)
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match: " << key);
+    const auto contents = index->GetContents(*entry);
+    MIOPEN_LOG_I2("Contents found: " << contents);
+
+    DbRecord record(key);
+    const bool is_parse_ok = record.ParseContents(contents);
+
+    if(!is_parse_ok)
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "@" << entry->begin);
+        MIOPEN_LOG_E("Contents: " << contents);
+    }
+
+    if(pos != nullptr)
+    {
+        pos->begin = entry->begin;
+        pos->end   = entry->end;
+    }
+    return record;
+}
+
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
 {
     constexpr auto buffer_size_limit = 4 * 1024 * 1024;
@@ -239,6 +302,18 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
 {
     assert(pos);
 
+    auto ss = std::ostringstream{};
+    record.WriteContents(ss);
+    const auto contents = ss.str();
+
+    auto index_lock = std::unique_lock<std::mutex>{};
+    if(index != nullptr)
+    {
+        index_lock = std::unique_lock<std::mutex>{index->GetMutex()};
+        // Mapped files can't be replaced on some platforms.
+        index->Unmap();
+    }
+
     if(pos->begin < 0 || pos->end < 0)
     {
         {
@@ -247,11 +322,13 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
             if(!file)
             {
                 MIOPEN_LOG_E("File is unwritable: " << filename);
+                if(index != nullptr)
+                    index->Invalidate();
                 return false;
             }
 
             (void)file.tellp();
-            record.WriteContents(file);
+            file << contents;
         }
 
         boost::filesystem::permissions(filename, boost::filesystem::all_all);
@@ -263,6 +340,8 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
         if(!from)
         {
             MIOPEN_LOG_E("File is unreadable: " << filename);
+            if(index != nullptr)
+                index->Invalidate();
             return false;
         }
 
@@ -272,6 +351,8 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
         if(!to)
         {
             MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            if(index != nullptr)
+                index->Invalidate();
             return false;
         }
 
@@ -279,7 +360,7 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
         from.seekg(std::ios::beg);
 
         Copy(from, to, pos->begin);
-        record.WriteContents(to);
+        to << contents;
         from.seekg(pos->end);
         Copy(from, to, from_size - pos->end);
 
@@ -291,6 +372,9 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
         /// \todo What if rename fails? Thou shalt not loose the original file.
         boost::filesystem::permissions(filename, boost::filesystem::all_all);
     }
+
+    if(index != nullptr)
+        index->Update(filename, *pos, record.GetKey(), contents.size());
     return true;
 }
 
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_index.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace miopen {
+
+struct PlainTextDbIndex::Mapping
+{
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+PlainTextDbIndex::PlainTextDbIndex()  = default;
+PlainTextDbIndex::~PlainTextDbIndex() = default;
+
+PlainTextDbIndex& PlainTextDbIndex::GetCached(const std::string& filename)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<std::string, PlainTextDbIndex*>{};
+    const auto it         = instances.find(filename);
+
+    if(it != instances.end())
+        return *it->second;
+
+    // Like the RamDb instances, these are alive during the whole app lifetime: there is one per
+    // user db file, and each keeps just the mapping and a vector of offsets.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    const auto instance = new PlainTextDbIndex();
+    instances.emplace(filename, instance);
+    return *instance;
+}
+
+PlainTextDbIndex::FileStamp PlainTextDbIndex::GetFileStamp(const std::string& filename)
+{
+    auto result = FileStamp{};
+#ifndef _WIN32
+    struct stat info = {};
+    if(::stat(filename.c_str(), &info) != 0)
+        return result;
+    result.size  = info.st_size;
+    result.mtime = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 +
+                   info.st_mtim.tv_nsec;
+    result.inode = info.st_ino;
+#else
+    boost::system::error_code ec;
+    result.size = boost::filesystem::file_size(filename, ec);
+    if(ec)
+        return result;
+    result.mtime = boost::filesystem::last_write_time(filename, ec);
+    if(ec)
+        return result;
+#endif
+    result.exists = true;
+    return result;
+}
+
+const char* PlainTextDbIndex::Data() const
+{
+    return mapping == nullptr ? nullptr : static_cast<const char*>(mapping->region.get_address());
+}
+
+std::size_t PlainTextDbIndex::Size() const
+{
+    return mapping == nullptr ? 0 : mapping->region.get_size();
+}
+
+void PlainTextDbIndex::Unmap() { mapping.reset(); }
+
+void PlainTextDbIndex::Invalidate()
+{
+    Unmap();
+    entries.clear();
+    stamp = {};
+    valid = false;
+}
+
+bool PlainTextDbIndex::Map(const std::string& filename)
+{
+    Unmap();
+
+    // Zero-sized files can't be mapped. There is nothing to index there anyway.
+    if(stamp.size == 0)
+        return true;
+
+    try
+    {
+        auto new_mapping  = std::make_unique<Mapping>();
+        new_mapping->file = boost::interprocess::file_mapping(filename.c_str(),
+                                                              boost::interprocess::read_only);
+        new_mapping->region =
+            boost::interprocess::mapped_region(new_mapping->file, boost::interprocess::read_only);
+        mapping = std::move(new_mapping);
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map file " << filename << ": " << ex.what());
+        return false;
+    }
+
+    // The file may have been changed between stat() and mmap().
+    if(Size() != stamp.size)
+    {
+        Unmap();
+        return false;
+    }
+    return true;
+}
+
+void PlainTextDbIndex::Build(const std::string& filename)
+{
+    entries.clear();
+    has_duplicates = false;
+
+    const auto data = Data();
+    const auto size = Size();
+    auto n_line     = 0;
+
+    for(std::size_t line_begin = 0; line_begin < size;)
+    {
+        const auto newline =
+            static_cast<const char*>(std::memchr(data + line_begin, '\n', size - line_begin));
+        const auto line_end  = newline == nullptr ? size : newline - data;
+        const auto next_line = newline == nullptr ? size : line_end + 1;
+        ++n_line;
+
+        const auto line     = data + line_begin;
+        const auto line_len = line_end - line_begin;
+        const auto eq       = static_cast<const char*>(std::memchr(line, '=', line_len));
+        const auto key_size = eq == nullptr ? 0 : static_cast<std::size_t>(eq - line);
+
+        if(key_size == 0)
+        {
+            if(line_len != 0) // Do not blame empty lines.
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
+        }
+        else if(key_size + 1 == line_len)
+        {
+            MIOPEN_LOG_E("None contents under the key: " << std::string(line, key_size)
+                                                         << " form file " << filename << "#"
+                                                         << n_line);
+        }
+        else
+        {
+            entries.push_back({static_cast<std::streamoff>(line_begin),
+                               static_cast<std::streamoff>(next_line),
+                               key_size});
+        }
+
+        line_begin = next_line;
+    }
+
+    // Only the first occurence of a key is visible, same as for the sequential search.
+    const auto less = [data](const Entry& l, const Entry& r) {
+        const auto cmp =
+            std::memcmp(data + l.begin, data + r.begin, std::min(l.key_size, r.key_size));
+        return cmp != 0 ? cmp < 0 : l.key_size < r.key_size;
+    };
+    const auto equal = [data](const Entry& l, const Entry& r) {
+        return l.key_size == r.key_size &&
+               std::memcmp(data + l.begin, data + r.begin, l.key_size) == 0;
+    };
+    std::stable_sort(entries.begin(), entries.end(), less);
+    const auto last = std::unique(entries.begin(), entries.end(), equal);
+    has_duplicates  = last != entries.end();
+    entries.erase(last, entries.end());
+
+    MIOPEN_LOG_I2("Indexed " << entries.size() << " records from " << n_line << " lines of "
+                             << filename);
+}
+
+bool PlainTextDbIndex::Refresh(const std::string& filename)
+{
+    const auto current = GetFileStamp(filename);
+
+    if(valid && current == stamp && (mapping != nullptr || stamp.size == 0))
+        return stamp.exists;
+
+    Invalidate();
+    stamp = current;
+
+    if(!stamp.exists)
+    {
+        valid = true;
+        return false;
+    }
+
+    if(!Map(filename))
+    {
+        stamp = {};
+        return false;
+    }
+
+    Build(filename);
+    valid = true;
+    return true;
+}
+
+int PlainTextDbIndex::Compare(const Entry& entry, const std::string& key) const
+{
+    const auto cmp =
+        std::memcmp(Data() + entry.begin, key.data(), std::min(entry.key_size, key.size()));
+    if(cmp != 0)
+        return cmp;
+    if(entry.key_size == key.size())
+        return 0;
+    return entry.key_size < key.size() ? -1 : 1;
+}
+
+const PlainTextDbIndex::Entry* PlainTextDbIndex::Find(const std::string& key) const
+{
+    assert(valid);
+
+    const auto it = std::lower_bound(
+        entries.begin(), entries.end(), key, [this](const Entry& entry, const std::string& k) {
+            return Compare(entry, k) < 0;
+        });
+
+    if(it == entries.end() || Compare(*it, key) != 0)
+        return nullptr;
+    return &*it;
+}
+
+std::string_view PlainTextDbIndex::GetContents(const Entry& entry) const
+{
+    const auto data  = Data();
+    const auto begin = entry.begin + entry.key_size + 1;
+    auto end         = entry.end;
+    if(end > begin && data[end - 1] == '\n')
+        --end;
+    return {data + begin, static_cast<std::size_t>(end - begin)};
+}
+
+void PlainTextDbIndex::Update(const std::string& filename,
+                              const RecordPositions& pos,
+                              const std::string& key,
+                              std::streamoff written)
+{
+    if(!valid)
+        return;
+
+    const auto appended = pos.begin < 0 || pos.end < 0;
+    const auto begin    = appended ? static_cast<std::streamoff>(stamp.size) : pos.begin;
+    const auto delta    = appended ? written : written - (pos.end - pos.begin);
+
+    if(!appended && written == 0 && has_duplicates)
+    {
+        // A hidden duplicate of the removed record may become visible now.
+        Invalidate();
+        return;
+    }
+
+    const auto expected_size = static_cast<std::streamoff>(stamp.size) + delta;
+
+    stamp = GetFileStamp(filename);
+    if(!stamp.exists || static_cast<std::streamoff>(stamp.size) != expected_size ||
+       !Map(filename))
+    {
+        Invalidate();
+        return;
+    }
+
+    if(!appended)
+    {
+        entries.erase(std::remove_if(entries.begin(),
+                                     entries.end(),
+                                     [&](const Entry& entry) { return entry.begin == begin; }),
+                      entries.end());
+        for(auto& entry : entries)
+        {
+            if(entry.begin > begin)
+            {
+                entry.begin += delta;
+                entry.end += delta;
+            }
+        }
+    }
+
+    if(written == 0)
+        return;
+
+    const auto entry = Entry{begin, begin + written, key.size()};
+
+    // Guard against files which were not terminated with a newline before an append.
+    if(begin != 0 && Data()[begin - 1] != '\n')
+    {
+        Invalidate();
+        return;
+    }
+
+    const auto it = std::lower_bound(
+        entries.begin(), entries.end(), key, [this](const Entry& e, const std::string& k) {
+            return Compare(e, k) < 0;
+        });
+
+    if(it != entries.end() && Compare(*it, key) == 0)
+    {
+        // Should never happen: the key has been found before the write.
+        Invalidate();
+        return;
+    }
+
+    entries.insert(it, entry);
+}
+
+} // namespace miopen
@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 #include <ostream>
@@ -118,15 +119,18 @@ static bool TransformFindDbItem10to20(std::string& id, std::string& values)
 }
 #endif
 
-bool DbRecord::ParseContents(std::istream& contents)
+bool DbRecord::ParseContents(std::string_view contents)
 {
-    std::string id_and_values;
     int found = 0;
 
     map.clear();
 
-    while(std::getline(contents, id_and_values, ';'))
+    while(!contents.empty())
     {
+        const auto item_size     = std::min(contents.find(';'), contents.size());
+        const auto id_and_values = contents.substr(0, item_size);
+        contents.remove_prefix(std::min(item_size + 1, contents.size()));
+
         const auto id_size = id_and_values.find(':');
 
         // Empty VALUES is ok, empty ID is not:
@@ -136,8 +140,8 @@ bool DbRecord::ParseContents(std::istream& contents)
             continue;
         }
 
-        auto id     = id_and_values.substr(0, id_size);
-        auto values = id_and_values.substr(id_size + 1);
+        auto id     = std::string{id_and_values.substr(0, id_size)};
+        auto values = std::string{id_and_values.substr(id_size + 1)};
 
 #if WORKAROUND_ISSUE_1987
         // Detect legacy find-db item (v.1.0 ID:VALUES) and transform it to the current format.
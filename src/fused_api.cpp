@@ -81,6 +81,29 @@ extern "C" miopenStatus_t miopenCompileFusionPlan(miopenHandle_t handle,
     return res;
 }
 
+extern "C" miopenStatus_t miopenFusionPlanSetCompileMode(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                         miopenFusionCompileMode_t mode)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, mode);
+    return miopen::try_([&] {
+        if(mode != miopenFusionCompileAll && mode != miopenFusionCompileBestFirst &&
+           mode != miopenFusionCompileBestOnly)
+            MIOPEN_THROW(miopenStatusBadParm, "Unknown fusion plan compile mode");
+        miopen::deref(fusePlanDesc).compile_mode = mode;
+    });
+}
+
+extern "C" miopenStatus_t
+miopenFusionPlanGetCompileStatus(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                 size_t* built,
+                                 size_t* pending)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, built, pending);
+    return miopen::try_([&] {
+        miopen::deref(fusePlanDesc).GetCompileStatus(miopen::deref(built), miopen::deref(pending));
+    });
+}
+
 extern "C" miopenStatus_t
 miopenFusionPlanGetWorkSpaceSize(miopenHandle_t handle,
                                  miopenFusionPlanDescriptor_t fusePlanDesc,
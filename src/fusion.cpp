@@ -38,6 +38,7 @@
 #include <ostream>
 #include <ios>
 #include <algorithm>
+#include <future>
 #include <string>
 #include <half.hpp>
 
@@ -93,6 +94,8 @@ miopenStatus_t ConvBiasActivFusion(Handle& handle,
     MIOPEN_CHECK(fusePlanDesc.AddOp(biasOp));
     MIOPEN_CHECK(fusePlanDesc.AddOp(activOp));
 
+    // The plan is executed once and destroyed, so building the other solutions is wasted time.
+    fusePlanDesc.compile_mode = miopenFusionCompileBestOnly;
     MIOPEN_CHECK(fusePlanDesc.Compile(handle));
     float alpha       = static_cast<float>(1.0);
     float beta        = static_cast<float>(0);
@@ -506,6 +509,28 @@ static auto MakeFusionInvokeParams(const FusionContext& fusion_ctx,
 
 miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
 {
+    // The invokers built in the background by the previous compilation are registered with the
+    // handle they are built for, and are not built again below.
+    auto built_before = std::vector<std::string>{};
+    auto built_config = NetworkConfig{};
+    if(background_compile.valid())
+    {
+        background_compile.wait();
+        const std::lock_guard<std::mutex> lock{compile_status->mutex};
+        if(compile_status->handle == &handle)
+        {
+            for(const auto& built : compile_status->invokers)
+            {
+                handle.RegisterInvoker(built.second, compile_status->network_config, built.first);
+                built_before.push_back(built.first);
+            }
+            built_config = compile_status->network_config;
+        }
+        background_compile = {};
+    }
+    solutions.clear();
+    compile_status = std::make_shared<FusionCompileStatus>();
+
     miopenStatus_t status = miopenStatusUnknownError;
     const auto solvers    = GetFusedSolvers();
     auto fusion_ctx       = FusionContext{handle};
@@ -561,21 +586,91 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
             if(!sol.invoker_factory)
                 MIOPEN_THROW(miopenStatusInternalError,
                              "Invoker missing from solver " + sol.solver_id);
+        }
+        std::stable_sort(sols.begin(),
+                         sols.end(),
+                         [](const solver::ConvSolution& a, const solver::ConvSolution& b) -> bool {
+                             return a.weight > b.weight;
+                         });
+        // Tuning may change the solutions, so their invokers are built again then.
+        const auto reuse = !enforce.IsSearch(fusion_ctx) &&
+                           built_config.ToString() == network_config.ToString();
+        const auto build = [&](const solver::ConvSolution& sol) {
+            if(reuse && std::count(built_before.begin(), built_before.end(), sol.solver_id) != 0)
+                return;
             const auto invoker =
                 handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
             handle.RegisterInvoker(invoker, network_config, sol.solver_id, {});
-            solutions.push_back(sol);
+        };
+        if(compile_mode == miopenFusionCompileAll)
+        {
+            for(const auto& sol : sols)
+            {
+                build(sol);
+                solutions.push_back(sol);
+                ++compile_status->built;
+            }
+        }
+        else
+        {
+            // Only solutions[0] is executed, so the first one that builds is enough.
+            auto best = sols.begin();
+            for(;; ++best)
+            {
+                try
+                {
+                    build(*best);
+                    break;
+                }
+                catch(const std::exception& ex)
+                {
+                    if(std::next(best) == sols.end())
+                        throw;
+                    MIOPEN_LOG_W("Failed to build " << best->solver_id << ": " << ex.what());
+                }
+            }
+            solutions.push_back(*best);
+            compile_status->built = 1;
+            if(compile_mode == miopenFusionCompileBestFirst && std::next(best) != sols.end())
+            {
+                auto rest = std::vector<solver::ConvSolution>(std::next(best), sols.end());
+                compile_status->pending        = rest.size();
+                compile_status->handle         = &handle;
+                compile_status->network_config = network_config;
+                auto build_rest = [&handle, rest = std::move(rest), status = compile_status]() {
+                    for(const auto& sol : rest)
+                    {
+                        try
+                        {
+                            auto invoker = handle.PrepareInvoker(*sol.invoker_factory,
+                                                                 sol.construction_params);
+                            {
+                                const std::lock_guard<std::mutex> lock{status->mutex};
+                                status->invokers.emplace_back(sol.solver_id, std::move(invoker));
+                            }
+                            ++status->built;
+                        }
+                        catch(const std::exception& ex)
+                        {
+                            MIOPEN_LOG_W("Failed to build " << sol.solver_id << ": " << ex.what());
+                        }
+                        --status->pending;
+                    }
+                };
+                background_compile = handle.RunInBackground(std::move(build_rest));
+            }
         }
-        std::sort(solutions.begin(),
-                  solutions.end(),
-                  [](const solver::ConvSolution& a, const solver::ConvSolution& b) -> bool {
-                      return a.weight > b.weight;
-                  });
         status = miopenStatusSuccess;
     }
     return status;
 }
 
+void FusionPlanDescriptor::GetCompileStatus(std::size_t& built, std::size_t& pending) const
+{
+    built   = compile_status->built;
+    pending = compile_status->pending;
+}
+
 miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
                                              const TensorDescriptor& inputDesc,
                                              ConstData_t input,
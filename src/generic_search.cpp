@@ -27,6 +27,7 @@
 #include <miopen/generic_search.hpp>
 #include <miopen/generic_search_controls.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <chrono>
@@ -58,5 +59,19 @@ std::size_t GetTuningThreadsMax()
     return Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, def_max);
 }
 
+std::size_t GetTuningSearchBudget(std::size_t n_configs)
+{
+    const auto iterations_max = GetTuningIterationsMax();
+    if(iterations_max != std::numeric_limits<std::size_t>::max())
+        return std::min(n_configs, iterations_max);
+    // Model-guided searches are meant to get close to the optimum in a fraction of the space.
+    return std::min(n_configs, std::max<std::size_t>(64, n_configs / 8));
+}
+
+std::size_t GetTuningMeasureWorkers()
+{
+    return std::max<std::size_t>(Value(MIOPEN_TUNING_MEASURE_WORKERS{}, 1), 1);
+}
+
 } // namespace solver
 } // namespace miopen
@@ -54,6 +54,7 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <deque>
 #include <thread>
 #include <mutex>
 #include <shared_mutex>
@@ -156,6 +157,24 @@ int set_default_device()
 }
 #endif
 
+/// Options the program is built with, which are also its key in the binary cache.
+std::string GetProgramOptions(const TargetProperties& target,
+                              const std::string& program_name,
+                              std::string params,
+                              bool is_kernel_str,
+                              const std::string& kernel_src)
+{
+    if(!miopen::EndsWith(program_name, ".mlir"))
+    {
+        params += " -mcpu=" + target.Name();
+    }
+    // The headers of embedded HIP kernels are part of the cache key, so editing a header
+    // only invalidates the binaries of the kernels that include it.
+    if(!is_kernel_str && kernel_src.empty() && miopen::EndsWith(program_name, ".cpp"))
+        params += " -DMIOPEN_HIP_INC_HASH=" + miopen::GetHipKernelIncHash(program_name);
+    return params;
+}
+
 } // namespace
 
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
@@ -190,7 +209,17 @@ struct HandleImpl
     void elapsed_time(hipEvent_t start, hipEvent_t stop)
     {
         if(enable_profiling)
-            hipEventElapsedTime(&this->profiling_result, start, stop);
+            hipEventElapsedTime(&current_profiling_result(), start, stop);
+    }
+
+    // Kernel time is tracked per stream, so that threads measuring kernels on
+    // different streams of the pool do not overwrite each other's results.
+    float& current_profiling_result()
+    {
+        if(meopenHandle_current_stream_id == 0)
+            return profiling_result;
+        std::shared_lock<std::shared_timed_mutex> lock(stream_pool_mutex);
+        return ms_resourse_ptr->profiling_pool.at(meopenHandle_current_stream_id - 1);
     }
 
     std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler()
@@ -238,12 +267,19 @@ struct HandleImpl
         {
             stream_pool.push_back(std::move(s_ptr));
             rhandle_pool.push_back(std::move(r_ptr));
+            profiling_pool.push_back(0.0f);
         }
 #else
-        void add_stream(StreamPtr& s_ptr) { stream_pool.push_back(s_ptr); }
+        void add_resours(StreamPtr s_ptr)
+        {
+            stream_pool.push_back(std::move(s_ptr));
+            profiling_pool.push_back(0.0f);
+        }
 #endif
         //  stream_pool used as cache for parallel streams created by MIOpen.
         StreamPtrPool stream_pool;
+        //  Kernel time of each stream in the pool. std::deque keeps references valid on growth.
+        std::deque<float> profiling_pool;
     };
 
     MultiStreamResourses* ms_resourse_ptr;
@@ -366,7 +402,7 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
-float Handle::GetKernelTime() const { return this->impl->profiling_result; }
+float Handle::GetKernelTime() const { return this->impl->current_profiling_result(); }
 
 Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
 {
@@ -461,8 +497,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -483,10 +519,8 @@ Program Handle::LoadProgram(const std::string& program_name,
 {
     this->impl->set_ctx();
 
-    if(!miopen::EndsWith(program_name, ".mlir"))
-    {
-        params += " -mcpu=" + this->GetTargetProperties().Name();
-    }
+    params = GetProgramOptions(
+        this->GetTargetProperties(), program_name, std::move(params), is_kernel_str, kernel_src);
 
     auto hsaco = miopen::LoadBinary(this->GetTargetProperties(),
                                     this->GetMaxComputeUnits(),
@@ -527,6 +561,49 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
 }
 
+std::string Handle::GetProgramBinary(const std::string& program_name,
+                                     const std::string& params) const
+{
+    auto program = this->impl->cache.GetProgram(program_name, params);
+    if(!program)
+    {
+        program = this->LoadProgram(program_name, params, false, "");
+        this->AddProgram(*program, program_name, params);
+    }
+    if(program->IsCodeObjectInMemory())
+        return program->GetCodeObjectBlob();
+
+    // Programs loaded from code objects or built into files do not keep the former in memory, so
+    // they are read from the binary cache again or, if it has been evicted or disabled, rebuilt.
+    const auto options =
+        GetProgramOptions(this->GetTargetProperties(), program_name, params, false, "");
+    const auto hsaco = miopen::LoadBinary(
+        this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, options, false);
+    if(!hsaco.empty())
+    {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        return hsaco;
+#else
+        return miopen::LoadFile(hsaco);
+#endif
+    }
+
+    this->impl->set_ctx();
+    const auto rebuilt =
+        HIPOCProgram{program_name, options, false, this->GetTargetProperties(), ""};
+    if(rebuilt.IsCodeObjectInMemory())
+        return rebuilt.GetCodeObjectBlob();
+    return miopen::LoadFile(rebuilt.GetCodeObjectPathname().string());
+}
+
+void Handle::AddProgramBinary(const std::string& program_name,
+                              const std::string& params,
+                              const std::string& binary) const
+{
+    this->impl->set_ctx();
+    this->AddProgram(HIPOCProgram{program_name, binary}, program_name, params);
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -573,8 +650,11 @@ void Handle::Flush() const {}
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
-void Handle::ResetKernelTime() const { this->impl->profiling_result = 0.0; }
-void Handle::AccumKernelTime(float curr_time) const { this->impl->profiling_result += curr_time; }
+void Handle::ResetKernelTime() const { this->impl->current_profiling_result() = 0.0; }
+void Handle::AccumKernelTime(float curr_time) const
+{
+    this->impl->current_profiling_result() += curr_time;
+}
 
 std::size_t Handle::GetLocalMemorySize() const
 {
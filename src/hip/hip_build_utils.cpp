@@ -42,6 +42,20 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_DUMP)
 
 namespace miopen {
 
+#ifdef __linux__
+/// The include files are written out once per process and shared by all builds.
+static const TmpDir& HipKernelIncludeDir()
+{
+    static const TmpDir dir = [] {
+        auto inc_dir = TmpDir{"hip-include"};
+        for(const auto& inc_file : GetHipKernelIncList())
+            WriteFile(GetKernelInc(inc_file), inc_dir.path / inc_file);
+        return inc_dir;
+    }();
+    return dir;
+}
+#endif
+
 static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const std::string& filename,
                                             std::string src,
@@ -50,20 +64,6 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const bool testing_mode)
 {
 #ifdef __linux__
-    // Write out the include files
-    // Let's assume includes are overkill for feature tests & optimize'em out.
-    if(!testing_mode)
-    {
-        auto inc_list = GetHipKernelIncList();
-        auto inc_path = tmp_dir->path;
-        boost::filesystem::create_directories(inc_path);
-        for(const auto& inc_file : inc_list)
-        {
-            auto inc_src = GetKernelInc(inc_file);
-            WriteFile(inc_src, inc_path / inc_file);
-        }
-    }
-
     src += "\nint main() {}\n";
     WriteFile(src, tmp_dir->path / filename);
 
@@ -84,6 +84,9 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
     params += " -c";
     params += " -O3 ";
     params += " -Wno-unused-command-line-argument -I. ";
+    // Let's assume includes are overkill for feature tests & optimize'em out.
+    if(!testing_mode)
+        params += "-I" + HipKernelIncludeDir().path.string() + " ";
     params += MIOPEN_STRINGIZE(HIP_COMPILER_FLAGS);
 
 #if HIP_PACKAGE_VERSION_FLAT < 4004000000ULL
@@ -157,7 +160,7 @@ static bool
 HipBuildTest(const std::string& program_name, std::string params, const TargetProperties& target)
 {
     boost::optional<miopen::TmpDir> dir(program_name);
-    std::string source = miopen::GetKernelSrc(program_name);
+    std::string source{miopen::GetKernelSrc(program_name)};
     try
     {
         std::ignore = HipBuildImpl(dir, program_name, source, params, target, true);
@@ -318,7 +318,7 @@ void HIPOCProgramImpl::BuildCodeObject(std::string params,
             return kernel_src;
         if(is_kernel_str)
             return program;
-        return GetKernelSrc(program);
+        return std::string{GetKernelSrc(program)};
     }();
 
     if(miopen::EndsWith(filename, ".cpp"))
@@ -35,6 +35,7 @@
 namespace miopen {
 
 struct NetworkConfig;
+class ProblemKey;
 
 namespace activ {
 
@@ -89,6 +90,7 @@ struct ProblemDescription : ProblemDescriptionBase
     }
 
     NetworkConfig MakeNetworkConfig() const;
+    ProblemKey MakeProblemKey() const;
 
 private:
     Direction direction;
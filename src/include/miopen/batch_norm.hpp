@@ -39,6 +39,7 @@
 namespace miopen {
 
 struct Handle;
+struct Plan;
 struct TensorDescriptor;
 
 void DeriveBNTensorDescriptor(TensorDescriptor& derivedBnDesc,
@@ -214,6 +215,32 @@ void BatchNormBackward(Handle& handle,
                        ConstData_t savedMean,
                        ConstData_t savedInvVariance);
 
+Plan MakeBatchNormForwardInferencePlan(Handle& handle,
+                                       miopenBatchNormMode_t bn_mode,
+                                       const TensorDescriptor& xDesc,
+                                       const TensorDescriptor& yDesc,
+                                       const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                       double epsilon);
+
+Plan MakeBatchNormForwardTrainingPlan(Handle& handle,
+                                      miopenBatchNormMode_t bn_mode,
+                                      const TensorDescriptor& xDesc,
+                                      const TensorDescriptor& yDesc,
+                                      const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                      double expAvgFactor,
+                                      double epsilon,
+                                      bool resultrunning,
+                                      bool resultsave);
+
+Plan MakeBatchNormBackwardPlan(Handle& handle,
+                               miopenBatchNormMode_t bn_mode,
+                               const TensorDescriptor& xDesc,
+                               const TensorDescriptor& dyDesc,
+                               const TensorDescriptor& dxDesc,
+                               const TensorDescriptor& bnScaleBiasDiffDesc,
+                               double epsilon,
+                               bool useSaved);
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_BATCHNORMALIZATION_HPP_
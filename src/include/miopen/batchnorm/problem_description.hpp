@@ -36,6 +36,7 @@
 namespace miopen {
 
 struct NetworkConfig;
+class ProblemKey;
 
 namespace batchnorm {
 
@@ -175,6 +176,7 @@ struct ProblemDescription : ProblemDescriptionBase
     }
 
     NetworkConfig MakeNetworkConfig() const;
+    ProblemKey MakeProblemKey() const;
 
 private:
     Direction direction;
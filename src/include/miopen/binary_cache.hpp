@@ -30,6 +30,8 @@
 #include <miopen/config.h>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem/path.hpp>
+#include <cstddef>
+#include <mutex>
 #include <string>
 
 namespace miopen {
@@ -43,6 +45,35 @@ boost::filesystem::path GetCacheFile(const std::string& device,
 
 boost::filesystem::path GetCachePath(bool is_system);
 
+/// Size budget of the user kernel cache in bytes, set by MIOPEN_KERN_CACHE_SIZE_LIMIT_MB.
+/// 0 if the cache is unbounded.
+std::size_t GetCacheSizeLimit();
+
+/// Once the binaries (*.o) in the subdirectories of cache_dir exceed limit bytes, removes the
+/// least recently used ones until the rest take at most three quarters of it, then removes the
+/// directories left empty. Returns the number of removed binaries.
+std::size_t EvictCacheFiles(const boost::filesystem::path& cache_dir, std::size_t limit);
+
+/// Running size of the binaries in a cache directory, so that saving a binary does not scan the
+/// whole cache. The total is seeded by one scan on the first Add and resynchronized whenever
+/// it exceeds the limit and EvictCacheFiles runs.
+class CacheSizeTracker
+{
+public:
+    CacheSizeTracker(boost::filesystem::path cache_dir_, std::size_t limit_);
+
+    /// Accounts for a binary of added bytes stored in the cache over one of replaced bytes and
+    /// evicts binaries once the total exceeds the limit. Returns the number of removed binaries.
+    std::size_t Add(std::size_t added, std::size_t replaced = 0);
+
+private:
+    boost::filesystem::path cache_dir;
+    std::size_t limit;
+    std::size_t total = 0;
+    bool seeded       = false;
+    std::mutex mutex;
+};
+
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 boost::filesystem::path LoadBinary(const TargetProperties& target,
                                    std::size_t num_cu,
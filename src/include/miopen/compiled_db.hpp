@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILED_DB_HPP_
+#define GUARD_MIOPEN_COMPILED_DB_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Binary ("compiled") form of a read-only text database which is used without parsing.
+///
+/// Layout (integers are in host byte order, a mismatch is detected via the header):
+///   Header | Record[record_count] sorted by key | Item[item_count] | string pool
+/// Each record refers to a contiguous range of items, which hold already split ids and values.
+class CompiledDb
+{
+public:
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint64_t record_count;
+        std::uint64_t item_count;
+        std::uint64_t records_offset;
+        std::uint64_t items_offset;
+        std::uint64_t strings_offset;
+        std::uint64_t strings_size;
+        // The text file this one has been compiled from.
+        std::uint64_t source_size;
+        std::int64_t source_mtime;
+        char source_md5[32];
+    };
+
+    struct Record
+    {
+        std::uint64_t key_offset;
+        std::uint32_t key_size;
+        std::uint32_t line;
+        std::uint64_t first_item;
+        std::uint64_t item_count;
+    };
+
+    struct Item
+    {
+        std::uint64_t id_offset;
+        std::uint64_t value_offset;
+        std::uint32_t id_size;
+        std::uint32_t value_size;
+    };
+
+    /// Identifies the text file a compiled db has been built from.
+    struct SourceStamp
+    {
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;
+        std::string md5;
+    };
+
+    struct Memory;
+
+    CompiledDb(std::unique_ptr<Memory> memory_, std::string name_);
+    ~CompiledDb();
+
+    /// Returns the path where compiled form of the text db is expected: ".txt" suffix is
+    /// replaced with ".bin" or the latter is appended.
+    static std::string GetCompiledPath(const std::string& text_path);
+
+    /// Parses the text db and writes its compiled form. The first record with the given key is
+    /// used, same as with the text db.
+    static bool Compile(std::istream& text,
+                        const SourceStamp& source,
+                        std::ostream& out,
+                        const std::string& name);
+    /// If the text file is hashed the same as the one out_path has been compiled from, only the
+    /// recorded modification time is updated.
+    static bool Compile(const std::string& text_path, const std::string& out_path);
+
+    /// Maps a compiled db file. Returns nullptr if it is unavailable or its header is ill-formed.
+    /// Records are validated when looked up.
+    static std::unique_ptr<CompiledDb> Open(const std::string& path);
+
+    const std::string& GetName() const { return name; }
+    /// True if the size or modification time of the text file differs from the one this db has
+    /// been compiled from. False if the text file is unavailable.
+    bool IsOutdated(const std::string& text_path) const;
+    std::uint64_t GetRecordCount() const { return header->record_count; }
+
+    /// Returns nullptr if there is no record with the given key or it is ill-formed.
+    const Record* Find(const std::string& key) const;
+
+    const Item* GetItems(const Record& record) const { return items + record.first_item; }
+    std::string GetString(std::uint64_t offset, std::uint32_t size) const
+    {
+        return {strings + offset, strings + offset + size};
+    }
+
+private:
+    std::unique_ptr<Memory> memory;
+    std::string name;
+    const Header* header  = nullptr;
+    const Record* records = nullptr;
+    const Item* items     = nullptr;
+    const char* strings   = nullptr;
+
+    static bool Restamp(const std::string& path, const SourceStamp& source);
+    bool Validate(const char* data, std::size_t size);
+    bool IsValidRecord(const Record& record) const;
+    bool IsValidString(std::uint64_t offset, std::uint32_t size) const;
+    int Compare(const Record& record, const std::string& key) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILED_DB_HPP_
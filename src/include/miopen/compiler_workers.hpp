@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILER_WORKERS_HPP
+#define GUARD_MIOPEN_COMPILER_WORKERS_HPP
+
+#include <boost/filesystem/path.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Long-lived shell processes that run compiler command lines.
+///
+/// std::system() forks the calling process for every command, which gets slow once the
+/// process has mapped a lot of memory, and then starts a new shell. A worker is a shell that
+/// is spawned once and fed one command per line over a pipe; it writes the exit code of each
+/// command back over another pipe. Workers are started on demand, up to the given count, and
+/// commands beyond that wait for a free worker. Output of the commands goes to stderr.
+class CompilerWorkers
+{
+public:
+    explicit CompilerWorkers(std::size_t max_workers_, std::string shell_ = "/bin/sh");
+    ~CompilerWorkers();
+
+    CompilerWorkers(const CompilerWorkers&) = delete;
+    CompilerWorkers& operator=(const CompilerWorkers&) = delete;
+
+    /// Runs the command in the directory and returns its exit code.
+    /// Throws if the command can not be handed to a worker.
+    int Run(const std::string& cmd, const boost::filesystem::path& dir);
+
+    /// The process-wide workers. Their number is the hardware concurrency.
+    static CompilerWorkers& Get();
+
+    /// False if disabled with MIOPEN_DEBUG_COMPILER_WORKERS=0 or not supported on this platform.
+    static bool IsAvailable();
+
+private:
+    struct Worker;
+
+    std::unique_ptr<Worker> Acquire();
+    void Release(std::unique_ptr<Worker> worker);
+
+    const std::string shell;
+    const std::size_t max_workers;
+    std::size_t started = 0;
+    std::vector<std::unique_ptr<Worker>> idle;
+    std::mutex mutex;
+    std::condition_variable worker_released;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILER_WORKERS_HPP
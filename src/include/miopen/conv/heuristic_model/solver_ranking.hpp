@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_SOLVER_RANKING_HPP_
+#define GUARD_MIOPEN_SOLVER_RANKING_HPP_
+
+#include <miopen/config.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+namespace ai {
+namespace ranking {
+
+/// Problem parameters recovered from a convolution find-db key, see
+/// ProblemDescription::Serialize. Find-db records are what the solver ranking model is trained
+/// on, so the model reads its input from the key to be sure it sees the same features at
+/// run time as it did during training.
+struct ConvDbKeyFeatures
+{
+    static constexpr std::size_t num_values = 23;
+
+    /// in_c, in_d, in_h, in_w, wei_d, wei_h, wei_w, out_c, out_d, out_h, out_w, batch,
+    /// pad_d, pad_h, pad_w, stride_d, stride_h, stride_w, dilation_d, dilation_h, dilation_w,
+    /// bias and group count. Depths, strides and dilations of 2D problems are 1, their depth
+    /// padding is 0.
+    std::array<float, num_values> values{};
+    std::string layout;    ///< Layout of the input, e.g. "NCHW".
+    std::string data_type; ///< Data types as encoded in the key, e.g. "FP32".
+    char direction = 0;    ///< 'F', 'B' or 'W'.
+};
+
+/// Returns false if the key is not a well-formed convolution find-db key.
+bool ParseConvDbKey(const std::string& key, ConvDbKeyFeatures& features);
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+
+/// Predicts the run time of every solver it was trained on for a convolution problem of the
+/// device. Consists of two files in the system db directory:
+///
+/// * <arch>_SolverRanking.model is a frugally-deep model. Its input is a vector of the
+///   ConvDbKeyFeatures::values, each transformed with log1p() and standardized with the mean
+///   and std from the metadata, followed by one-hot encodings of the direction (F, B, W), the
+///   data type and the layout. Its output holds the natural logarithm of the time, in ms, of
+///   each solver.
+/// * <arch>_SolverRanking_metadata.model is JSON with the "mean" and "std" arrays, the
+///   "data_types" and "layouts" in the order of their one-hot encodings and the "solvers" in
+///   the order of the output.
+struct SolverRankingModel
+{
+    struct impl;
+    std::unique_ptr<impl> pImpl;
+
+    SolverRankingModel();
+    ~SolverRankingModel();
+    SolverRankingModel(SolverRankingModel&&) noexcept;
+    SolverRankingModel(const std::string& arch);
+    SolverRankingModel& operator=(SolverRankingModel&&) noexcept;
+
+    /// Returns nullptr if there is no usable model for the device. Models are loaded once.
+    static const SolverRankingModel* Get(const std::string& arch);
+
+    /// Sets the predicted time, in ms, of each solver the model knows. Returns false if the
+    /// problem can not be encoded, e.g. because its data type was not in the training data.
+    bool Predict(const std::string& db_key, std::unordered_map<std::string, float>& times) const;
+    const std::vector<std::string>& GetSolvers() const;
+};
+
+#endif
+
+} // namespace ranking
+} // namespace ai
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLVER_RANKING_HPP_
@@ -481,6 +481,11 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
 
     std::size_t GetSolutionCountFallback(Handle& handle, const ProblemDescription& problem) const;
 
+    /// Returns the solution immediate mode would use for the problem with its kernels described
+    /// but not built. Used to warm up the binary cache ahead of the first run.
+    solver::ConvSolution GetImmediateSolution(Handle& handle,
+                                              const ProblemDescription& problem) const;
+
     friend void to_json(nlohmann::json& json, const ConvolutionDescriptor& conv);
     friend void from_json(const nlohmann::json& json, ConvolutionDescriptor& conv);
 };
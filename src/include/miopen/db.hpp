@@ -34,7 +34,10 @@
 #include <boost/optional/optional.hpp>
 
 #include <chrono>
+#include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 
 namespace boost {
 namespace filesystem {
@@ -51,14 +54,22 @@ struct RecordPositions
 };
 
 class LockFile;
+class PlainTextDbIndex;
 
 constexpr bool DisableUserDbFileIO = MIOPEN_DISABLE_USERDB;
 
 /// No instance of this class should be used from several threads at the same time.
+///
+/// Unless disabled by MIOPEN_DEBUG_PLAINTEXT_DB_INDEX, lookups go through a sorted index over the
+/// memory-mapped file (see PlainTextDbIndex) instead of sequential reading of the whole file.
+/// The index is shared by all the instances using the same file within the process.
 class PlainTextDb
 {
 public:
     PlainTextDb(const std::string& filename_, bool is_system = false);
+    PlainTextDb(const PlainTextDb& other);
+    PlainTextDb(PlainTextDb&& other) noexcept;
+    ~PlainTextDb();
 
     /// Searches db for provided key and returns found record or none if key not found in database
     boost::optional<DbRecord> FindRecord(const std::string& key);
@@ -156,7 +167,10 @@ private:
     std::string filename;
     LockFile& lock_file;
     const bool warning_if_unreadable;
+    PlainTextDbIndex* index;
 
+    boost::optional<DbRecord> FindRecordIndexedUnsafe(const std::string& key,
+                                                      RecordPositions* pos);
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
 
     template <class T>
@@ -185,6 +199,27 @@ TRet GetDbInstance(const std::string& path, bool is_system = true)
     return GetDbInstance<TDb>(rank<1>{}, path, is_system);
 }
 
+/// Keeps a batched write session of a database open while alive. Databases that do not
+/// batch writes hand out an empty session.
+class DbWriteSession
+{
+public:
+    DbWriteSession() = default;
+    explicit DbWriteSession(std::function<void()> end_) : end(std::move(end_)) {}
+    DbWriteSession(DbWriteSession&& other) noexcept : end(std::exchange(other.end, nullptr)) {}
+    DbWriteSession(const DbWriteSession&) = delete;
+    DbWriteSession& operator=(const DbWriteSession&) = delete;
+    DbWriteSession& operator=(DbWriteSession&&) = delete;
+    ~DbWriteSession()
+    {
+        if(end)
+            end();
+    }
+
+private:
+    std::function<void()> end;
+};
+
 template <class TInstalled, class TUser, bool merge_records>
 class MultiFileDb
 {
@@ -261,7 +296,30 @@ public:
         return _user.Remove(args...);
     }
 
+    /// Writes to the user database made while the session is alive may be committed together
+    /// when it ends.
+    DbWriteSession BeginWriteSession()
+    {
+#if !MIOPEN_DISABLE_USERDB
+        return BeginWriteSession(rank<1>{}, _user);
+#else
+        return {};
+#endif
+    }
+
 private:
+    template <class TDb>
+    static auto BeginWriteSession(rank<1>, TDb& db) -> decltype(db.BeginWriteSession())
+    {
+        return db.BeginWriteSession();
+    }
+
+    template <class TDb>
+    static DbWriteSession BeginWriteSession(rank<0>, TDb&)
+    {
+        return {};
+    }
+
     template <class TDb, class TRet = decltype(TDb::GetCached("", true))>
     static TRet GetDbInstance(rank<1>, const std::string& path, bool warn_if_unreadable)
     {
@@ -337,6 +395,8 @@ public:
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    auto BeginWriteSession() { return inner.BeginWriteSession(); }
+
 private:
     TInnerDb inner;
 
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_INDEX_HPP_
+#define GUARD_MIOPEN_DB_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miopen {
+
+struct RecordPositions;
+
+/// Sorted key -> line index over a memory-mapped text db file.
+///
+/// The index is built once and reused while the file stays the same, which is
+/// detected by comparing size, modification time and inode of the file. Writers
+/// which modify the file under the db lock report their changes via Update(), so
+/// the index does not need to be rebuilt after own writes.
+///
+/// PlainTextDb instances are usually created per lookup, so indexes are kept in a process-wide
+/// cache (see GetCached) and shared by all the instances using the same file. Member functions
+/// are not thread-safe: users shall hold GetMutex() in addition to the db lock of the file.
+class PlainTextDbIndex
+{
+public:
+    struct Entry
+    {
+        std::streamoff begin; // Offset of the first byte of the line.
+        std::streamoff end;   // Offset of the first byte of the next line.
+        std::size_t key_size;
+    };
+
+    PlainTextDbIndex();
+    ~PlainTextDbIndex();
+
+    /// Returns the index of the file shared within the process. Never destroyed.
+    static PlainTextDbIndex& GetCached(const std::string& filename);
+
+    std::mutex& GetMutex() { return mutex; }
+
+    /// Rebuilds the index if the file has been changed since the last call.
+    /// Returns false if the file does not exist or is unreadable.
+    bool Refresh(const std::string& filename);
+
+    /// Returns first valid record with the provided key or nullptr if there is none.
+    /// Valid only until the next call of any non-const member function.
+    const Entry* Find(const std::string& key) const;
+
+    /// Returns contents (i.e. ids and values) of the record pointed by the entry.
+    /// Points into the mapped file and is valid only until the next call of any non-const member
+    /// function.
+    std::string_view GetContents(const Entry& entry) const;
+
+    /// Accounts write of WRITTEN bytes with KEY which replaced [pos.begin, pos.end) range of the
+    /// file or was appended to it if the range is empty.
+    void Update(const std::string& filename,
+                const RecordPositions& pos,
+                const std::string& key,
+                std::streamoff written);
+
+    /// Releases the file mapping. Required before the file is replaced on some platforms.
+    void Unmap();
+    void Invalidate();
+
+private:
+    struct FileStamp
+    {
+        std::uintmax_t size = 0;
+        std::int64_t mtime  = 0;
+        std::uint64_t inode = 0;
+        bool exists         = false;
+
+        bool operator==(const FileStamp& other) const
+        {
+            return exists == other.exists && size == other.size && mtime == other.mtime &&
+                   inode == other.inode;
+        }
+        bool operator!=(const FileStamp& other) const { return !(*this == other); }
+    };
+
+    struct Mapping;
+
+    std::mutex mutex;
+    std::unique_ptr<Mapping> mapping;
+    std::vector<Entry> entries;
+    FileStamp stamp;
+    bool valid          = false;
+    bool has_duplicates = false;
+
+    static FileStamp GetFileStamp(const std::string& filename);
+    bool Map(const std::string& filename);
+    void Build(const std::string& filename);
+    const char* Data() const;
+    std::size_t Size() const;
+    int Compare(const Entry& entry, const std::string& key) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_INDEX_HPP_
@@ -34,6 +34,7 @@
 #include <istream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace miopen {
@@ -170,7 +171,7 @@ private:
         return ss.str();
     }
 
-    bool ParseContents(std::istream& contents);
+    bool ParseContents(std::string_view contents);
     void WriteContents(std::ostream& stream) const;
     void WriteIdsAndValues(std::ostream& stream) const;
     bool SetValues(const std::string& id, const std::string& values);
@@ -178,12 +179,6 @@ private:
 
     DbRecord(const std::string& key_) : key(key_) {}
 
-    bool ParseContents(const std::string& contents)
-    {
-        auto ss = std::istringstream(contents);
-        return ParseContents(ss);
-    }
-
 public:
     DbRecord() : key(""){};
     /// T shall provide a db KEY by means of the "void Serialize(std::ostream&) const" member
@@ -250,6 +245,7 @@ public:
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
     friend class RamDb;
+    friend class CompiledDb;
 };
 
 } // namespace miopen
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_EMBEDDED_FILES_HPP
+#define GUARD_MIOPEN_EMBEDDED_FILES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace miopen {
+
+/// A kernel source or include embedded into the library by addkernels.
+///
+/// The byte arrays and their sizes are defined in other translation units, so only their
+/// addresses are constant expressions. This is enough to build the tables at compile time;
+/// the size is read on access. The arrays are null-terminated past the end of the view.
+struct EmbeddedFile
+{
+    std::string_view name;
+    const unsigned char* data;
+    const std::size_t* size;
+
+    std::string_view Content() const { return {reinterpret_cast<const char*>(data), *size}; }
+};
+
+template <std::size_t N>
+constexpr bool IsSortedByName(const std::array<EmbeddedFile, N>& files)
+{
+    for(std::size_t i = 1; i < N; ++i)
+    {
+        if(!(files[i - 1].name < files[i].name))
+            return false;
+    }
+    return true;
+}
+
+/// Binary search in a table sorted by name. Returns nullptr if there is no such file.
+template <std::size_t N>
+const EmbeddedFile* FindEmbeddedFile(const std::array<EmbeddedFile, N>& files,
+                                     std::string_view name)
+{
+    const auto it = std::lower_bound(
+        files.begin(), files.end(), name, [](const EmbeddedFile& file, std::string_view key) {
+            return file.name < key;
+        });
+    if(it == files.end() || it->name != name)
+        return nullptr;
+    return &*it;
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_EMBEDDED_FILES_HPP
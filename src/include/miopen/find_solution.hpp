@@ -32,6 +32,7 @@
 #include <miopen/execution_context.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/solver.hpp>
 
@@ -77,6 +78,20 @@ auto FindSolutionImpl(rank<1>,
         {
             using PerformanceConfig = decltype(s.GetDefaultPerformanceConfig(context, problem));
             PerformanceConfig config{};
+            // An explicitly provided config (e.g. from a serialized solution) takes precedence
+            // over the database, so no records are read for it.
+            if(!perf_cfg.empty())
+            {
+                config.Deserialize(perf_cfg);
+                if(s.IsValidPerformanceConfig(context, problem, config))
+                {
+                    MIOPEN_LOG_I2("Perf config provided: " << s.SolverDbId());
+                    return s.GetSolution(context, problem, config);
+                }
+                MIOPEN_LOG_WE("Invalid perf config provided: " << s.SolverDbId() << ": "
+                                                               << perf_cfg);
+                config = PerformanceConfig{};
+            }
             if(db.Load(problem, s.SolverDbId(), config))
             {
                 MIOPEN_LOG_I2("Perf Db: record loaded: " << s.SolverDbId());
@@ -98,16 +113,6 @@ auto FindSolutionImpl(rank<1>,
                               << s.AltSolverDbId() << ": " << config
                               << ". Performance may degrade.");
             }
-            else if(!perf_cfg.empty())
-            {
-                config.Deserialize(perf_cfg);
-                if(s.IsValidPerformanceConfig(context, problem, config))
-                {
-                    return s.GetSolution(context, problem, config);
-                }
-                MIOPEN_LOG_IE("Invalid config loaded from Perf Db: "
-                              << s.SolverDbId() << ": " << config << ". Performance may degrade.");
-            }
             else
             {
                 MIOPEN_LOG_I("Perf Db: record not found for: " << s.SolverDbId());
@@ -346,18 +351,24 @@ struct SolverContainer
         return found;
     }
 
+    /// Returns the invoker of the primitive problem, preparing it on the first use.
     template <class Problem>
-    void ExecutePrimitive(Handle& handle,
-                          const Problem& problem,
-                          const AlgorithmName& algo,
-                          const AnyInvokeParams& invoke_params) const
+    const Invoker&
+    GetPrimitiveInvoker(Handle& handle, const Problem& problem, const AlgorithmName& algo) const
     {
+        // Fast path for the problems already run, without making the network config.
+        auto key = problem.MakeProblemKey();
+        key.Add(algo.Value());
+
+        if(const auto invoker = handle.GetInvoker(key, 0))
+            return *invoker;
+
         const auto network_config = problem.MakeNetworkConfig();
 
         if(const auto existingInvoker = handle.GetInvoker(network_config, boost::none, algo))
         {
-            (*existingInvoker)(handle, invoke_params);
-            return;
+            handle.RegisterInvoker(*existingInvoker, key, 0);
+            return *existingInvoker;
         }
 
         auto ctx = ExecutionContext{&handle};
@@ -372,7 +383,18 @@ struct SolverContainer
             MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
         const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
         handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
-        invoker(handle, invoke_params);
+        handle.RegisterInvoker(invoker, key, 0);
+        // Keys too long for the fast table are only found by the network config.
+        return *handle.GetInvoker(network_config, boost::none, algo);
+    }
+
+    template <class Problem>
+    void ExecutePrimitive(Handle& handle,
+                          const Problem& problem,
+                          const AlgorithmName& algo,
+                          const AnyInvokeParams& invoke_params) const
+    {
+        GetPrimitiveInvoker(handle, problem, algo)(handle, invoke_params);
     }
 };
 
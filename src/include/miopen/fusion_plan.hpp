@@ -5,9 +5,16 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <miopen/fusion.hpp>
+#include <miopen/invoker.hpp>
 
 #include <boost/optional.hpp>
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 namespace miopen {
 
 namespace solver {
@@ -41,6 +48,23 @@ struct Exec_arg_t
 };
 
 struct FusionContext;
+
+/// Shared with the background compilation started by miopenFusionCompileBestFirst so that the
+/// plan may be moved or destroyed while it is running.
+struct FusionCompileStatus
+{
+    std::atomic<std::size_t> built{0};
+    std::atomic<std::size_t> pending{0};
+
+    /// The invoker cache of the handle is not thread safe, so the invokers built in the
+    /// background are kept here, with the handle and the network config they were built for,
+    /// until the next compilation of the plan registers them.
+    std::mutex mutex;
+    const Handle* handle = nullptr;
+    NetworkConfig network_config;
+    std::vector<std::pair<std::string, Invoker>> invokers;
+};
+
 struct FusionPlanDescriptor : miopenFusionPlanDescriptor
 {
     FusionPlanDescriptor() {}
@@ -57,6 +81,7 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
                            Data_t output,
                            const OperatorArgs& op_args);
     miopenStatus_t Compile(Handle& handle);
+    void GetCompileStatus(std::size_t& built, std::size_t& pending) const;
     friend std::ostream& operator<<(std::ostream& stream, const FusionPlanDescriptor& fpd);
 
     miopenStatus_t
@@ -80,6 +105,10 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     std::vector<solver::ConvSolution> solutions;
     NetworkConfig network_config;
     std::optional<miopenConvFwdAlgorithm_t> conv_fwd_algo;
+    miopenFusionCompileMode_t compile_mode = miopenFusionCompileAll;
+    std::shared_ptr<FusionCompileStatus> compile_status = std::make_shared<FusionCompileStatus>();
+    /// Runs on Handle::RunInBackground, so the handle waits for it before it is destroyed.
+    std::shared_future<void> background_compile;
 };
 
 } // namespace miopen
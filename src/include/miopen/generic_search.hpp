@@ -35,10 +35,13 @@
 #include <miopen/handle.hpp>
 #include <miopen/invoke_params.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/rank.hpp>
 #include <miopen/timer.hpp>
 #include <miopen/type_traits.hpp>
-#include <miopen/mt_queue.hpp>
 #include <miopen/generic_search_controls.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/tuning_journal.hpp>
+#include <miopen/tuning_pipeline.hpp>
 
 #include <algorithm>
 #include <vector>
@@ -48,6 +51,7 @@
 #include <chrono>
 #include <cassert>
 #include <random>
+#include <sstream>
 
 namespace miopen {
 namespace solver {
@@ -302,54 +306,36 @@ GetAllSolutions(const Solver s, const Context& context_, const Problem& problem)
 std::size_t GetTuningIterationsMax();
 std::chrono::milliseconds GetTuningTimeMax(); // returns the max allowed time in milliseconds
 std::size_t GetTuningThreadsMax();
+std::size_t GetTuningMeasureWorkers();
 
-template <typename PerformanceConfig, typename Solver, typename Context, typename Problem>
-void CompileAgent(size_t thread_index,
-                  size_t total_threads,
-                  const Solver& s,
-                  const Context& context,
-                  const Problem& problem,
-                  std::vector<PerformanceConfig>& data,
-                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue)
+template <class Solver, class Problem>
+auto GetTuningJournalKey(rank<1>, const Solver& s, const Problem& problem, const Handle& handle)
+    -> decltype(problem.Serialize(std::declval<std::ostream&>()), boost::optional<std::string>{})
 {
-    const auto start_time =
-        std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now());
-    const auto data_size   = data.size();
-    const auto time_budget = GetTuningTimeMax();
-    const auto& profile_h  = context.GetStream();
-    // start the counter
-    for(auto idx = thread_index; idx < data_size; idx += total_threads)
-    {
-        // Check if we are out of time
-        const auto current_time = std::chrono::time_point_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now());
-        if(current_time - start_time > time_budget)
-        {
-            MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
-            auto tmp = std::make_tuple<PerformanceConfig, ConvSolution, bool>({}, {}, true);
-            comp_queue.push(std::move(tmp));
-            break;
-        }
-        auto& current_config          = data.at(idx);
-        ConvSolution current_solution = s.GetSolution(context, problem, current_config);
-        for(const auto& kernel : current_solution.construction_params)
-        {
-            if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                continue;
-            std::ignore = profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
-        }
-        auto tup = std::make_tuple<PerformanceConfig, ConvSolution, bool>(
-            std::move(current_config), std::move(current_solution), false);
-        comp_queue.push(std::move(tup));
-    }
-    MIOPEN_LOG_I2("Thread: " << thread_index << " Done, completed tuning");
+    std::ostringstream key;
+    key << handle.GetDbBasename() << ' ' << s.SolverDbId() << ' ';
+    problem.Serialize(key);
+    return key.str();
+}
+
+/// Searches of problems without a serialized form are not journaled.
+template <class Solver, class Problem>
+boost::optional<std::string>
+GetTuningJournalKey(rank<0>, const Solver&, const Problem&, const Handle&)
+{
+    return boost::none;
 }
 
+/// The search visits configs in the order given by `strategy`, see SearchStrategyKind.
+/// Model-guided strategies reduce the number of measurements but may miss the best config, so
+/// they are opt-in: either via this parameter or MIOPEN_DEBUG_TUNING_SEARCH_STRATEGY, which
+/// overrides the choice.
 template <class Solver, class Context, class Problem>
 auto GenericSearch(const Solver s,
                    const Context& context_,
                    const Problem& problem,
-                   const AnyInvokeParams& invoke_ctx_)
+                   const AnyInvokeParams& invoke_ctx_,
+                   SearchStrategyKind strategy = SearchStrategyKind::Exhaustive)
     -> decltype(s.GetDefaultPerformanceConfig(context_, problem))
 {
     static_assert(
@@ -381,8 +367,48 @@ auto GenericSearch(const Solver s,
     std::random_device rd{};
     auto rng = std::default_random_engine{rd()};
     std::shuffle(all_configs.begin(), all_configs.end(), rng);
-    const std::size_t n_runs_total = std::min(all_configs.size(), GetTuningIterationsMax());
-    all_configs.resize(n_runs_total);
+
+    const auto strategy_kind = GetTuningSearchStrategy(strategy);
+
+    // Measurements are journaled, so that an interrupted search can be resumed.
+    std::unique_ptr<TuningJournal> journal;
+    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    {
+        const auto key = GetTuningJournalKey(rank<1>{}, s, problem, profile_h);
+        if(key)
+            journal = TuningJournal::Open(*key);
+    }
+
+    std::vector<std::string> serialized;
+    if(journal || strategy_kind != SearchStrategyKind::Exhaustive)
+    {
+        serialized.reserve(all_configs.size());
+        for(const auto& config : all_configs)
+        {
+            std::ostringstream ss;
+            config.Serialize(ss);
+            serialized.push_back(ss.str());
+        }
+    }
+
+    std::vector<ConfigFeatures> space;
+    std::size_t n_runs_total = 0;
+    if(strategy_kind == SearchStrategyKind::Exhaustive)
+    {
+        n_runs_total = std::min(all_configs.size(), GetTuningIterationsMax());
+        space.resize(all_configs.size());
+    }
+    else
+    {
+        n_runs_total = GetTuningSearchBudget(all_configs.size());
+        space.reserve(all_configs.size());
+        for(const auto& config : serialized)
+            space.push_back(GetConfigFeatures(config));
+    }
+    MIOPEN_LOG_I("Search strategy " << strategy_kind << ", " << n_runs_total << " of "
+                                    << all_configs.size() << " configs");
+    TuningSearch search(MakeSearchStrategy(strategy_kind, std::move(space), n_runs_total, rd()),
+                        n_runs_total);
 
     bool is_passed  = false; // left false only if all iterations failed.
     float best_time = std::numeric_limits<float>::max();
@@ -391,60 +417,110 @@ auto GenericSearch(const Solver s,
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
-    const auto total_threads = GetTuningThreadsMax();
-
-    ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>> solution_queue;
-    std::vector<std::thread> compile_agents;
-    compile_agents.reserve(total_threads);
-    for(auto idx = 0; idx < total_threads; ++idx)
+    size_t n_replayed = 0;
+    if(journal)
     {
-        compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
-                                    idx,
-                                    total_threads,
-                                    std::cref(s),
-                                    std::cref(context),
-                                    std::cref(problem),
-                                    std::ref(all_configs),
-                                    std::ref(solution_queue));
+        for(std::size_t idx = 0; idx < all_configs.size(); ++idx)
+        {
+            const auto replayed = journal->Find(serialized[idx]);
+            if(!replayed)
+                continue;
+            search.Replay(idx, *replayed);
+            ++n_replayed;
+            if(!*replayed)
+            {
+                ++n_failed;
+                continue;
+            }
+            is_passed = true;
+            if(**replayed < best_time)
+            {
+                best_config = all_configs[idx];
+                best_time   = **replayed;
+            }
+        }
+        if(n_replayed != 0)
+            MIOPEN_LOG_W("Resuming search from " << journal->GetPath() << ", " << n_replayed
+                                                 << " configs already measured, best "
+                                                 << best_time << ' ' << best_config);
     }
 
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    const auto total_threads   = GetTuningThreadsMax();
+    const auto measure_workers = GetTuningMeasureWorkers();
+    // Extra workers measure on their own streams of the pool, worker 0 uses the current stream.
+    if(measure_workers > 1)
+        profile_h.ReserveExtraStreamsInPool(measure_workers - 1);
+
+    struct CompiledConfig
     {
-        size_t n_current       = 0;
-        auto threads_remaining = total_threads;
-        while(true)
+        PerformanceConfig config;
+        ConvSolution solution;
+        PendingProposal proposal;
+    };
+
+    // Guards the search results and the statistics below.
+    std::mutex result_mutex;
+    size_t n_current = n_replayed;
+
+    const auto compile = [&](std::size_t) -> boost::optional<CompiledConfig> {
+        // Reports a failure if dropped, e.g. on exceptions, so the search does not wait for it.
+        auto proposal = search.Next();
+        if(!proposal)
+            return boost::none;
+        const auto& current_config = all_configs.at(proposal->Get().index);
+        auto current_solution      = ConvSolution{miopenStatusInternalError};
+        try
         {
-            if(n_current >= n_runs_total)
-                break;
-            MIOPEN_LOG_I2("Waiting for item in queue");
-            const auto kinder     = solution_queue.pop();
-            auto current_config   = std::get<0>(kinder);
-            auto current_solution = std::get<1>(kinder);
-
-            if(std::get<2>(kinder))
+            current_solution = s.GetSolution(context, problem, current_config);
+            for(const auto& kernel : current_solution.construction_params)
             {
-                threads_remaining--;
-                if(threads_remaining == 0)
-                    break;
-                else
-                {
+                if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
                     continue;
-                }
+                std::ignore =
+                    profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
             }
-
-            float elapsed_time = 0.0f;
-            int ret            = 0;
-            MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+        }
+        catch(const std::exception& e)
+        {
+            MIOPEN_LOG_E("Error: Exception encountered while compiling: " << e.what());
+            current_solution.status = miopenStatusInternalError;
+        }
+        return CompiledConfig{current_config, std::move(current_solution), std::move(*proposal)};
+    };
+
+    const auto measure = [&](std::size_t worker, CompiledConfig&& item) {
+        const auto& current_config   = item.config;
+        const auto& current_solution = item.solution;
+        if(worker != 0)
+            profile_h.SetStreamFromPool(worker);
+
+        float elapsed_time = 0.0f;
+        int ret            = 0;
+        float current_best = 0.0f;
+        size_t n_this      = 0;
+        {
+            std::lock_guard<std::mutex> lock(result_mutex);
+            current_best = best_time;
+            n_this       = n_current++;
+            MIOPEN_LOG_I2('#' << n_this << '/' << n_failed << '/' << n_runs_total << ' '
                               << current_config);
+        }
 
-            Invoker invoker;
+        Invoker invoker;
 
-            try
+        try
+        {
+            if(!current_solution.Succeeded())
+            {
+                ret = 1;
+                MIOPEN_LOG_E('#' << n_this << " (" << n_runs_total << ") Compilation failed");
+            }
+            else
             {
                 if(default_solution.workspace_sz != current_solution.workspace_sz)
                 {
                     ret = -2;
-                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                    MIOPEN_LOG_E('#' << n_this << " (" << n_runs_total << ") "
                                      << "Workspace size should not depend on PerformanceConfig: "
                                      << default_solution.workspace_sz
                                      << " != " << current_solution.workspace_sz);
@@ -455,99 +531,146 @@ auto GenericSearch(const Solver s,
                 invoker(profile_h, invoke_ctx);
                 elapsed_time = profile_h.GetKernelTime();
             }
-            catch(const std::exception& e)
+        }
+        catch(const std::exception& e)
+        {
+            MIOPEN_LOG_E("Error: Exception encountered : " << e.what());
+            ret = 1;
+        }
+        catch(...)
+        {
+            MIOPEN_LOG_E("Error: Unknown exception thrown.");
+            ret = 1;
+        }
+
+        MIOPEN_LOG_T("##"
+                     << "(n_current, n_failed, n_runs_total):  " << n_this << '/' << n_failed
+                     << '/' << n_runs_total << " elapsed_time: " << elapsed_time
+                     << ", best_time: " << current_best << ", " << current_config);
+
+        if(ret == 0 && item.proposal.Get().repeats != 0)
+        {
+            // Screening measurement requested by the search strategy. It only guides the
+            // strategy and can not select the result by itself.
+            try
             {
-                MIOPEN_LOG_E("Error: Exception encountered : " << e.what());
-                ret = 1;
+                for(std::size_t i = 1; i < item.proposal.Get().repeats; ++i)
+                {
+                    invoker(profile_h, invoke_ctx);
+                    elapsed_time += profile_h.GetKernelTime();
+                }
+                elapsed_time /= item.proposal.Get().repeats;
             }
             catch(...)
             {
-                MIOPEN_LOG_E("Error: Unknown exception thrown.");
                 ret = 1;
             }
-
-            MIOPEN_LOG_T("##"
-                         << "(n_current, n_failed, n_runs_total):  " << n_current << '/' << n_failed
-                         << '/' << n_runs_total << " elapsed_time: " << elapsed_time
-                         << ", best_time: " << best_time << ", " << current_config);
-
-            if(ret == 0)
+        }
+        else if(ret == 0)
+        {
+            // Smooth the jitter of measurements:
+            // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
+            // then re-run it 4 times more and compute average time,
+            // and decide using average of all 5 attempts vs. the best.
+            if(elapsed_time / current_best < 1.05f)
             {
-                // Smooth the jitter of measurements:
-                // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-                // then re-run it 4 times more and compute average time,
-                // and decide using average of all 5 attempts vs. the best.
-                if(elapsed_time / best_time < 1.05f)
-                {
-                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
-                                                          << " = " << (elapsed_time / best_time));
+                MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << current_best
+                                                      << " = " << (elapsed_time / current_best));
 
-                    try
+                try
+                {
+                    for(int i = 0; i < 4; ++i)
                     {
-                        for(int i = 0; i < 4; ++i)
-                        {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
-                        }
+                        invoker(profile_h, invoke_ctx);
+                        elapsed_time += profile_h.GetKernelTime();
                     }
-                    catch(...)
+                }
+                catch(...)
+                {
+                    ret = 1;
+                }
+
+                if(ret == 0)
+                {
+                    elapsed_time /= 5;
+                    std::lock_guard<std::mutex> lock(result_mutex);
+                    is_passed = true;
+                    if(elapsed_time < best_time)
                     {
-                        ret = 1;
+                        MIOPEN_LOG_I('#' << n_this << '/' << n_failed << '/' << n_runs_total
+                                         << ' ' << elapsed_time << " < " << best_time << ' '
+                                         << current_config);
+                        best_config = current_config;
+                        best_time   = elapsed_time;
+                        n_best      = n_this;
                     }
-
-                    if(ret == 0)
+                    else
                     {
-                        is_passed = true;
-                        elapsed_time /= 5;
-                        if(elapsed_time < best_time)
-                        {
-                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                             << ' ' << elapsed_time << " < " << best_time << ' '
-                                             << current_config);
-                            best_config = current_config;
-                            best_time   = elapsed_time;
-                            n_best      = n_current;
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_I2("Average is not better: " << elapsed_time
-                                                                    << " >= " << best_time);
-                        }
+                        MIOPEN_LOG_I2("Average is not better: " << elapsed_time
+                                                                << " >= " << best_time);
                     }
                 }
             }
+        }
 
-            // Banchmarked kernels will not be used anymore.
-            // Now we can delete Program objects that belong to OCL/HIP
-            // runtime and free the associated resources (memory, file handles...)
-            for(const auto& kernelInfo : current_solution.construction_params)
-                profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+        // Banchmarked kernels will not be used anymore.
+        // Now we can delete Program objects that belong to OCL/HIP
+        // runtime and free the associated resources (memory, file handles...)
+        for(const auto& kernelInfo : current_solution.construction_params)
+            profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
 
-            if(ret != 0)
-            {
-                MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                 << " Failed rc=" << ret);
-                ++n_failed;
-            }
-            heartbeat.Monitor(ret != 0,
-                              elapsed_time,
-                              n_current,
-                              best_time,
-                              n_failed,
-                              n_runs_total,
-                              current_config);
-            ++n_current;
+        const auto result = ret == 0 ? boost::make_optional(elapsed_time) : boost::none;
+        if(journal && item.proposal.Get().repeats == 0)
+            journal->Append(serialized[item.proposal.Get().index], result);
+        item.proposal.Report(result);
+
+        std::lock_guard<std::mutex> lock(result_mutex);
+        if(ret != 0)
+        {
+            MIOPEN_LOG_E('#' << n_this << " (" << n_runs_total << ") " << " Failed rc=" << ret);
+            ++n_failed;
         }
+        heartbeat.Monitor(ret != 0,
+                          elapsed_time,
+                          n_this,
+                          best_time,
+                          n_failed,
+                          n_runs_total,
+                          current_config);
+    };
+
+    // Compiled but not yet measured solutions are bounded, so compile threads can not
+    // run arbitrarily far ahead of the measurements.
+    const auto queue_capacity = 2 * std::max(total_threads, measure_workers);
+
+    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    {
+        RunTuningPipeline<CompiledConfig>(n_runs_total,
+                                          total_threads,
+                                          measure_workers,
+                                          queue_capacity,
+                                          GetTuningTimeMax(),
+                                          compile,
+                                          measure);
+        // Keep the journal if the time budget has cut the search short.
+        if(journal && search.IsComplete())
+            journal->Remove();
     }
     else
     {
+        RunTuningPipeline<CompiledConfig>(n_runs_total,
+                                          total_threads,
+                                          1,
+                                          queue_capacity,
+                                          GetTuningTimeMax(),
+                                          compile,
+                                          [&](std::size_t, CompiledConfig&& item) {
+                                              item.proposal.Report(boost::none);
+                                          });
         MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
                      "Running kernels on GPU is disabled. Search skipped");
     }
 
-    for(auto& agent : compile_agents)
-        agent.join();
-
     MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
 
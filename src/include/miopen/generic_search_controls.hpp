@@ -33,6 +33,8 @@ namespace solver {
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_ITERATIONS_MAX)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_TIME_MS_MAX)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TUNING_MEASURE_WORKERS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_SEARCH_STRATEGY)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
 
 } // namespace solver
@@ -30,6 +30,7 @@
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
 #include <miopen/invoker_cache.hpp>
+#include <miopen/invoker_table.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
@@ -42,11 +43,16 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
+#include <functional>
+#include <future>
 #include <ios>
 #include <sstream>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -71,6 +77,42 @@ using GemmKey = std::pair<std::string, std::string>;
 using rocblas_handle_ptr = MIOPEN_MANAGE_PTR(rocblas_handle, rocblas_destroy_handle);
 #endif
 
+/// Work using a handle on other threads. It is waited for before the handle is destroyed or
+/// moved, as it refers to the handle.
+class HandleTasks
+{
+public:
+    HandleTasks() = default;
+    HandleTasks(HandleTasks&& other) noexcept { other.Wait(); }
+    HandleTasks& operator=(HandleTasks&&) = delete;
+    ~HandleTasks() { Wait(); }
+
+    void Add(std::shared_future<void> task)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        tasks.erase(std::remove_if(tasks.begin(),
+                                   tasks.end(),
+                                   [](const auto& t) {
+                                       return t.wait_for(std::chrono::seconds{0}) ==
+                                              std::future_status::ready;
+                                   }),
+                    tasks.end());
+        tasks.push_back(std::move(task));
+    }
+
+    void Wait() noexcept
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        for(const auto& task : tasks)
+            task.wait();
+        tasks.clear();
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::shared_future<void>> tasks;
+};
+
 struct Handle : miopenHandle
 {
     friend struct TargetProperties;
@@ -110,10 +152,15 @@ struct Handle : miopenHandle
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config) const;
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config) const
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config) const
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        const auto kernels = this->GetKernelsImpl(algorithm, network_config);
+        auto ret           = std::vector<KernelInvoke>{};
+        ret.reserve(kernels.size());
+        for(const auto& k : kernels)
+            ret.push_back(this->Run(k));
+        return ret;
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
     {
@@ -127,8 +174,8 @@ struct Handle : miopenHandle
     }
 
     KernelInvoke Run(Kernel k) const;
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config) const;
+    std::vector<Kernel> GetKernelsImpl(const std::string& algorithm,
+                                       const std::string& network_config) const;
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
@@ -139,6 +186,13 @@ struct Handle : miopenHandle
     void ClearProgram(const std::string& program_name, const std::string& params) const;
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
 
+    /// Returns the code object of the program, which is built if it is not in the cache yet.
+    std::string GetProgramBinary(const std::string& program_name, const std::string& params) const;
+    /// Adds to the cache the program loaded from the code object.
+    void AddProgramBinary(const std::string& program_name,
+                          const std::string& params,
+                          const std::string& binary) const;
+
     void Finish() const;
     void Flush() const;
 
@@ -256,12 +310,32 @@ public:
         return invokers.GetFound1_0(config, *algo);
     }
 
+    /// Faster variants of the above for the hot paths, which do not need a NetworkConfig.
+    void RegisterInvoker(const Invoker& invoker, const ProblemKey& key, std::uint64_t solver)
+    {
+        invoker_table.Insert(key, solver, invoker);
+    }
+
+    boost::optional<const Invoker&> GetInvoker(const ProblemKey& key, std::uint64_t solver) const
+    {
+        return invoker_table.Find(key, solver);
+    }
+
     boost::optional<const std::string&> GetFound1_0SolverId(const NetworkConfig& config,
                                                             const AlgorithmName& algo) const
     {
         return invokers.GetFound1_0SolverId(config, algo);
     }
 
+    /// Runs task on another thread. The handle waits for it before it is destroyed, so the task
+    /// may keep using the handle.
+    std::shared_future<void> RunInBackground(std::function<void()> task)
+    {
+        auto future = std::async(std::launch::async, std::move(task)).share();
+        background_tasks.Add(future);
+        return future;
+    }
+
 #if MIOPEN_USE_ROCBLAS
     const rocblas_handle_ptr& rhandle() const;
 
@@ -271,6 +345,10 @@ private:
 private:
 #endif
     InvokerCache invokers;
+    InvokerTable invoker_table;
+    // Destroyed first, so the tasks finish while the rest of the handle is alive. The move
+    // constructor waits for them before moving the other members, which precede these.
+    HandleTasks background_tasks;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Handle& handle) { return handle.Print(os); }
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/invoker.hpp>
+#include <miopen/problem_key.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Flat open-addressing table of invokers keyed by a ProblemKey and a solver id. It lets the
+/// immediate mode and the primitive APIs find the invoker of a problem they have already seen
+/// without making its NetworkConfig. Entries are never removed, so returned invokers stay valid
+/// as long as the table. Can be used from several threads.
+class InvokerTable
+{
+public:
+    InvokerTable() = default;
+    // Moving a deque keeps its elements in place, so the slots stay valid.
+    InvokerTable(InvokerTable&& other) noexcept
+        : entries(std::move(other.entries)), slots(std::move(other.slots))
+    {
+    }
+
+    boost::optional<const Invoker&> Find(const ProblemKey& key, std::uint64_t id) const;
+    /// Does nothing if the key is not valid or an invoker is already registered for it.
+    void Insert(const ProblemKey& key, std::uint64_t id, const Invoker& invoker);
+
+private:
+    struct Entry
+    {
+        ProblemKey key;
+        std::uint64_t id;
+        Invoker invoker;
+    };
+
+    struct Slot
+    {
+        std::uint64_t hash = 0;
+        const Entry* entry = nullptr;
+    };
+
+    mutable std::shared_mutex mutex;
+    // Entries do not move once added, so slots may point to them.
+    std::deque<Entry> entries;
+    // Size is zero or a power of two, at most half of the slots are used.
+    std::vector<Slot> slots;
+
+    const Entry* FindEntry(const ProblemKey& key, std::uint64_t id, std::uint64_t hash) const;
+    void Place(const Entry& entry, std::uint64_t hash);
+};
+
+} // namespace miopen
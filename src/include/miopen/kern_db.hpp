@@ -32,15 +32,20 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
+#include <miopen/lz4.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
-#include <string>
 #include <chrono>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
 
 namespace boost {
 namespace filesystem {
@@ -49,9 +54,22 @@ class path;
 } // namespace boost
 
 namespace miopen {
+
+/// Compression of a kernel blob. It is stored with each record, so records written with
+/// different codecs can be read from the same database.
+enum class KernelCodec
+{
+    Bzip2 = 0,
+    Lz4   = 1,
+};
+
+/// Kernel records reference their code objects by the md5 hash in a separate table, so
+/// identical code objects built with different names or options are stored once. Records
+/// written before the table was added keep their code objects inline.
 struct KernelConfig
 {
     static std::string table_name() { return "kern_db"; }
+    static std::string blob_table_name() { return "kern_blob"; }
     std::string kernel_name;
     std::string kernel_args;
     std::string kernel_blob;
@@ -69,42 +87,132 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT NOT NULL DEFAULT 0"
+           << ",`last_access` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
-           << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
+           << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);"
+           << "CREATE INDEX IF NOT EXISTS "
+           << "`idx_" << KernelConfig::table_name() << "_hash` "
+           << "ON " << KernelConfig::table_name() << "(kernel_hash);"
+           << "CREATE TABLE IF NOT EXISTS `" << KernelConfig::blob_table_name() << "` ("
+           << "`id` INTEGER PRIMARY KEY ASC"
+           << ",`hash` TEXT NOT NULL UNIQUE"
+           << ",`kernel_blob` BLOB NOT NULL"
+           << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT NOT NULL"
+           << ");";
         return ss.str();
     }
-    std::string Where() const
+    static std::string Where() { return "(kernel_name = ?) AND (kernel_args = ?)"; }
+    void BindWhere(SQLite::Statement& stmt) const
     {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
+        stmt.BindText(1, kernel_name);
+        stmt.BindText(2, kernel_args);
     }
 };
 
 class KernDb : public SQLiteBase<KernDb>
 {
+    /// Codec of the records stored by this instance. compress_fn and decompress_fn implement
+    /// it, records of other codecs are decompressed by Decompress.
+    KernelCodec codec;
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    /// Databases created before the codec column was added hold only bzip2 records.
+    bool has_codec_column = true;
+    /// System databases may predate the shared code object table.
+    bool has_blob_table = true;
+    /// Budget of the file in bytes, 0 if unbounded. Exceeding it evicts the least recently used
+    /// records of user databases.
+    std::size_t size_limit = 0;
+
+    /// Statements are prepared once per connection and reused for every record. A prepared
+    /// statement carries its bindings and cursor, so it is used by one thread at a time.
+    struct StatementCache
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, SQLite::Statement> statements;
+        /// Serializes explicit transactions, which span the whole connection. Taken before
+        /// `mutex`.
+        std::mutex transaction_mutex;
+    };
+    std::unique_ptr<StatementCache> stmt_cache = std::make_unique<StatementCache>();
+
+    /// Resets the cached statement on scope exit, which also ends the implicit read
+    /// transaction of a SELECT that has not been stepped to completion.
+    class PreparedStatement
+    {
+        std::unique_lock<std::mutex> lock;
+        SQLite::Statement& stmt;
+
+    public:
+        PreparedStatement(std::unique_lock<std::mutex> lock_, SQLite::Statement& stmt_)
+            : lock(std::move(lock_)), stmt(stmt_)
+        {
+        }
+        PreparedStatement(const PreparedStatement&) = delete;
+        PreparedStatement& operator=(const PreparedStatement&) = delete;
+        ~PreparedStatement() { stmt.Reset(); }
+        SQLite::Statement& operator*() const { return stmt; }
+        SQLite::Statement* operator->() const { return &stmt; }
+    };
+
+    PreparedStatement Prepare(const std::string& query);
+
+    static std::string Decompress(KernelCodec codec, std::string blob, unsigned int size);
+
+    /// Records the use of a record of a user database. last_access is only refreshed hourly, so
+    /// that most loads do not write to the database.
+    void Touch(int64_t id, int64_t last_access);
+    /// Evicts the least recently used records of a user database until the file takes at most
+    /// three quarters of size_limit and vacuums it. Does nothing within size_limit.
+    void EnforceSizeLimit();
 
 public:
+    /// New records use the codec set by MIOPEN_KERN_DB_CODEC, LZ4 by default.
     KernDb(const std::string& filename_, bool is_system);
+    KernDb(const std::string& filename_, bool is_system_, KernelCodec codec_);
     // This constructor is only intended for testing
     KernDb(const std::string& filename_,
            bool is_system_,
            std::function<std::string(std::string, bool*)> compress_fn_,
-           std::function<std::string(std::string, unsigned int)> decompress_fn_);
+           std::function<std::string(std::string, unsigned int)> decompress_fn_,
+           KernelCodec codec_ = GetDefaultCodec());
+
+    /// Overrides the size budget set by MIOPEN_KERN_CACHE_SIZE_LIMIT_MB, 0 for unbounded.
+    void SetSizeLimit(std::size_t bytes) { size_limit = bytes; }
+
+    static KernelCodec GetDefaultCodec();
+    static std::function<std::string(std::string, bool*)> GetCompressor(KernelCodec codec);
+    static std::function<std::string(std::string, unsigned int)>
+    GetDecompressor(KernelCodec codec);
+
+    struct CompactionStats
+    {
+        /// Records whose inline code object was moved to the shared table.
+        std::size_t moved = 0;
+        /// Code objects no record refers to anymore.
+        std::size_t removed = 0;
+        /// Code objects compressed again with the requested codec.
+        std::size_t recompressed = 0;
+    };
+
+    /// Moves the inline code objects of old records to the shared table, drops the code objects
+    /// no record refers to, optionally recompresses the code objects with another codec and
+    /// vacuums the file. Only for user databases.
+    CompactionStats Compact(boost::optional<KernelCodec> recompress = boost::none);
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
         if(filename.empty())
             return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
-        auto rc   = stmt.Step(sql);
+        static const auto del_query =
+            "DELETE FROM " + T::table_name() + " WHERE " + T::Where() + ";";
+        auto stmt = Prepare(del_query);
+        problem_config.BindWhere(*stmt);
+        auto rc = stmt->Step(sql);
         if(rc == SQLITE_DONE)
             return true;
         else
@@ -119,33 +227,70 @@ public:
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
-        // only one result field
-        // assert one row
-        auto rc = stmt.Step(sql);
-        if(rc == SQLITE_ROW)
+        static const auto join =
+            "COALESCE(b.kernel_blob, k.kernel_blob), k.kernel_hash, "
+            "COALESCE(b.uncompressed_size, k.uncompressed_size), COALESCE(b.codec, k.codec)";
+        static const auto from = " FROM " + T::table_name() + " AS k LEFT JOIN " +
+                                 T::blob_table_name() + " AS b ON b.hash = k.kernel_hash WHERE " +
+                                 T::Where() + ";";
+        // User databases are upgraded to the latest layout on open.
+        static const auto select_query_user =
+            std::string{"SELECT "} + join + ", k.id, k.last_access" + from;
+        static const auto select_query = std::string{"SELECT "} + join + ", 0, 0" + from;
+        static const auto select_query_inline =
+            "SELECT kernel_blob, kernel_hash, uncompressed_size, codec, 0, 0 FROM " +
+            T::table_name() + " WHERE " + T::Where() + ";";
+        static const auto select_query_bz2 =
+            "SELECT kernel_blob, kernel_hash, uncompressed_size, 0, 0, 0 FROM " + T::table_name() +
+            " WHERE " + T::Where() + ";";
+
+        auto compressed_blob   = std::string{};
+        auto md5_hash          = std::string{};
+        auto uncompressed_size = int64_t{0};
+        auto record_codec      = KernelCodec::Bzip2;
+        auto id                = int64_t{0};
+        auto last_access       = int64_t{0};
         {
-            auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
-            auto uncompressed_size         = stmt.ColumnInt64(2);
-            std::string& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
-            {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
-            }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
-                MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
-            return decompressed_blob;
+            auto stmt = Prepare(!is_system          ? select_query_user
+                                : !has_codec_column ? select_query_bz2
+                                : has_blob_table    ? select_query
+                                                    : select_query_inline);
+            problem_config.BindWhere(*stmt);
+            // only one result field
+            // assert one row
+            auto rc = stmt->Step(sql);
+            if(rc == SQLITE_DONE)
+                return boost::none;
+            if(rc != SQLITE_ROW)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            compressed_blob   = stmt->ColumnBlob(0);
+            md5_hash          = stmt->ColumnText(1);
+            uncompressed_size = stmt->ColumnInt64(2);
+            record_codec      = static_cast<KernelCodec>(stmt->ColumnInt64(3));
+            id                = stmt->ColumnInt64(4);
+            last_access       = stmt->ColumnInt64(5);
         }
-        else if(rc == SQLITE_DONE)
+
+        if(compressed_blob.empty())
+        {
+            MIOPEN_LOG_W("Missing code object of " << problem_config.kernel_name);
             return boost::none;
-        else
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-        return boost::none;
+        }
+        if(!is_system)
+            Touch(id, last_access);
+
+        std::string& decompressed_blob = compressed_blob;
+        if(uncompressed_size != 0)
+        {
+            decompressed_blob =
+                record_codec == codec
+                    ? decompress_fn(compressed_blob, uncompressed_size)
+                    : Decompress(record_codec, compressed_blob, uncompressed_size);
+        }
+        auto new_md5 = md5(decompressed_blob);
+        if(new_md5 != md5_hash)
+            MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+        return decompressed_blob;
     }
 
     template <typename T>
@@ -153,31 +298,88 @@ public:
     {
         if(filename.empty())
             return false;
-        auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
-        auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
-        stmt.BindText(1, problem_config.kernel_name);
-        stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
-        {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
-        }
-        else
+        static const auto insert_query =
+            "INSERT OR REPLACE INTO " + T::table_name() +
+            "(kernel_name, kernel_args, kernel_blob, kernel_hash, uncompressed_size, codec, "
+            "last_access) VALUES(?, ?, ?, ?, ?, ?, ?);";
+        static const auto find_blob_query =
+            "SELECT 1 FROM " + T::blob_table_name() + " WHERE hash = ?;";
+        static const auto insert_blob_query =
+            "INSERT OR IGNORE INTO " + T::blob_table_name() +
+            "(hash, kernel_blob, uncompressed_size, codec) VALUES(?, ?, ?, ?);";
+
+        const auto md5_sum = md5(problem_config.kernel_blob);
+
+        const auto blob_exists = [&]() {
+            auto stmt = Prepare(find_blob_query);
+            stmt->BindText(1, md5_sum);
+            return stmt->Step(sql) == SQLITE_ROW;
+        };
+
+        auto is_compressed = false;
+        auto stored_blob   = std::string{};
+        auto stored_size   = std::int64_t{0};
+
+        const auto compress = [&]() {
+            bool success    = false;
+            auto compressed = compress_fn(problem_config.kernel_blob, &success);
+            stored_blob     = success ? std::move(compressed) : problem_config.kernel_blob;
+            stored_size     = success ? problem_config.kernel_blob.size() : 0;
+            is_compressed   = true;
+        };
+
+        // Identical code objects are compressed and stored only once. Compression is done
+        // before the transaction, so it does not block other writers.
+        if(!has_blob_table || !blob_exists())
+            compress();
+
         {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
+            // The record shall never refer to a code object which is not stored.
+            const auto lock = std::lock_guard<std::mutex>{stmt_cache->transaction_mutex};
+            sql.Exec("BEGIN IMMEDIATE;");
+            try
+            {
+                // The code object may have been evicted since the check above.
+                if(has_blob_table && !is_compressed && !blob_exists())
+                    compress();
+
+                if(has_blob_table && is_compressed)
+                {
+                    auto stmt = Prepare(insert_blob_query);
+                    stmt->BindText(1, md5_sum);
+                    stmt->BindBlob(2, stored_blob);
+                    stmt->BindInt64(3, stored_size);
+                    stmt->BindInt64(4, static_cast<int64_t>(codec));
+                    if(stmt->Step(sql) != SQLITE_DONE)
+                        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                }
+
+                {
+                    auto stmt = Prepare(insert_query);
+                    stmt->BindText(1, problem_config.kernel_name);
+                    stmt->BindText(2, problem_config.kernel_args);
+                    // Records referring to the shared table keep an empty inline code object.
+                    stmt->BindBlob(3, has_blob_table ? std::string{} : stored_blob);
+                    stmt->BindText(4, md5_sum);
+                    stmt->BindInt64(5, has_blob_table ? 0 : stored_size);
+                    stmt->BindInt64(6, static_cast<int64_t>(codec));
+                    stmt->BindInt64(7, std::time(nullptr));
+
+                    auto rc = stmt->Step(sql);
+                    if(rc != SQLITE_DONE)
+                        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                }
+                sql.Exec("COMMIT;");
+            }
+            catch(...)
+            {
+                sql.Exec("ROLLBACK;");
+                throw;
+            }
         }
-        stmt.BindText(4, md5_sum);
 
-        auto rc = stmt.Step(sql);
-        if(rc != SQLITE_DONE)
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        if(size_limit != 0 && !is_system)
+            EnforceSizeLimit();
         return true;
     }
 };
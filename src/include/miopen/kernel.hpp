@@ -27,16 +27,23 @@
 #define GUARD_MIOPEN_KERNEL_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <miopen/config.h>
 
 namespace miopen {
-std::string GetKernelSrc(std::string name);
-std::string GetKernelInc(std::string key);
-const std::string* GetKernelIncPtr(std::string key);
-std::vector<std::string> GetKernelIncList();
-std::vector<std::string> GetHipKernelIncList();
+/// The views point into the library's read-only data and are null-terminated.
+std::string_view GetKernelSrc(std::string_view name);
+std::string_view GetKernelInc(std::string_view key);
+const std::vector<std::string>& GetKernelIncList();
+const std::vector<std::string>& GetHipKernelIncList();
+/// Embedded HIP headers that the source includes, directly or through other embedded headers,
+/// sorted by name.
+std::vector<std::string> GetHipKernelIncDeps(std::string_view src);
+/// md5 of the names and contents of the headers that the embedded kernel includes.
+/// Computed once per kernel.
+std::string GetHipKernelIncHash(const std::string& program_name);
 } // namespace miopen
 
 #if MIOPEN_BACKEND_OPENCL
@@ -46,6 +46,11 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -55,14 +60,37 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * Can be used by several host threads at once. The entries are spread over shards by the hash of
+ * their key, and each shard has its own reader-writer lock, so lookups do not block each other.
  */
 class KernelCache
 {
 
 public:
-    using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using Key = std::pair<std::string, std::string>;
+
+    /// Key with its hash, which is computed once and then used both to pick the shard and by
+    /// the map of the shard.
+    struct HashedKey
+    {
+        Key key;
+        std::size_t hash;
+
+        HashedKey(Key key_) : key(std::move(key_)), hash(SimpleHash{}(key)) {}
+
+        bool operator==(const HashedKey& other) const
+        {
+            return hash == other.hash && key == other.key;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const HashedKey& key) const { return key.hash; }
+    };
+
+    using KernelMap  = std::unordered_map<HashedKey, std::vector<Kernel>, KeyHash>;
+    using ProgramMap = std::unordered_map<HashedKey, Program, KeyHash>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -80,10 +108,12 @@ public:
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    /// Returns a copy, as the cached vector may be changed by other threads.
+    std::vector<Kernel> GetKernels(const std::string& algorithm,
+                                   const std::string& network_config) const;
 
     bool HasProgram(const std::string& name, const std::string& params) const;
+    boost::optional<Program> GetProgram(const std::string& name, const std::string& params) const;
     void ClearProgram(const std::string& name, const std::string& params);
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
@@ -91,8 +121,21 @@ public:
     KernelCache();
 
 private:
-    KernelMap kernel_map;
-    ProgramMap program_map;
+    static constexpr std::size_t shard_count = 16;
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        KernelMap kernel_map;
+        ProgramMap program_map;
+    };
+
+    std::array<Shard, shard_count> shards;
+
+    Shard& GetShard(const HashedKey& key) { return shards[key.hash % shard_count]; }
+    const Shard& GetShard(const HashedKey& key) const { return shards[key.hash % shard_count]; }
+
+    boost::optional<Program> FindProgram(const HashedKey& key) const;
 };
 
 } // namespace miopen
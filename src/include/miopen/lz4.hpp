@@ -0,0 +1,46 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LZ4_HPP_
+#define GUARD_MIOPEN_LZ4_HPP_
+
+#include <string>
+
+namespace miopen {
+namespace lz4 {
+
+/// Compresses the data into a single LZ4 block. The block format is decoded byte by byte without
+/// entropy coding, which makes decompression several times faster than bzip2 at the cost of a
+/// lower compression ratio. Returns the data itself and sets *compressed to false when it does
+/// not shrink.
+std::string compress(const std::string& s, bool* compressed = nullptr);
+
+/// Decompresses an LZ4 block into at most size bytes.
+std::string decompress(const std::string& s, unsigned int size);
+
+} // namespace lz4
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LZ4_HPP_
@@ -26,34 +26,178 @@
 
 #pragma once
 
-#include <queue>
+#include <boost/optional.hpp>
+
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
+#include <utility>
+#include <vector>
+
+namespace miopen {
 
+/// Bounded multi-producer multi-consumer queue.
+///
+/// Items are moved in and out and are never copied, so move-only types can be queued.
+/// push() blocks while the queue is full, which gives producers back-pressure from slow
+/// consumers. close() marks the end of the stream: pushes fail from then on and pops return
+/// the remaining items and then boost::none, so no sentinel values are needed.
+///
+/// The storage is a ring buffer allocated once. Both ends share a mutex, but waiters are only
+/// notified when there is somebody to wake and consumers can take several items per lock with
+/// pop_batch(), so the lock is held for a few moves at a time.
 template <typename T>
-class ThreadSafeQueue
+class MPMCQueue
 {
-    std::mutex mutex;
-    std::condition_variable cond_var;
-    std::queue<T> queue;
-
 public:
-    void push(T&& item)
+    explicit MPMCQueue(std::size_t capacity) : slots(capacity > 0 ? capacity : 1) {}
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    /// Blocks while the queue is full. Returns false, leaving the item intact, if the queue
+    /// is or becomes closed.
+    bool push(T&& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++waiting_producers;
+        not_full.wait(lock, [&] { return closed_ || count < slots.size(); });
+        --waiting_producers;
+        return PushLocked(std::move(item), lock);
+    }
+
+    /// Returns false if the queue is full or closed.
+    bool try_push(T&& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(count == slots.size())
+            return false;
+        return PushLocked(std::move(item), lock);
+    }
+
+    /// Blocks until an item is available. Returns boost::none once the queue is closed
+    /// and empty.
+    boost::optional<T> pop()
     {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++waiting_consumers;
+        not_empty.wait(lock, [&] { return closed_ || count > 0; });
+        --waiting_consumers;
+        return PopLocked(lock);
+    }
+
+    /// Like pop(), but also returns boost::none if nothing arrives within the timeout.
+    template <class Rep, class Period>
+    boost::optional<T> pop_for(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++waiting_consumers;
+        not_empty.wait_for(lock, timeout, [&] { return closed_ || count > 0; });
+        --waiting_consumers;
+        return PopLocked(lock);
+    }
+
+    /// Returns boost::none if the queue is empty.
+    boost::optional<T> try_pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return PopLocked(lock);
+    }
+
+    /// Blocks like pop(), then appends up to max_items available items to out.
+    /// Returns the number of items appended, which is 0 only once the queue is closed
+    /// and empty.
+    std::size_t pop_batch(std::vector<T>& out, std::size_t max_items)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++waiting_consumers;
+        not_empty.wait(lock, [&] { return closed_ || count > 0; });
+        --waiting_consumers;
 
+        std::size_t n = 0;
+        for(; n < max_items && count > 0; ++n)
+            out.push_back(Take());
+        if(n > 0 && waiting_producers > 0)
+        {
+            lock.unlock();
+            not_full.notify_all();
+        }
+        return n;
+    }
+
+    /// Ends the stream and wakes up all waiting producers and consumers.
+    void close()
+    {
         {
             std::lock_guard<std::mutex> lock(mutex);
-            queue.push(item);
+            closed_ = true;
         }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
 
-        cond_var.notify_one();
+    bool closed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return closed_;
     }
-    T pop()
+
+    std::size_t size() const
     {
-        std::unique_lock<std::mutex> lock(mutex);
-        cond_var.wait(lock, [&] { return !queue.empty(); });
-        T ret = queue.front();
-        queue.pop();
-        return ret;
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+    }
+
+    std::size_t capacity() const { return slots.size(); }
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::vector<boost::optional<T>> slots;
+    std::size_t head              = 0;
+    std::size_t count             = 0;
+    std::size_t waiting_producers = 0;
+    std::size_t waiting_consumers = 0;
+    bool closed_                  = false;
+
+    bool PushLocked(T&& item, std::unique_lock<std::mutex>& lock)
+    {
+        if(closed_)
+            return false;
+        slots[(head + count) % slots.size()] = std::move(item);
+        ++count;
+        if(waiting_consumers > 0)
+        {
+            lock.unlock();
+            not_empty.notify_one();
+        }
+        return true;
+    }
+
+    boost::optional<T> PopLocked(std::unique_lock<std::mutex>& lock)
+    {
+        if(count == 0)
+            return boost::none;
+        boost::optional<T> item{Take()};
+        if(waiting_producers > 0)
+        {
+            lock.unlock();
+            not_full.notify_one();
+        }
+        return item;
+    }
+
+    T Take()
+    {
+        auto& slot = slots[head];
+        T item     = std::move(*slot);
+        slot       = boost::none;
+        head       = (head + 1) % slots.size();
+        --count;
+        return item;
     }
 };
+
+} // namespace miopen
@@ -47,6 +47,7 @@ struct AlgorithmName
     explicit AlgorithmName(const std::string& value_) : value(value_) {}
     operator std::string() const { return value; }
     std::string ToString() const { return value; }
+    const std::string& Value() const { return value; }
 
 private:
     std::string value;
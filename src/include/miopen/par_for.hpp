@@ -28,9 +28,15 @@
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <vector>
 
@@ -42,60 +48,240 @@
 
 namespace miopen {
 
-struct joinable_thread : std::thread
+/// A range of iterations shared by the threads that work on one par_for call. The threads
+/// take chunks of it from an atomic counter, so a thread that got cheap iterations takes more
+/// of them instead of idling while another one finishes a slow iteration.
+class par_for_job
 {
-    template <class... Xs>
-    joinable_thread(Xs&&... xs) : std::thread(std::forward<Xs>(xs)...) // NOLINT
+    std::function<void(std::size_t, std::size_t)> body;
+    std::size_t n;
+    std::size_t chunk;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+public:
+    par_for_job(std::function<void(std::size_t, std::size_t)> body_,
+                std::size_t n_,
+                std::size_t chunk_)
+        : body(std::move(body_)), n(n_), chunk(chunk_)
     {
     }
 
-    joinable_thread& operator=(joinable_thread&& other) = default;
-    joinable_thread(joinable_thread&& other)            = default;
+    /// Runs chunks until none is left to take.
+    void work()
+    {
+        for(;;)
+        {
+            const auto start = next.fetch_add(chunk, std::memory_order_relaxed);
+            if(start >= n)
+                return;
+            const auto last = std::min(n, start + chunk);
 
-    ~joinable_thread()
+            // After a failure the remaining chunks are only counted, not run.
+            if(!failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    body(start, last);
+                }
+                catch(...)
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    if(!failed.exchange(true))
+                        error = std::current_exception();
+                }
+            }
+
+            if(done.fetch_add(last - start, std::memory_order_acq_rel) + (last - start) == n)
+            {
+                const std::lock_guard<std::mutex> lock{mutex};
+                finished.notify_all();
+            }
+        }
+    }
+
+    /// Waits for the chunks taken by other threads and rethrows the first exception thrown by
+    /// the body.
+    void wait()
     {
-        if(this->joinable())
-            this->join();
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            finished.wait(lock, [&] { return done.load(std::memory_order_acquire) == n; });
+        }
+        if(error)
+            std::rethrow_exception(error);
     }
 };
 
-struct thread_factory
+/// Persistent workers for par_for. Every worker has its own queue of jobs to help with and
+/// steals from the others once it runs dry. The thread that calls par_for works on its own job
+/// too and never waits for a queued helper, so par_for may be nested in a par_for body.
+class thread_pool
 {
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
+    struct worker_queue
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<par_for_job>> jobs;
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::size_t pending = 0;
+    bool stop           = false;
+    std::atomic<std::size_t> next_queue{0};
+
+    bool try_pop(std::size_t self, std::shared_ptr<par_for_job>& job)
     {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
+        for(std::size_t i = 0; i < queues.size(); ++i)
+        {
+            auto& queue = *queues[(self + i) % queues.size()];
+            const std::lock_guard<std::mutex> lock{queue.mutex};
+            if(queue.jobs.empty())
+                continue;
+            // The own queue is used as a stack to stay with the most recent, likely nested,
+            // job; the other queues are stolen from the other end.
+            if(i == 0)
             {
-                f(i);
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
             }
-        });
-        work += grainsize;
-        return result;
+            else
+            {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void run(std::size_t self)
+    {
+        for(;;)
+        {
+            auto job = std::shared_ptr<par_for_job>{};
+            if(try_pop(self, job))
+            {
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    --pending;
+                }
+                job->work();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{mutex};
+            wakeup.wait(lock, [&] { return stop || pending > 0; });
+            if(stop && pending == 0)
+                return;
+        }
+    }
+
+public:
+    explicit thread_pool(std::size_t size)
+    {
+        for(std::size_t i = 0; i < size; ++i)
+            queues.push_back(std::make_unique<worker_queue>());
+        for(std::size_t i = 0; i < size; ++i)
+            workers.emplace_back([this, i] { run(i); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        wakeup.notify_all();
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    /// The caller of par_for is one of the threads running the job, so the pool has one worker
+    /// less than the hardware threads.
+    static thread_pool& get()
+    {
+        static thread_pool pool{std::max<std::size_t>(std::thread::hardware_concurrency(), 1) -
+                                1};
+        return pool;
+    }
+
+    std::size_t size() const { return workers.size(); }
+
+    /// Calls f(i) for every i in [0, n) on up to threadsize threads, the calling one included.
+    /// Iterations are handed out on demand in chunks of the given size. The first exception
+    /// thrown by f is rethrown once all the running iterations have finished; the iterations
+    /// not started yet are skipped.
+    template <class F>
+    void parallel_for(std::size_t n, std::size_t threadsize, std::size_t chunk, F f)
+    {
+        const auto chunks  = (n + chunk - 1) / chunk;
+        const auto helpers = std::min({threadsize, chunks, workers.size() + 1}) - 1;
+        if(n == 0 || helpers == 0)
+        {
+            for(std::size_t i = 0; i < n; i++)
+                f(i);
+            return;
+        }
+
+        auto job = std::make_shared<par_for_job>(
+            [&f](std::size_t start, std::size_t last) {
+                for(std::size_t i = start; i < last; i++)
+                    f(i);
+            },
+            n,
+            chunk);
+
+        // Counted first, so that a worker never takes a job that is not counted yet.
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            pending += helpers;
+        }
+        for(std::size_t i = 0; i < helpers; ++i)
+        {
+            const auto index = next_queue.fetch_add(1, std::memory_order_relaxed);
+            auto& queue      = *queues[index % queues.size()];
+            const std::lock_guard<std::mutex> lock{queue.mutex};
+            queue.jobs.push_back(job);
+        }
+        if(helpers == 1)
+            wakeup.notify_one();
+        else
+            wakeup.notify_all();
+
+        job->work();
+        job->wait();
     }
 };
 
 template <class F>
-void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+void par_for_impl(std::size_t n, std::size_t threadsize, std::size_t chunk, F f)
 {
     if(threadsize <= 1)
     {
         for(std::size_t i = 0; i < n; i++)
             f(i);
+        return;
     }
-    else
-    {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
-    }
+    thread_pool::get().parallel_for(n, threadsize, chunk, f);
+}
+
+template <class F>
+void par_for_impl(std::size_t n, std::size_t threadsize, F f)
+{
+    // Several chunks per thread balance uneven iterations, single iterations are used as long
+    // as there are few of them.
+    const auto chunk = std::max<std::size_t>(1, n / (std::max<std::size_t>(threadsize, 1) * 8));
+    par_for_impl(n, threadsize, chunk, f);
 }
 
 template <class F>
@@ -129,23 +315,20 @@ struct max_threads
     std::size_t n = 0;
 };
 
+/// Meant for a few heavy iterations, like kernel compilations, which are handed out one by one.
 template <class F>
 void par_for(std::size_t n, max_threads mt, F f)
 {
     const auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
-    par_for_impl(n, std::min(threadsize, n), f);
+    par_for_impl(n, std::min(threadsize, n), 1, f);
 }
 
+/// Kept for the callers that used to get their iterations round-robin. Iterations are now
+/// handed out on demand, like in par_for.
 template <class F>
 void par_for_strided(std::size_t n, max_threads mt, F f)
 {
-    auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
-    par_for_impl(threadsize, threadsize, [&](auto start) {
-        for(std::size_t i = start; i < n; i += threadsize)
-        {
-            f(i);
-        }
-    });
+    par_for(n, mt, f);
 }
 
 } // namespace miopen
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/miopen.h>
+
+#include <miopen/common.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/invoker.hpp>
+#include <miopen/object.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+struct Problem;
+
+namespace solver {
+struct Id;
+} // namespace solver
+
+/// A problem resolved once into everything required to run it: the invoker, the workspace size,
+/// the validated tensor descriptors and invoke parameters made of them. Running a plan binds the
+/// buffers to the stored parameters and calls the invoker, without looking the problem up or
+/// allocating. As the parameters are updated in place, a plan must not be run from several
+/// threads at the same time.
+struct Plan : miopenPlan
+{
+    enum class Kind
+    {
+        ConvolutionForward,
+        ConvolutionBackwardData,
+        ConvolutionBackwardWeights,
+        PoolingForward,
+        PoolingBackward,
+        BatchNormForwardInference,
+        BatchNormForwardTraining,
+        BatchNormBackward,
+    };
+
+    using Descriptors = std::unordered_map<miopenTensorArgumentId_t, TensorDescriptor>;
+
+    Plan(Kind kind_,
+         Invoker invoker_,
+         AnyInvokeParams params_,
+         std::size_t workspace_required_,
+         Descriptors descriptors_,
+         const std::vector<miopenTensorArgumentId_t>& required_);
+
+    // Parameters may point to the descriptors, which stay in place when the plan is moved.
+    Plan(const Plan&) = delete;
+    Plan(Plan&&)      = default;
+    Plan& operator=(const Plan&) = delete;
+    Plan& operator=(Plan&&) = delete;
+
+    Kind GetKind() const { return kind; }
+    std::size_t GetWorkspaceSize() const { return workspace_required; }
+    const TensorDescriptor& GetTensorDescriptor(miopenTensorArgumentId_t id) const;
+
+    void Run(const Handle& handle,
+             const miopenTensorArgument_t* arguments,
+             std::size_t count,
+             Data_t workspace,
+             std::size_t workspace_size);
+
+private:
+    Kind kind;
+    Invoker invoker;
+    AnyInvokeParams params;
+    std::size_t workspace_required;
+    Descriptors descriptors;
+    // Bit mask of the argument ids.
+    std::uint64_t required = 0;
+    bool swap_xy           = false;
+
+    void Bind(miopenTensorArgumentId_t id, Data_t buffer);
+
+    friend Plan MakeConvolutionPlan(Handle& handle,
+                                    const Problem& problem,
+                                    const solver::Id& solver,
+                                    const std::string& perf_cfg);
+};
+
+/// Makes a plan of the convolution problem. The solution immediate mode would use is taken when
+/// the solver id is not valid.
+Plan MakeConvolutionPlan(Handle& handle,
+                         const Problem& problem,
+                         const solver::Id& solver,
+                         const std::string& perf_cfg = "");
+
+} // namespace miopen
+
+inline std::ostream& operator<<(std::ostream& stream, const miopen::Plan& plan)
+{
+    stream << &plan;
+    return stream;
+}
+
+MIOPEN_DEFINE_OBJECT(miopenPlan, miopen::Plan);
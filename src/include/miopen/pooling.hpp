@@ -89,6 +89,7 @@ inline std::string get_pooling_index_type_max_name(miopenIndexType_t index_type)
 }
 
 struct Handle;
+struct Plan;
 struct TensorDescriptor;
 
 struct PoolingDescriptor : miopenPoolingDescriptor
@@ -161,6 +162,17 @@ struct PoolingDescriptor : miopenPoolingDescriptor
                             Data_t dx,
                             Data_t workSpace) const;
 
+    Plan MakeForwardPlan(Handle& handle,
+                         const TensorDescriptor& xDesc,
+                         const TensorDescriptor& yDesc,
+                         bool save_index) const;
+
+    Plan MakeBackwardPlan(Handle& handle,
+                          const TensorDescriptor& yDesc,
+                          const TensorDescriptor& dyDesc,
+                          const TensorDescriptor& xDesc,
+                          const TensorDescriptor& dxDesc) const;
+
     friend std::ostream& operator<<(std::ostream& stream, const PoolingDescriptor& x);
 
     std::vector<int> lens;
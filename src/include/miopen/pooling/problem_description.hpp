@@ -35,6 +35,7 @@
 namespace miopen {
 
 struct NetworkConfig;
+class ProblemKey;
 
 namespace pooling {
 
@@ -100,6 +101,7 @@ struct ProblemDescription
     }
 
     NetworkConfig MakeNetworkConfig() const;
+    ProblemKey MakeProblemKey() const;
 
 private:
     Direction direction;
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/problem.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Resolves the solutions immediate mode would pick for the problems and builds all of their
+/// kernels into the binary cache in parallel, so the first run of a network does not wait for
+/// the compiler. Kernels shared between problems are built once.
+/// Returns the number of distinct problems a solution was found for.
+std::size_t PrecompileProblems(Handle& handle, const std::vector<Problem>& problems);
+
+/// Makes convolution problems out of an MIOpenDriver command line like the ones in
+/// test/perf_models, one problem per direction enabled by --forw. Returns nothing for empty
+/// lines, comments and commands other than convolutions.
+std::vector<Problem> ParseDriverCommand(const std::string& line);
+
+std::vector<Problem> ParseDriverCommands(std::istream& stream);
+
+} // namespace miopen
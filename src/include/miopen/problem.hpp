@@ -94,6 +94,15 @@ struct Problem : miopenProblem
 
     void LogDriverCommand() const;
 
+    /// Finds solutions to several problems at once. Problems with the same network config are
+    /// found only once, the kernels of all of them are built in a single parallel pass before
+    /// the benchmarks, and the benchmarks share the tensor buffers. Returns the solutions of each
+    /// problem in the order of the problems.
+    friend std::vector<std::vector<Solution>> FindSolutions(Handle& handle,
+                                                            const std::vector<Problem>& problems,
+                                                            const FindOptions& options,
+                                                            std::size_t max_solutions);
+
     friend void to_json(nlohmann::json& j, const Problem& problem);
     friend void from_json(const nlohmann::json& j, Problem& problem);
 
@@ -114,6 +123,11 @@ private:
     void LogDriverCommand(const ConvolutionDescriptor& conv_desc) const;
 };
 
+std::vector<std::vector<Solution>> FindSolutions(Handle& handle,
+                                                 const std::vector<Problem>& problems,
+                                                 const FindOptions& options,
+                                                 std::size_t max_solutions);
+
 } // namespace miopen
 
 inline std::ostream& operator<<(std::ostream& stream, const miopen::Problem& problem)
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace miopen {
+
+/// Binary key of a problem, a cheap replacement of NetworkConfig on the hot paths. It is made of
+/// the raw parameters of the problem, so it tells apart at least the problems the network config
+/// does. The parameters are kept in a fixed size array and the hash is updated as they are
+/// added, so making and looking up a key does not allocate. A key with more parameters than fit
+/// is not valid and can not be used for lookups. Values only passed to the invoker, such as
+/// scaling factors, shall not be added: invokers registered under keys are never evicted.
+class ProblemKey
+{
+public:
+    static constexpr std::size_t capacity = 80;
+
+    /// The tag tells apart the keys of different kinds of problems.
+    explicit ProblemKey(char tag) { Add(tag); }
+
+    template <class T, std::enable_if_t<std::is_integral<T>{} || std::is_enum<T>{}, bool> = true>
+    ProblemKey& Add(T value)
+    {
+        return AddWord(static_cast<std::uint64_t>(value));
+    }
+
+    ProblemKey& Add(double value)
+    {
+        std::uint64_t bits;
+        static_assert(sizeof(bits) == sizeof(value), "");
+        std::memcpy(&bits, &value, sizeof(bits));
+        return AddWord(bits);
+    }
+
+    template <class T>
+    ProblemKey& Add(const std::vector<T>& values)
+    {
+        Add(values.size());
+        for(const auto& value : values)
+            Add(value);
+        return *this;
+    }
+
+    ProblemKey& Add(const std::string& value)
+    {
+        Add(value.size());
+        for(std::size_t i = 0; i < value.size(); i += sizeof(std::uint64_t))
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, value.data() + i, std::min(sizeof(word), value.size() - i));
+            AddWord(word);
+        }
+        return *this;
+    }
+
+    ProblemKey& Add(const TensorDescriptor& desc)
+    {
+        const auto& lens    = desc.GetLengths();
+        const auto& strides = desc.GetStrides();
+        AddWord(static_cast<std::uint64_t>(desc.GetType()) |
+                static_cast<std::uint64_t>(desc.GetLayout_t()) << 16 |
+                static_cast<std::uint64_t>(desc.GetVectorLength()) << 32 |
+                static_cast<std::uint64_t>(lens.size()) << 48);
+        for(const auto len : lens)
+            AddWord(len);
+        for(const auto stride : strides)
+            AddWord(stride);
+        return *this;
+    }
+
+    bool IsValid() const { return size <= capacity; }
+    std::uint64_t GetHash() const { return hash; }
+
+    friend bool operator==(const ProblemKey& left, const ProblemKey& right)
+    {
+        return left.hash == right.hash && left.size == right.size && left.IsValid() &&
+               std::equal(left.words.begin(), left.words.begin() + left.size, right.words.begin());
+    }
+
+    friend bool operator!=(const ProblemKey& left, const ProblemKey& right)
+    {
+        return !(left == right);
+    }
+
+private:
+    std::array<std::uint64_t, capacity> words{};
+    std::size_t size   = 0;
+    std::uint64_t hash = 0;
+
+    ProblemKey& AddWord(std::uint64_t word)
+    {
+        if(size < capacity)
+            words[size] = word;
+        ++size;
+        hash ^= word + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        return *this;
+    }
+};
+
+} // namespace miopen
@@ -30,10 +30,14 @@
 
 #include <boost/optional.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <unordered_map>
 
 // Value of one enables experimental write-through feature of RamDb.
 // It provides some performance gain in case of multi-threaded cache write operations.
@@ -128,14 +132,30 @@ private:
         std::string content;
     };
 
+    using Snapshot = std::unordered_map<std::string, CacheItem>;
+
     ramdb_clock::time_point file_read_time;
     std::map<std::string, CacheItem> cache;
 
+    // Immutable copy of the cache published for readers in snapshot mode. Readers only load
+    // the pointer. Writers only mark it stale, and the next read or the periodic refresh builds
+    // a new copy and swaps it in.
+    std::shared_ptr<const Snapshot> snapshot;
+    std::atomic<bool> snapshot_stale{false};
+    std::atomic<ramdb_clock::rep> snapshot_check_time{0};
+    std::mutex refresh_mutex;
+
     boost::optional<miopen::DbRecord> FindRecordUnsafe(const std::string& problem);
+    boost::optional<miopen::DbRecord> ParseItem(const std::string& problem,
+                                                const CacheItem& item) const;
 
     bool ValidateUnsafe();
     void Prefetch();
 
+    boost::optional<miopen::DbRecord> FindSnapshotRecord(const std::string& problem);
+    void RefreshSnapshot(bool wait);
+    void SyncSnapshotUnsafe();
+
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
     void UpdateCacheEntryUnsafe(const DbRecord& record);
 #endif
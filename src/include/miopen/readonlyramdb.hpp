@@ -30,6 +30,7 @@
 
 #include <boost/optional.hpp>
 
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <sstream>
@@ -40,6 +41,10 @@ namespace debug {
 extern bool& rordb_embed_fs_override();
 } // namespace debug
 
+class CompiledDb;
+
+/// Unless disabled by MIOPEN_DEBUG_COMPILED_SYSTEM_DB, a compiled form of the db file (see
+/// CompiledDb) is used instead of parsing the text file if it is available.
 class ReadonlyRamDb
 {
 public:
@@ -47,29 +52,7 @@ public:
 
     static ReadonlyRamDb& GetCached(const std::string& path, bool warn_if_unreadable);
 
-    boost::optional<DbRecord> FindRecord(const std::string& problem) const
-    {
-        MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
-
-        if(it == cache.end())
-            return boost::none;
-
-        auto record = DbRecord{problem};
-
-        MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
-
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: "
-                         << problem << " form file " << db_path << "#" << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
-            return boost::none;
-        }
-
-        return record;
-    }
+    boost::optional<DbRecord> FindRecord(const std::string& problem) const;
 
     template <class TProblem>
     boost::optional<DbRecord> FindRecord(const TProblem& problem) const
@@ -96,6 +79,7 @@ private:
 
     std::string db_path;
     std::unordered_map<std::string, CacheItem> cache;
+    std::shared_ptr<const CompiledDb> compiled;
 
     ReadonlyRamDb(const ReadonlyRamDb&) = default;
     ReadonlyRamDb(ReadonlyRamDb&&)      = default;
@@ -104,6 +88,8 @@ private:
 
     void Prefetch(bool warn_if_unreadable);
     void ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable);
+    bool LoadCompiled();
+    boost::optional<DbRecord> FindCompiledRecord(const std::string& problem) const;
 };
 
 } // namespace miopen
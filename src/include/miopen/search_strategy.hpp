@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Order in which GenericSearch visits the performance configs of a solver.
+enum class SearchStrategyKind
+{
+    Exhaustive,        ///< Random order over the whole space. This is the default.
+    SuccessiveHalving, ///< Cheap measurements of many configs, re-measuring the best ones.
+    Annealing,         ///< Simulated annealing over neighbouring configs.
+    Genetic,           ///< Crossover and mutation of the best measured configs.
+    Bayesian,          ///< Nearest-neighbour surrogate model of the kernel time.
+};
+
+std::ostream& operator<<(std::ostream& stream, SearchStrategyKind kind);
+
+/// Config to evaluate next.
+struct SearchProposal
+{
+    std::size_t index;
+    /// Number of kernel runs to average. 0 stands for the regular GenericSearch measurement;
+    /// only such measurements may select the final config.
+    std::size_t repeats;
+};
+
+/// Search strategies work on the indices of a config space. Each config is described by its
+/// serialized fields, which strategies use to find similar configs. Two configs are neighbours
+/// when they differ in a single field.
+class SearchStrategy
+{
+public:
+    virtual ~SearchStrategy() = default;
+    /// Returns the next config to evaluate, or none if it needs more observations first.
+    virtual boost::optional<SearchProposal> Propose() = 0;
+    /// Reports the result of a proposal, none if it has failed.
+    virtual void Observe(const SearchProposal& proposal, boost::optional<float> time) = 0;
+    /// True when no further proposals will be made.
+    virtual bool IsExhausted() const = 0;
+    /// Reports a result recorded by an earlier, interrupted search. The config will not be
+    /// proposed. Shall be called before the first proposal.
+    virtual void Replay(std::size_t index, boost::optional<float> time) = 0;
+};
+
+using ConfigFeatures = std::vector<std::string>;
+
+/// Splits a serialized performance config into its fields.
+ConfigFeatures GetConfigFeatures(const std::string& serialized);
+
+/// Returns `solver_default` unless MIOPEN_DEBUG_TUNING_SEARCH_STRATEGY overrides it with one of
+/// "exhaustive", "halving", "annealing", "genetic" or "bayesian".
+SearchStrategyKind GetTuningSearchStrategy(SearchStrategyKind solver_default);
+
+/// Number of evaluations of a non-exhaustive search over `n_configs` configs.
+std::size_t GetTuningSearchBudget(std::size_t n_configs);
+
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(SearchStrategyKind kind,
+                                                   std::vector<ConfigFeatures> space,
+                                                   std::size_t budget,
+                                                   unsigned seed);
+
+class TuningSearch;
+
+/// Proposal taken from a TuningSearch and not reported yet. If it is destroyed unreported, e.g.
+/// because compilation has thrown or the pipeline has dropped it, a failure is reported, so the
+/// search never waits for a result which is not going to come.
+class PendingProposal
+{
+public:
+    PendingProposal(TuningSearch& search_, const SearchProposal& proposal_);
+    PendingProposal(PendingProposal&& other) noexcept;
+    PendingProposal(const PendingProposal&) = delete;
+    PendingProposal& operator=(const PendingProposal&) = delete;
+    PendingProposal& operator=(PendingProposal&& other) noexcept;
+    ~PendingProposal();
+
+    const SearchProposal& Get() const { return proposal; }
+    /// Reports the result, none if the proposal has failed. Shall be called at most once.
+    void Report(boost::optional<float> time);
+
+private:
+    TuningSearch* search;
+    SearchProposal proposal;
+
+    void Drop() noexcept;
+};
+
+/// Thread-safe front end of a SearchStrategy for the compile and measurement threads.
+/// Next() waits while the strategy needs the results of proposals that are still in flight.
+class TuningSearch
+{
+public:
+    TuningSearch(std::unique_ptr<SearchStrategy> strategy_, std::size_t budget_);
+
+    boost::optional<PendingProposal> Next();
+    /// Replayed results count against the budget.
+    void Replay(std::size_t index, boost::optional<float> time);
+    /// True if the search has not been cut short, e.g. by the time budget.
+    bool IsComplete();
+
+private:
+    std::unique_ptr<SearchStrategy> strategy;
+    std::size_t budget;
+    std::size_t in_flight = 0;
+    std::mutex mutex;
+    std::condition_variable reported;
+
+    friend class PendingProposal;
+    void Report(const SearchProposal& proposal, boost::optional<float> time);
+};
+
+} // namespace solver
+} // namespace miopen
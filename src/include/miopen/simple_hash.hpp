@@ -35,7 +35,9 @@ struct SimpleHash
     size_t operator()(const std::pair<std::string, std::string>& p) const
     {
         using std::hash;
-        return (hash<std::string>()(p.first) ^ hash<std::string>()(p.second));
+        // Unlike a plain xor, does not map (a, b) and (b, a) or (a, a) and (b, b) to one value.
+        const auto seed = hash<std::string>()(p.first);
+        return seed ^ (hash<std::string>()(p.second) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
     }
 };
 
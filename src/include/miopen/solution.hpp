@@ -39,7 +39,9 @@
 #include <boost/optional.hpp>
 
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace miopen {
 
@@ -83,6 +85,7 @@ struct Solution : miopenSolution
     const solver::Id& GetSolver() const { return solver; }
     void SetSolver(solver::Id value) { solver = value; }
     void SetPerfConfig(const std::optional<std::string>& cfg) { perf_cfg = cfg; }
+    const std::optional<std::string>& GetPerfConfig() const { return perf_cfg; }
     const Problem& GetProblem() const { return problem; }
     void SetProblem(Problem value) { problem = std::move(value); }
 
@@ -93,15 +96,32 @@ struct Solution : miopenSolution
 
     void LogDriverCommand() const;
 
+    /// Stores the code objects of all kernels used by the solution, so it can be run from a
+    /// deserialized copy without compiling anything. The kernels are built if necessary.
+    void EmbedKernels(Handle& handle);
+    /// Adds the embedded code objects to the program cache of the handle. Code objects built
+    /// for another target are ignored.
+    void LoadKernels(const Handle& handle) const;
+    bool HasKernels() const { return !kernels.empty(); }
+
     friend void to_json(nlohmann::json& json, const Solution& solution);
     friend void from_json(const nlohmann::json& json, Solution& solution);
 
 private:
+    struct EmbeddedKernel
+    {
+        std::string program;
+        std::string options;
+        std::string binary;
+    };
+
     float time                     = 0;
     std::size_t workspace_required = 0;
     solver::Id solver;
     Problem problem;
     std::optional<std::string> perf_cfg = std::nullopt;
+    std::string kernels_target;
+    std::vector<EmbeddedKernel> kernels;
 
     void RunImpl(Handle& handle,
                  const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
@@ -111,6 +131,7 @@ private:
 
     static Problem Transpose(const Problem& problem, RunInput* x, const RunInput& w, RunInput* y);
     void LogDriverCommand(const ConvolutionDescriptor& conv_desc) const;
+    void EmbedKernels(Handle& handle, const ConvolutionDescriptor& conv_desc);
 };
 
 } // namespace miopen
@@ -50,6 +50,7 @@
 
 #include <string>
 #include <chrono>
+#include <map>
 #include <unordered_map>
 
 namespace boost {
@@ -193,6 +194,9 @@ public:
         int BindText(int idx, const std::string& txt);
         int BindBlob(int idx, const std::string& blob);
         int BindInt64(int idx, int64_t);
+        /// Returns the statement to its initial state and clears all bindings, so that it
+        /// can be executed again without being re-prepared.
+        void Reset();
     };
 
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
@@ -489,6 +493,7 @@ public:
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
                 MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
         }
+        MergeDeferred(BatchKey(problem_config.table_name(), values), rec);
         if(rec.GetSize() == 0)
             return boost::none;
         else
@@ -507,6 +512,7 @@ public:
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
+        DropDeferred(BatchKey(problem_config.table_name(), values), &id);
         // clang-format off
         auto query =
             "DELETE FROM perf_db "
@@ -515,6 +521,7 @@ public:
             + clause + " ) )"
             "AND solver == '" +  id + "' ;";
         // clang-format on
+        const std::lock_guard<std::mutex> lock{batch->transaction_mutex};
         auto stmt = SQLite::Statement{sql, query, values};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
@@ -535,45 +542,34 @@ public:
     {
         if(dbInvalid)
             return boost::none;
+        PendingUpdate update;
         // UPSERT the value
-        {
-            std::string clause;
-            std::vector<std::string> vals;
-            std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt              = SQLite::Statement{sql, clause, vals};
-            auto rc                = stmt.Step(sql);
-            if(rc != SQLITE_DONE)
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "Failed to insert config: " + sql.ErrorMessage());
-            auto cnt = sql.Changes();
-            MIOPEN_LOG_I2(cnt << " rows updated");
-        }
+        std::tie(update.config_query, update.config_values) = problem_config.InsertQuery();
 
         // UPSERT perf values
         {
             std::ostringstream params;
             values.Serialize(params);
             std::string clause;
-            std::vector<std::string> vals(2);
-            std::tie(clause, vals) = problem_config.WhereClause();
+            std::tie(clause, update.perf_values) = problem_config.WhereClause();
+            const auto key = BatchKey(problem_config.table_name(), update.perf_values);
 
             // clang-format off
-            std::string query =
+            update.perf_query =
                 "INSERT OR REPLACE INTO "
                 "perf_db(config, solver, params) "
                 "VALUES("
                 "(SELECT id FROM " + problem_config.table_name() +  " "
                 "WHERE ( " + clause + " ) ) , ? , ?);";
             // clang-format on
-            vals.push_back(id);
-            vals.push_back(params.str());
-            auto stmt = SQLite::Statement{sql, query, vals};
-            auto rc   = stmt.Step(sql);
-            if(rc != SQLITE_DONE)
+            update.perf_values.push_back(id);
+            update.perf_values.push_back(params.str());
+
+            if(!DeferUpdate(key, id, update))
             {
-                MIOPEN_LOG_E("Failed to insert performance record in the database: " +
-                             sql.ErrorMessage());
-                return boost::none;
+                const std::lock_guard<std::mutex> lock{batch->transaction_mutex};
+                if(!ExecuteUpdate(update))
+                    return boost::none;
             }
         }
         DbRecord record;
@@ -600,6 +596,7 @@ public:
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
+        DropDeferred(BatchKey(problem_config.table_name(), values), nullptr);
         // clang-format off
         auto query =
             "DELETE FROM perf_db "
@@ -607,6 +604,7 @@ public:
             "SELECT id FROM config WHERE ( "
             + clause + " ))";
         // clang-format on
+        const std::lock_guard<std::mutex> lock{batch->transaction_mutex};
         auto stmt = SQLite::Statement{sql, query, values};
         auto rc   = stmt.Step(sql);
         if(rc != SQLITE_DONE)
@@ -635,5 +633,53 @@ public:
             return false;
         return record->GetValues(id, values);
     }
+
+    /// While at least one session of the calling thread is open, UpdateUnsafe() and
+    /// StoreRecordUnsafe() called by the thread only queue the records. When its last session
+    /// ends, all of them are written in a single transaction. Reads made by the thread in the
+    /// meantime see the queued records. Other threads neither see nor commit them.
+    DbWriteSession BeginWriteSession();
+
+private:
+    struct PendingUpdate
+    {
+        std::string config_query;
+        std::vector<std::string> config_values;
+        std::string perf_query;
+        std::vector<std::string> perf_values;
+    };
+
+    // config key -> solver id -> update
+    using PendingUpdates = std::map<std::string, std::map<std::string, PendingUpdate>>;
+
+    struct ThreadBatch
+    {
+        std::size_t sessions = 0;
+        PendingUpdates updates;
+    };
+
+    struct WriteBatch
+    {
+        std::mutex mutex;
+        std::map<std::thread::id, ThreadBatch> threads;
+        /// Serializes the transaction of a session with the other writes to the connection,
+        /// which would otherwise run inside of it. Taken before `mutex`.
+        std::mutex transaction_mutex;
+    };
+
+    std::unique_ptr<WriteBatch> batch = std::make_unique<WriteBatch>();
+
+    static std::string BatchKey(const std::string& table, const std::vector<std::string>& values)
+    {
+        return table + ":" + JoinStrings(values, ",");
+    }
+
+    bool ExecuteUpdate(const PendingUpdate& update);
+    /// Returns false if there is no open session and the update has to be executed now.
+    bool DeferUpdate(const std::string& key, const std::string& id, const PendingUpdate& update);
+    void MergeDeferred(const std::string& key, DbRecord& record);
+    /// Drops queued updates of the solver ID or, if ID is nullptr, of the whole config.
+    void DropDeferred(const std::string& key, const std::string* id);
+    void EndWriteSession(std::thread::id thread);
 };
 } // namespace miopen
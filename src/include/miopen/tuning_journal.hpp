@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+namespace solver {
+
+/// Append-only record of the measurements of one tuning search, so that a search interrupted
+/// by the time budget or by termination of the process can be resumed instead of repeated.
+///
+/// The file starts with the key of the search, followed by one line per measured config:
+/// "<serialized config>=<time>", or "<serialized config>=failed". Lines are flushed as they are
+/// written, and a truncated last line is ignored when the journal is loaded.
+class TuningJournal
+{
+public:
+    TuningJournal(boost::filesystem::path path_, std::string key_);
+
+    /// Returns nullptr if journals are disabled. The file is named after a hash of the key and
+    /// lives in the user db directory.
+    static std::unique_ptr<TuningJournal> Open(const std::string& key);
+
+    /// Returns the recorded result of the config, none if its measurement has failed.
+    boost::optional<boost::optional<float>> Find(const std::string& config) const;
+    std::size_t Size() const { return entries.size(); }
+
+    void Append(const std::string& config, boost::optional<float> time);
+    /// Deletes the file once the search it belongs to has completed.
+    void Remove();
+
+    const boost::filesystem::path& GetPath() const { return path; }
+
+private:
+    boost::filesystem::path path;
+    std::string key;
+    std::unordered_map<std::string, boost::optional<float>> entries;
+    std::ofstream file;
+    bool is_resumed = false;
+    std::mutex mutex;
+};
+
+} // namespace solver
+} // namespace miopen
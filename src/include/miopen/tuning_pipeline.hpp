@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/logger.hpp>
+#include <miopen/mt_queue.hpp>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Compile/measure pipeline used by the generic search.
+///
+/// `compile(i)` is called for each index i in [0, n_items) by `compile_threads` threads and
+/// returns a boost::optional<Item>; an empty result stops the calling compile thread. Items
+/// are moved to `measure(worker, item)` running on `measure_workers` threads through a queue
+/// of `queue_capacity` entries, so compilation can not run further ahead of measurement than
+/// that. Worker 0 runs on the calling thread. Compile threads stop taking new indices once
+/// `time_budget` is exhausted; items compiled so far are still measured. The last compile
+/// thread to finish closes the queue.
+///
+/// Neither functor is expected to throw. If one does, the item is dropped (compile) or the
+/// first exception is rethrown after the pipeline has been drained and all threads joined.
+/// Drained items are destroyed without being measured, so items which have to be accounted
+/// for, like PendingProposal, shall do that in their destructors.
+template <class Item, class Compile, class Measure>
+void RunTuningPipeline(std::size_t n_items,
+                       std::size_t compile_threads,
+                       std::size_t measure_workers,
+                       std::size_t queue_capacity,
+                       std::chrono::milliseconds time_budget,
+                       const Compile& compile,
+                       const Measure& measure)
+{
+    compile_threads = std::max<std::size_t>(compile_threads, 1);
+    measure_workers = std::max<std::size_t>(measure_workers, 1);
+
+    MPMCQueue<Item> queue(queue_capacity);
+    std::atomic<std::size_t> next_item{0};
+    std::atomic<std::size_t> running_compile_threads{compile_threads};
+    const auto start_time = std::chrono::steady_clock::now();
+
+    const auto compile_items = [&](std::size_t thread_index) {
+        while(true)
+        {
+            if(std::chrono::steady_clock::now() - start_time > time_budget)
+            {
+                MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
+                return;
+            }
+            const auto idx = next_item++;
+            if(idx >= n_items)
+                break;
+            try
+            {
+                auto item = compile(idx);
+                if(!item)
+                    break;
+                if(!queue.push(std::move(*item)))
+                    break;
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Thread: " << thread_index << " Item #" << idx << ": " << ex.what());
+            }
+        }
+        MIOPEN_LOG_I2("Thread: " << thread_index << " Done, completed tuning");
+    };
+
+    const auto compile_agent = [&](std::size_t thread_index) {
+        compile_items(thread_index);
+        if(--running_compile_threads == 0)
+            queue.close();
+    };
+
+    std::vector<std::thread> compile_agents;
+    compile_agents.reserve(compile_threads);
+    for(std::size_t idx = 0; idx < compile_threads; ++idx)
+        compile_agents.emplace_back(compile_agent, idx);
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    const auto measure_agent = [&](std::size_t worker) {
+        // Keep draining after a failure, otherwise compile threads may block on a full queue.
+        bool failed = false;
+        while(auto item = queue.pop())
+        {
+            if(failed)
+                continue;
+            try
+            {
+                measure(worker, std::move(*item));
+            }
+            catch(...)
+            {
+                failed = true;
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if(!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> measure_agents;
+    measure_agents.reserve(measure_workers - 1);
+    for(std::size_t idx = 1; idx < measure_workers; ++idx)
+        measure_agents.emplace_back(measure_agent, idx);
+    measure_agent(0);
+
+    for(auto& agent : measure_agents)
+        agent.join();
+    for(auto& agent : compile_agents)
+        agent.join();
+
+    if(error)
+        std::rethrow_exception(error);
+}
+
+} // namespace solver
+} // namespace miopen
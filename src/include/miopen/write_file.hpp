@@ -2,18 +2,20 @@
 #define GUARD_MLOPEN_WRITE_FILE_HPP
 
 #include <boost/filesystem.hpp>
+#include <miopen/errors.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <fstream>
+#include <string_view>
 
 namespace miopen {
 
 using FilePtr = MIOPEN_MANAGE_PTR(FILE*, std::fclose);
 
-inline void WriteFile(const std::string& content, const boost::filesystem::path& name)
+inline void WriteFile(std::string_view content, const boost::filesystem::path& name)
 {
     // std::cerr << "Write file: " << name << std::endl;
     const FilePtr f{std::fopen(name.string().c_str(), "w")};
-    if(std::fwrite(content.c_str(), 1, content.size(), f.get()) != content.size())
+    if(std::fwrite(content.data(), 1, content.size(), f.get()) != content.size())
         MIOPEN_THROW("Failed to write to file");
 }
 
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/invoker_table.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace miopen {
+
+namespace {
+std::uint64_t Hash(const ProblemKey& key, std::uint64_t id)
+{
+    const auto seed = key.GetHash();
+    return seed ^ (id + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+} // namespace
+
+boost::optional<const Invoker&> InvokerTable::Find(const ProblemKey& key, std::uint64_t id) const
+{
+    if(!key.IsValid())
+        return boost::none;
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const auto entry = FindEntry(key, id, Hash(key, id));
+    if(entry == nullptr)
+        return boost::none;
+    return entry->invoker;
+}
+
+void InvokerTable::Insert(const ProblemKey& key, std::uint64_t id, const Invoker& invoker)
+{
+    if(!key.IsValid())
+        return;
+
+    const auto hash = Hash(key, id);
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if(FindEntry(key, id, hash) != nullptr)
+        return;
+
+    if(2 * (entries.size() + 1) > slots.size())
+    {
+        const auto old_slots = std::exchange(
+            slots, std::vector<Slot>(std::max<std::size_t>(16, slots.size() * 2)));
+        for(const auto& slot : old_slots)
+            if(slot.entry != nullptr)
+                Place(*slot.entry, slot.hash);
+    }
+
+    entries.push_back({key, id, invoker});
+    Place(entries.back(), hash);
+}
+
+const InvokerTable::Entry*
+InvokerTable::FindEntry(const ProblemKey& key, std::uint64_t id, std::uint64_t hash) const
+{
+    if(slots.empty())
+        return nullptr;
+
+    const auto mask = slots.size() - 1;
+    for(auto i = hash & mask;; i = (i + 1) & mask)
+    {
+        const auto& slot = slots[i];
+        if(slot.entry == nullptr)
+            return nullptr;
+        if(slot.hash == hash && slot.entry->id == id && slot.entry->key == key)
+            return slot.entry;
+    }
+}
+
+void InvokerTable::Place(const Entry& entry, std::uint64_t hash)
+{
+    const auto mask = slots.size() - 1;
+    auto i          = hash & mask;
+    while(slots[i].entry != nullptr)
+        i = (i + 1) & mask;
+    slots[i] = Slot{hash, &entry};
+}
+
+} // namespace miopen
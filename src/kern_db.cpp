@@ -25,17 +25,82 @@
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
 
+#include <miopen/binary_cache.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERN_DB_CODEC)
+
 namespace miopen {
+
+KernelCodec KernDb::GetDefaultCodec()
+{
+    static const auto codec = []() {
+        const char* const env = GetStringEnv(MIOPEN_KERN_DB_CODEC{});
+        const auto name       = std::string{env != nullptr ? env : "lz4"};
+        if(name == "bz2")
+            return KernelCodec::Bzip2;
+        if(name != "lz4")
+            MIOPEN_LOG_W("Unknown MIOPEN_KERN_DB_CODEC: " << name << ", using lz4");
+        return KernelCodec::Lz4;
+    }();
+    return codec;
+}
+
+std::function<std::string(std::string, bool*)> KernDb::GetCompressor(KernelCodec codec)
+{
+    switch(codec)
+    {
+    case KernelCodec::Bzip2: return compress;
+    case KernelCodec::Lz4: return lz4::compress;
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown kernel codec");
+}
+
+std::function<std::string(std::string, unsigned int)> KernDb::GetDecompressor(KernelCodec codec)
+{
+    switch(codec)
+    {
+    case KernelCodec::Bzip2: return decompress;
+    case KernelCodec::Lz4: return lz4::decompress;
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown kernel codec");
+}
+
+std::string KernDb::Decompress(KernelCodec codec, std::string blob, unsigned int size)
+{
+    switch(codec)
+    {
+    case KernelCodec::Bzip2: return decompress(std::move(blob), size);
+    case KernelCodec::Lz4: return lz4::decompress(blob, size);
+    }
+    MIOPEN_THROW(miopenStatusInternalError,
+                 "Unknown kernel codec: " + std::to_string(static_cast<int>(codec)));
+}
+
 KernDb::KernDb(const std::string& filename_, bool is_system_)
-    : KernDb(filename_, is_system_, compress, decompress)
+    : KernDb(filename_, is_system_, GetDefaultCodec())
+{
+}
+
+KernDb::KernDb(const std::string& filename_, bool is_system_, KernelCodec codec_)
+    : KernDb(filename_, is_system_, GetCompressor(codec_), GetDecompressor(codec_), codec_)
 {
 }
 
 KernDb::KernDb(const std::string& filename_,
                bool is_system_,
                std::function<std::string(std::string, bool*)> compress_fn_,
-               std::function<std::string(std::string, unsigned int)> decompress_fn_)
-    : SQLiteBase(filename_, is_system_), compress_fn(compress_fn_), decompress_fn(decompress_fn_)
+               std::function<std::string(std::string, unsigned int)> decompress_fn_,
+               KernelCodec codec_)
+    : SQLiteBase(filename_, is_system_),
+      codec(codec_),
+      compress_fn(compress_fn_),
+      decompress_fn(decompress_fn_)
 {
     if(!is_system && DisableUserDbFileIO)
         return;
@@ -61,7 +126,220 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
     }
+
+    has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    if(!has_codec_column && !is_system)
+    {
+        // Records of the databases created before the codec column are all bzip2 compressed.
+        sql.Exec("ALTER TABLE `" + KernelConfig::table_name() +
+                 "` ADD COLUMN `codec` INT NOT NULL DEFAULT 0;");
+        has_codec_column = true;
+        MIOPEN_LOG_I2("Added the codec column to " << filename);
+    }
+
+    has_blob_table = CheckTableColumns(KernelConfig::blob_table_name(), {"hash"});
+
+    if(!is_system)
+    {
+        if(!CheckTableColumns(KernelConfig::table_name(), {"last_access"}))
+        {
+            sql.Exec("ALTER TABLE `" + KernelConfig::table_name() +
+                     "` ADD COLUMN `last_access` INT NOT NULL DEFAULT 0;");
+            MIOPEN_LOG_I2("Added the last_access column to " << filename);
+        }
+        size_limit = GetCacheSizeLimit();
+    }
+}
+
+void KernDb::Touch(int64_t id, int64_t last_access)
+{
+    const auto now = static_cast<int64_t>(std::time(nullptr));
+    if(now - last_access < 60 * 60)
+        return;
+
+    static const auto update_query =
+        "UPDATE " + KernelConfig::table_name() + " SET last_access = ? WHERE id = ?;";
+    auto stmt = Prepare(update_query);
+    stmt->BindInt64(1, now);
+    stmt->BindInt64(2, id);
+    // Losing the access time to a concurrent writer only makes the record look older.
+    if(stmt->Step(sql) != SQLITE_DONE)
+        MIOPEN_LOG_W("Unable to update the access time in " << filename << ": "
+                                                            << sql.ErrorMessage());
+}
+
+void KernDb::EnforceSizeLimit()
+{
+    const auto transaction_lock = std::lock_guard<std::mutex>{stmt_cache->transaction_mutex};
+    const auto lock             = std::lock_guard<std::mutex>{stmt_cache->mutex};
+
+    const auto get_size = [&]() {
+        const auto page_count = sql.Exec("PRAGMA page_count;").front().at("page_count");
+        const auto page_size  = sql.Exec("PRAGMA page_size;").front().at("page_size");
+        return std::stoull(page_count) * std::stoull(page_size);
+    };
+
+    auto size = get_size();
+    if(size <= size_limit)
+        return;
+
+    const auto table      = KernelConfig::table_name();
+    const auto blob_table = KernelConfig::blob_table_name();
+    const auto target     = size_limit / 4 * 3;
+    auto evicted          = std::size_t{0};
+
+    try
+    {
+        while(size > target)
+        {
+            sql.Exec("BEGIN IMMEDIATE;");
+            try
+            {
+                const auto records =
+                    std::stoull(sql.Exec("SELECT COUNT(*) AS n FROM `" + table + "`;")
+                                    .front()
+                                    .at("n"));
+                if(records == 0)
+                {
+                    sql.Exec("ROLLBACK;");
+                    break;
+                }
+
+                // Records are evicted in proportion to the excess, so that the file is vacuumed
+                // only a few times.
+                const auto count = std::max<std::size_t>(1, records * (size - target) / size);
+                sql.Exec("DELETE FROM `" + table + "` WHERE id IN (SELECT id FROM `" + table +
+                         "` ORDER BY last_access ASC, id ASC LIMIT " + std::to_string(count) +
+                         ");");
+                evicted += sql.Changes();
+                if(has_blob_table)
+                    sql.Exec("DELETE FROM `" + blob_table +
+                             "` WHERE hash NOT IN (SELECT kernel_hash FROM `" + table + "`);");
+                sql.Exec("COMMIT;");
+            }
+            catch(...)
+            {
+                sql.Exec("ROLLBACK;");
+                throw;
+            }
+
+            sql.Exec("VACUUM;");
+            size = get_size();
+        }
+    }
+    catch(const Exception& ex)
+    {
+        // The record is already stored, the eviction is retried on the next store.
+        MIOPEN_LOG_W("Unable to evict records from " << filename << ": " << ex.what());
+    }
+
+    MIOPEN_LOG_I("Evicted " << evicted << " records from " << filename << ", " << size
+                            << " bytes left");
+}
+
+KernDb::CompactionStats KernDb::Compact(boost::optional<KernelCodec> recompress)
+{
+    if(is_system || dbInvalid || !has_blob_table)
+        MIOPEN_THROW(miopenStatusInvalidValue, "Only user kernel databases can be compacted");
+
+    const auto table      = KernelConfig::table_name();
+    const auto blob_table = KernelConfig::blob_table_name();
+    auto stats            = CompactionStats{};
+
+    // The statement cache is locked for the whole compaction, so no record is read or stored in
+    // the middle of it.
+    const auto transaction_lock = std::lock_guard<std::mutex>{stmt_cache->transaction_mutex};
+    const auto lock             = std::lock_guard<std::mutex>{stmt_cache->mutex};
+    sql.Exec("BEGIN IMMEDIATE;");
+
+    try
+    {
+        sql.Exec("INSERT OR IGNORE INTO `" + blob_table +
+                 "` (hash, kernel_blob, uncompressed_size, codec) "
+                 "SELECT kernel_hash, kernel_blob, uncompressed_size, codec FROM `" +
+                 table + "` WHERE length(kernel_blob) > 0;");
+        sql.Exec("UPDATE `" + table +
+                 "` SET kernel_blob = X'', uncompressed_size = 0, codec = 0 "
+                 "WHERE length(kernel_blob) > 0;");
+        stats.moved = sql.Changes();
+
+        sql.Exec("DELETE FROM `" + blob_table + "` WHERE hash NOT IN (SELECT kernel_hash FROM `" +
+                 table + "`);");
+        stats.removed = sql.Changes();
+
+        if(recompress)
+        {
+            auto hashes = std::vector<std::string>{};
+            {
+                auto stmt = SQLite::Statement{
+                    sql, "SELECT hash FROM `" + blob_table + "` WHERE codec != ?;"};
+                stmt.BindInt64(1, static_cast<int64_t>(*recompress));
+                while(stmt.Step(sql) == SQLITE_ROW)
+                    hashes.push_back(stmt.ColumnText(0));
+            }
+
+            const auto compressor = GetCompressor(*recompress);
+            auto select           = SQLite::Statement{
+                sql,
+                "SELECT kernel_blob, uncompressed_size, codec FROM `" + blob_table +
+                    "` WHERE hash = ?;"};
+            auto update = SQLite::Statement{
+                sql,
+                "UPDATE `" + blob_table +
+                    "` SET kernel_blob = ?, uncompressed_size = ?, codec = ? WHERE hash = ?;"};
+
+            for(const auto& hash : hashes)
+            {
+                select.BindText(1, hash);
+                if(select.Step(sql) != SQLITE_ROW)
+                    MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                auto blob         = select.ColumnBlob(0);
+                const auto size   = select.ColumnInt64(1);
+                const auto codec_ = static_cast<KernelCodec>(select.ColumnInt64(2));
+                select.Reset();
+
+                if(size != 0)
+                    blob = Decompress(codec_, std::move(blob), static_cast<unsigned int>(size));
+
+                bool success               = false;
+                auto compressed            = compressor(blob, &success);
+                const auto compressed_size = success ? blob.size() : 0;
+
+                update.BindBlob(1, success ? compressed : blob);
+                update.BindInt64(2, compressed_size);
+                update.BindInt64(3, static_cast<int64_t>(*recompress));
+                update.BindText(4, hash);
+                if(update.Step(sql) != SQLITE_DONE)
+                    MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                update.Reset();
+                ++stats.recompressed;
+            }
+        }
+
+        sql.Exec("COMMIT;");
+    }
+    catch(...)
+    {
+        sql.Exec("ROLLBACK;");
+        throw;
+    }
+
+    sql.Exec("VACUUM;");
+
+    MIOPEN_LOG_I("Compacted " << filename << ": " << stats.moved << " moved, " << stats.removed
+                              << " removed, " << stats.recompressed << " recompressed");
+    return stats;
+}
+
+KernDb::PreparedStatement KernDb::Prepare(const std::string& query)
+{
+    auto lock = std::unique_lock<std::mutex>{stmt_cache->mutex};
+    auto it   = stmt_cache->statements.find(query);
+    if(it == stmt_cache->statements.end())
+        it = stmt_cache->statements.emplace(query, SQLite::Statement{sql, query}).first;
+    return {std::move(lock), it->second};
 }
 
 } // namespace miopen
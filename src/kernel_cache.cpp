@@ -47,48 +47,69 @@
 
 #include <iostream>
 #include <iterator>
+#include <mutex>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 
 namespace miopen {
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+std::vector<Kernel> KernelCache::GetKernels(const std::string& algorithm,
+                                            const std::string& network_config) const
 {
+    const auto key    = HashedKey{std::make_pair(algorithm, network_config)};
+    const auto& shard = GetShard(key);
 
-    std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-
-    const auto it = kernel_map.find(key);
-    if(it != kernel_map.end())
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const auto it = shard.kernel_map.find(key);
+    if(it != shard.kernel_map.end())
     {
         MIOPEN_LOG_I2(it->second.size()
-                      << " kernels for key: " << key.first << " \"" << key.second << '\"');
+                      << " kernels for key: " << key.key.first << " \"" << key.key.second << '\"');
         return it->second;
     }
 
-    static const std::vector<Kernel> empty{};
-    MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
-    return empty;
+    MIOPEN_LOG_I2("0 kernels for key: " << key.key.first << " \"" << key.key.second << '\"');
+    return {};
+}
+
+boost::optional<Program> KernelCache::FindProgram(const HashedKey& key) const
+{
+    const auto& shard = GetShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const auto it = shard.program_map.find(key);
+    if(it == shard.program_map.end())
+        return boost::none;
+    return it->second;
 }
 
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
-    const auto key = std::make_pair(name, params);
-    return program_map.count(key) > 0;
+    const auto key    = HashedKey{std::make_pair(name, params)};
+    const auto& shard = GetShard(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.program_map.count(key) > 0;
+}
+
+boost::optional<Program> KernelCache::GetProgram(const std::string& name,
+                                                 const std::string& params) const
+{
+    return FindProgram(HashedKey{std::make_pair(name, params)});
 }
 
 void KernelCache::ClearProgram(const std::string& name, const std::string& params)
 {
-    if(HasProgram(name, params))
-    {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
-    }
+    const auto key = HashedKey{std::make_pair(name, params)};
+    auto& shard    = GetShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.program_map.erase(key);
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    const auto key = HashedKey{std::make_pair(program_name, std::move(params))};
+    auto& shard    = GetShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.program_map[key] = std::move(prog);
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -107,31 +128,32 @@ Kernel KernelCache::AddKernel(const Handle& h,
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
         MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
 
-    Program program;
+    const auto program_key = HashedKey{std::make_pair(program_name, params)};
+    auto program           = FindProgram(program_key);
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
-    {
-        program = program_it->second;
-    }
-    else
+    if(!program)
     {
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
-        program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+
+        // The program is built without holding the lock. When several threads build the same
+        // program at once, the one added first is kept and used by all of them.
+        auto built  = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
+        auto& shard = GetShard(program_key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        program = shard.program_map.emplace(program_key, std::move(built)).first->second;
     }
 
     Kernel kernel{};
     const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
     if(arch != nullptr && strlen(arch) > 0)
     {
-        kernel = Kernel{program, kernel_name};
+        kernel = Kernel{*program, kernel_name};
     }
     else
     {
-        kernel = Kernel{program, kernel_name, vld, vgd};
+        kernel = Kernel{*program, kernel_name, vld, vgd};
     }
 
     if(!network_config.empty() && !algorithm.empty())
@@ -143,12 +165,16 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
 void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
+    const auto hashed_key = HashedKey{std::move(key)};
+    auto& shard           = GetShard(hashed_key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    auto&& v = shard.kernel_map[hashed_key];
     if(cache_index >= v.size())
     {
         v.resize(cache_index + 1);
     }
-    v[cache_index] = k;
+    v[cache_index] = std::move(k);
 }
 
 void KernelCache::ClearKernels(const std::string& algorithm, const std::string& network_config)
@@ -157,13 +183,19 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
     {
         MIOPEN_THROW("Network config or algorithm empty.");
     }
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v                                      = this->kernel_map[key];
-    if(!v.empty())
+    const auto key = HashedKey{std::make_pair(algorithm, network_config)};
+    auto& shard    = GetShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+    const auto it = shard.kernel_map.find(key);
+    if(it == shard.kernel_map.end())
+        return;
+    if(!it->second.empty())
     {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        MIOPEN_LOG_I2(it->second.size()
+                      << " kernels for key: " << key.key.first << " \"" << key.key.second << '\"');
     }
-    v.clear();
+    it->second.clear();
 }
 
 KernelCache::KernelCache() {}
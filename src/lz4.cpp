@@ -0,0 +1,219 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/lz4.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace miopen {
+namespace lz4 {
+
+namespace {
+
+constexpr std::size_t min_match     = 4;
+constexpr std::size_t last_literals = 5;  // The block always ends with literals.
+constexpr std::size_t match_margin  = 12; // The last match starts this far from the end.
+constexpr std::size_t max_offset    = 65535;
+constexpr int hash_log              = 16;
+
+[[noreturn]] void Fail(const std::string& reason)
+{
+    throw std::runtime_error("LZ4 decompress failed: " + reason);
+}
+
+inline std::uint32_t Read32(const char* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t Hash(std::uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - hash_log);
+}
+
+void WriteLength(std::string& out, std::size_t length)
+{
+    for(; length >= 255; length -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(length));
+}
+
+void WriteSequence(std::string& out,
+                   const char* literals,
+                   std::size_t literal_length,
+                   std::size_t offset,
+                   std::size_t match_length)
+{
+    const auto match_code = match_length - min_match;
+    const auto token =
+        (std::min<std::size_t>(literal_length, 15) << 4) | std::min<std::size_t>(match_code, 15);
+    out.push_back(static_cast<char>(token));
+    if(literal_length >= 15)
+        WriteLength(out, literal_length - 15);
+    out.append(literals, literal_length);
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(match_code >= 15)
+        WriteLength(out, match_code - 15);
+}
+
+void WriteLastLiterals(std::string& out, const char* literals, std::size_t literal_length)
+{
+    out.push_back(static_cast<char>(std::min<std::size_t>(literal_length, 15) << 4));
+    if(literal_length >= 15)
+        WriteLength(out, literal_length - 15);
+    out.append(literals, literal_length);
+}
+
+std::size_t ReadLength(const std::string& s, std::size_t& ip)
+{
+    auto length = std::size_t{0};
+    unsigned char byte;
+    do
+    {
+        if(ip >= s.size())
+            Fail("the compressed data ends unexpectedly");
+        byte = static_cast<unsigned char>(s[ip++]);
+        length += byte;
+    } while(byte == 255);
+    return length;
+}
+
+} // namespace
+
+std::string compress(const std::string& s, bool* compressed)
+{
+    const auto size = s.size();
+    const auto src  = s.data();
+
+    auto out = std::string{};
+    out.reserve(size + size / 255 + 16);
+
+    auto anchor = std::size_t{0};
+
+    if(size > match_margin)
+    {
+        auto table = std::vector<std::uint32_t>(std::size_t{1} << hash_log, 0);
+        auto pos   = std::size_t{1};
+
+        const auto match_end_limit = size - last_literals;
+
+        while(pos + match_margin <= size)
+        {
+            const auto sequence  = Read32(src + pos);
+            auto& slot           = table[Hash(sequence)];
+            const auto candidate = std::size_t{slot};
+            slot                 = static_cast<std::uint32_t>(pos);
+
+            if(pos - candidate > max_offset || Read32(src + candidate) != sequence)
+            {
+                ++pos;
+                continue;
+            }
+
+            auto length = min_match;
+            while(pos + length < match_end_limit && src[candidate + length] == src[pos + length])
+                ++length;
+
+            WriteSequence(out, src + anchor, pos - anchor, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        }
+    }
+
+    WriteLastLiterals(out, src + anchor, size - anchor);
+
+    if(out.size() >= size && compressed != nullptr)
+    {
+        *compressed = false;
+        return s;
+    }
+    if(compressed != nullptr)
+        *compressed = true;
+    return out;
+}
+
+std::string decompress(const std::string& s, unsigned int size)
+{
+    auto out = std::string(size, '\0');
+    auto ip  = std::size_t{0};
+    auto op  = std::size_t{0};
+
+    while(ip < s.size())
+    {
+        const auto token = static_cast<unsigned char>(s[ip++]);
+
+        auto literal_length = static_cast<std::size_t>(token >> 4u);
+        if(literal_length == 15)
+            literal_length += ReadLength(s, ip);
+        if(literal_length > s.size() - ip || literal_length > out.size() - op)
+            Fail("literals exceed the buffer");
+        std::memcpy(&out[op], &s[ip], literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        if(ip == s.size())
+            break;
+
+        if(s.size() - ip < 2)
+            Fail("the compressed data ends unexpectedly");
+        const auto offset = static_cast<std::size_t>(static_cast<unsigned char>(s[ip])) |
+                            static_cast<std::size_t>(static_cast<unsigned char>(s[ip + 1])) << 8;
+        ip += 2;
+        if(offset == 0 || offset > op)
+            Fail("invalid match offset");
+
+        auto match_length = static_cast<std::size_t>(token & 15u);
+        if(match_length == 15)
+            match_length += ReadLength(s, ip);
+        match_length += min_match;
+        if(match_length > out.size() - op)
+            Fail("match exceeds the buffer");
+
+        // Matches may overlap their own output, which repeats the last offset bytes.
+        if(offset >= match_length)
+        {
+            std::memcpy(&out[op], &out[op - offset], match_length);
+        }
+        else
+        {
+            for(std::size_t i = 0; i < match_length; ++i)
+                out[op + i] = out[op - offset + i];
+        }
+        op += match_length;
+    }
+
+    out.resize(op);
+    return out;
+}
+
+} // namespace lz4
+} // namespace miopen
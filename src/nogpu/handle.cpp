@@ -158,8 +158,8 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -175,6 +175,10 @@ Program Handle::LoadProgram(const std::string& program_name,
     {
         params += " -mcpu=" + this->GetTargetProperties().Name();
     }
+    // The headers of embedded HIP kernels are part of the cache key, so editing a header
+    // only invalidates the binaries of the kernels that include it.
+    if(!is_kernel_str && kernel_src.empty() && miopen::EndsWith(program_name, ".cpp"))
+        params += " -DMIOPEN_HIP_INC_HASH=" + miopen::GetHipKernelIncHash(program_name);
 
     auto hsaco       = miopen::LoadBinary(this->GetTargetProperties(),
                                     this->GetMaxComputeUnits(),
@@ -220,6 +224,34 @@ Program Handle::LoadProgram(const std::string& program_name,
     return p;
 }
 
+std::string Handle::GetProgramBinary(const std::string& program_name,
+                                     const std::string& params) const
+{
+    auto program = this->impl->cache.GetProgram(program_name, params);
+    if(!program)
+    {
+        program = this->LoadProgram(program_name, params, false, "");
+        this->AddProgram(*program, program_name, params);
+    }
+    if(!program->IsCodeObjectInMemory())
+        MIOPEN_THROW("Code object of " + program_name + " is not available.");
+    return program->GetCodeObjectBlob();
+}
+
+void Handle::AddProgramBinary(const std::string& program_name,
+                              const std::string& params,
+                              const std::string& binary) const
+{
+    // avoid the constructor since it implicitly calls the HIP API
+    auto pgmImpl     = std::make_shared<HIPOCProgramImpl>();
+    pgmImpl->program = program_name;
+    pgmImpl->target  = this->GetTargetProperties();
+    pgmImpl->binary  = std::vector<char>(binary.begin(), binary.end());
+    auto p           = HIPOCProgram{};
+    p.impl           = pgmImpl;
+    this->AddProgram(p, program_name, params);
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -40,11 +40,104 @@
 #include <miopen/batchnorm/invoke_params.hpp>
 #include <miopen/batchnorm/solvers.hpp>
 #include <miopen/find_solution.hpp>
+#include <miopen/plan.hpp>
 
 #include <chrono>
 
 namespace miopen {
 
+static auto BnFwdTrainingSolvers()
+{
+    return solver::SolverContainer<solver::batchnorm::BnFwdTrainingSpatialSingle,
+                                   solver::batchnorm::BnFwdTrainingSpatialMultiple,
+                                   solver::batchnorm::BnFwdTrainingPerActivation>{};
+}
+
+static auto BnFwdInferenceSolvers()
+{
+    return solver::SolverContainer<solver::batchnorm::BnFwdInference>{};
+}
+
+static auto BnBwdTrainingSolvers()
+{
+    return solver::SolverContainer<solver::batchnorm::BnBwdTrainingSpatialSingle,
+                                   solver::batchnorm::BnBwdTrainingSpatialMultiple,
+                                   solver::batchnorm::BnBwdTrainingPerActivation>{};
+}
+
+static void ValidateForwardTraining(const TensorDescriptor& xDesc,
+                                    const TensorDescriptor& yDesc,
+                                    const TensorDescriptor& bnScaleBiasMeanVarDesc)
+{
+    if(xDesc.GetSize() != yDesc.GetSize() || xDesc.GetSize() != bnScaleBiasMeanVarDesc.GetSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetType() != yDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(!xDesc.IsPacked())
+    {
+        MIOPEN_LOG_E("Only fully packed tensors supported.");
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetSize() < 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+}
+
+static void ValidateForwardInference(const TensorDescriptor& xDesc,
+                                     const TensorDescriptor& yDesc,
+                                     const TensorDescriptor& bnScaleBiasMeanVarDesc)
+{
+    if(xDesc.GetSize() != yDesc.GetSize() || xDesc.GetSize() != bnScaleBiasMeanVarDesc.GetSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetType() != yDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetSize() < 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+}
+
+static void ValidateBackward(const TensorDescriptor& xDesc,
+                             const TensorDescriptor& dyDesc,
+                             const TensorDescriptor& dxDesc,
+                             const TensorDescriptor& bnScaleBiasDiffDesc)
+{
+    if(xDesc.GetSize() != dyDesc.GetSize() || xDesc.GetSize() != bnScaleBiasDiffDesc.GetSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(dxDesc.GetType() != dyDesc.GetType() || dyDesc.GetType() != xDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetSize() < 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+}
+
+static AlgorithmName ForwardTrainingAlgorithm(miopenBatchNormMode_t bn_mode)
+{
+    return bn_mode == miopenBNSpatial
+               ? AlgorithmName{"miopenBatchNormForwardTrainingSpatial"}
+               : AlgorithmName{"miopenBatchNormForwardTrainingPerActivation"};
+}
+
+static AlgorithmName BackwardAlgorithm(miopenBatchNormMode_t bn_mode)
+{
+    return bn_mode == miopenBNSpatial ? AlgorithmName{"miopenBatchNormBackwardPropSpatial"}
+                                      : AlgorithmName{"miopenBatchNormBackwardPropPerActivation"};
+}
+
 void BatchNormForwardTraining(Handle& handle,
                               miopenBatchNormMode_t bn_mode,
                               const void* alpha,
@@ -68,23 +161,7 @@ void BatchNormForwardTraining(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(xDesc.GetSize() != yDesc.GetSize() || xDesc.GetSize() != bnScaleBiasMeanVarDesc.GetSize())
-    {
-        MIOPEN_THROW(miopenStatusBadParm);
-    }
-    if(xDesc.GetType() != yDesc.GetType())
-    {
-        MIOPEN_THROW(miopenStatusBadParm);
-    }
-    if(!xDesc.IsPacked())
-    {
-        MIOPEN_LOG_E("Only fully packed tensors supported.");
-        MIOPEN_THROW(miopenStatusBadParm);
-    }
-    if(xDesc.GetSize() < 3)
-    {
-        MIOPEN_THROW(miopenStatusBadParm);
-    }
+    ValidateForwardTraining(xDesc, yDesc, bnScaleBiasMeanVarDesc);
     if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
        !float_equal(*(static_cast<const float*>(beta)), 0.0))
     {
@@ -111,9 +188,7 @@ void BatchNormForwardTraining(Handle& handle,
                                                        resultsave,
                                                        resultrunning};
 
-    const auto algo = bn_mode == miopenBNSpatial
-                          ? AlgorithmName{"miopenBatchNormForwardTrainingSpatial"}
-                          : AlgorithmName{"miopenBatchNormForwardTrainingPerActivation"};
+    const auto algo = ForwardTrainingAlgorithm(bn_mode);
 
     const auto invoke_params = [&]() {
         auto tmp                  = batchnorm::InvokeParams{};
@@ -131,11 +206,7 @@ void BatchNormForwardTraining(Handle& handle,
         return tmp;
     }();
 
-    const auto solvers = solver::SolverContainer<solver::batchnorm::BnFwdTrainingSpatialSingle,
-                                                 solver::batchnorm::BnFwdTrainingSpatialMultiple,
-                                                 solver::batchnorm::BnFwdTrainingPerActivation>{};
-
-    solvers.ExecutePrimitive(handle, problem, algo, invoke_params);
+    BnFwdTrainingSolvers().ExecutePrimitive(handle, problem, algo, invoke_params);
 
     if(miopen::CheckNumericsEnabled())
     {
@@ -184,19 +255,7 @@ void BatchNormForwardInference(Handle& handle,
         {
             MIOPEN_THROW(miopenStatusBadParm);
         }
-        if(xDesc.GetSize() != yDesc.GetSize() ||
-           xDesc.GetSize() != bnScaleBiasMeanVarDesc.GetSize())
-        {
-            MIOPEN_THROW(miopenStatusBadParm);
-        }
-        if(xDesc.GetType() != yDesc.GetType())
-        {
-            MIOPEN_THROW(miopenStatusBadParm);
-        }
-        if(xDesc.GetSize() < 3)
-        {
-            MIOPEN_THROW(miopenStatusBadParm);
-        }
+        ValidateForwardInference(xDesc, yDesc, bnScaleBiasMeanVarDesc);
         if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
            !float_equal(*(static_cast<const float*>(beta)), 0))
         {
@@ -221,10 +280,8 @@ void BatchNormForwardInference(Handle& handle,
             return tmp;
         }();
 
-        const auto algo    = AlgorithmName{"miopenBatchNormalizationForwardInference"};
-        const auto solvers = solver::SolverContainer<solver::batchnorm::BnFwdInference>{};
-
-        solvers.ExecutePrimitive(handle, problem, algo, invoke_params);
+        const auto algo = AlgorithmName{"miopenBatchNormalizationForwardInference"};
+        BnFwdInferenceSolvers().ExecutePrimitive(handle, problem, algo, invoke_params);
     }
     else // Need to recalculated everything, let's just call training kernel in that case
     {
@@ -295,18 +352,7 @@ void BatchNormBackward(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(xDesc.GetSize() != dyDesc.GetSize() || xDesc.GetSize() != bnScaleBiasDiffDesc.GetSize())
-    {
-        MIOPEN_THROW(miopenStatusBadParm);
-    }
-    if(dxDesc.GetType() != dyDesc.GetType() || dyDesc.GetType() != xDesc.GetType())
-    {
-        MIOPEN_THROW(miopenStatusBadParm);
-    }
-    if(xDesc.GetSize() < 3)
-    {
-        MIOPEN_THROW(miopenStatusBadParm);
-    }
+    ValidateBackward(xDesc, dyDesc, dxDesc, bnScaleBiasDiffDesc);
     if(!float_equal(*(static_cast<const float*>(alphaDataDiff)), 1.0) ||
        !float_equal(*(static_cast<const float*>(betaDataDiff)), 0))
     {
@@ -325,9 +371,7 @@ void BatchNormBackward(Handle& handle,
     const auto problem = batchnorm::ProblemDescription{
         bn_mode, xDesc, dyDesc, dxDesc, bnScaleBiasDiffDesc, epsilon, useSaved};
 
-    const auto algo = bn_mode == miopenBNSpatial
-                          ? AlgorithmName{"miopenBatchNormBackwardPropSpatial"}
-                          : AlgorithmName{"miopenBatchNormBackwardPropPerActivation"};
+    const auto algo = BackwardAlgorithm(bn_mode);
 
     const auto invoke_params = [&]() {
         auto tmp              = batchnorm::BwdInvokeParams{};
@@ -345,11 +389,7 @@ void BatchNormBackward(Handle& handle,
         return tmp;
     }();
 
-    const auto solvers = solver::SolverContainer<solver::batchnorm::BnBwdTrainingSpatialSingle,
-                                                 solver::batchnorm::BnBwdTrainingSpatialMultiple,
-                                                 solver::batchnorm::BnBwdTrainingPerActivation>{};
-
-    solvers.ExecutePrimitive(handle, problem, algo, invoke_params);
+    BnBwdTrainingSolvers().ExecutePrimitive(handle, problem, algo, invoke_params);
 
     if(miopen::CheckNumericsEnabled())
     {
@@ -358,4 +398,139 @@ void BatchNormBackward(Handle& handle,
         miopen::checkNumericsOutput(handle, bnScaleBiasDiffDesc, resultBnBiasDiff);
     }
 }
+Plan MakeBatchNormForwardInferencePlan(Handle& handle,
+                                       miopenBatchNormMode_t bn_mode,
+                                       const TensorDescriptor& xDesc,
+                                       const TensorDescriptor& yDesc,
+                                       const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                       double epsilon)
+{
+    ValidateForwardInference(xDesc, yDesc, bnScaleBiasMeanVarDesc);
+
+    const auto problem =
+        batchnorm::ProblemDescription{bn_mode, xDesc, yDesc, bnScaleBiasMeanVarDesc, epsilon};
+    const auto algo     = AlgorithmName{"miopenBatchNormalizationForwardInference"};
+    const auto& invoker = BnFwdInferenceSolvers().GetPrimitiveInvoker(handle, problem, algo);
+
+    auto params    = batchnorm::InfInvokeParams{};
+    params.type    = InvokeType::Run;
+    params.epsilon = epsilon;
+
+    return {Plan::Kind::BatchNormForwardInference,
+            invoker,
+            std::move(params),
+            0,
+            {{miopenTensorBatchnormX, xDesc},
+             {miopenTensorBatchnormY, yDesc},
+             {miopenTensorBatchnormScale, bnScaleBiasMeanVarDesc},
+             {miopenTensorBatchnormBias, bnScaleBiasMeanVarDesc},
+             {miopenTensorBatchnormRunningMean, bnScaleBiasMeanVarDesc},
+             {miopenTensorBatchnormRunningVariance, bnScaleBiasMeanVarDesc}},
+            {miopenTensorBatchnormX,
+             miopenTensorBatchnormY,
+             miopenTensorBatchnormScale,
+             miopenTensorBatchnormBias,
+             miopenTensorBatchnormRunningMean,
+             miopenTensorBatchnormRunningVariance}};
+}
+
+Plan MakeBatchNormForwardTrainingPlan(Handle& handle,
+                                      miopenBatchNormMode_t bn_mode,
+                                      const TensorDescriptor& xDesc,
+                                      const TensorDescriptor& yDesc,
+                                      const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                      double expAvgFactor,
+                                      double epsilon,
+                                      bool resultrunning,
+                                      bool resultsave)
+{
+    ValidateForwardTraining(xDesc, yDesc, bnScaleBiasMeanVarDesc);
+
+    const auto problem  = batchnorm::ProblemDescription{bn_mode,
+                                                       xDesc,
+                                                       yDesc,
+                                                       bnScaleBiasMeanVarDesc,
+                                                       expAvgFactor,
+                                                       epsilon,
+                                                       resultsave,
+                                                       resultrunning};
+    const auto algo     = ForwardTrainingAlgorithm(bn_mode);
+    const auto& invoker = BnFwdTrainingSolvers().GetPrimitiveInvoker(handle, problem, algo);
+
+    auto params         = batchnorm::InvokeParams{};
+    params.type         = InvokeType::Run;
+    params.expAvgFactor = expAvgFactor;
+    params.epsilon      = epsilon;
+
+    auto descriptors = Plan::Descriptors{{miopenTensorBatchnormX, xDesc},
+                                         {miopenTensorBatchnormY, yDesc},
+                                         {miopenTensorBatchnormScale, bnScaleBiasMeanVarDesc},
+                                         {miopenTensorBatchnormBias, bnScaleBiasMeanVarDesc}};
+    if(resultrunning)
+    {
+        descriptors.emplace(miopenTensorBatchnormRunningMean, bnScaleBiasMeanVarDesc);
+        descriptors.emplace(miopenTensorBatchnormRunningVariance, bnScaleBiasMeanVarDesc);
+    }
+    if(resultsave)
+    {
+        descriptors.emplace(miopenTensorBatchnormSavedMean, bnScaleBiasMeanVarDesc);
+        descriptors.emplace(miopenTensorBatchnormSavedInvVariance, bnScaleBiasMeanVarDesc);
+    }
+
+    auto required = std::vector<miopenTensorArgumentId_t>{};
+    for(const auto& descriptor : descriptors)
+        required.push_back(descriptor.first);
+
+    return {Plan::Kind::BatchNormForwardTraining,
+            invoker,
+            std::move(params),
+            0,
+            std::move(descriptors),
+            required};
+}
+
+Plan MakeBatchNormBackwardPlan(Handle& handle,
+                               miopenBatchNormMode_t bn_mode,
+                               const TensorDescriptor& xDesc,
+                               const TensorDescriptor& dyDesc,
+                               const TensorDescriptor& dxDesc,
+                               const TensorDescriptor& bnScaleBiasDiffDesc,
+                               double epsilon,
+                               bool useSaved)
+{
+    ValidateBackward(xDesc, dyDesc, dxDesc, bnScaleBiasDiffDesc);
+
+    const auto problem = batchnorm::ProblemDescription{
+        bn_mode, xDesc, dyDesc, dxDesc, bnScaleBiasDiffDesc, epsilon, useSaved};
+    const auto algo     = BackwardAlgorithm(bn_mode);
+    const auto& invoker = BnBwdTrainingSolvers().GetPrimitiveInvoker(handle, problem, algo);
+
+    auto params    = batchnorm::BwdInvokeParams{};
+    params.type    = InvokeType::Run;
+    params.epsilon = epsilon;
+
+    auto descriptors = Plan::Descriptors{{miopenTensorBatchnormX, xDesc},
+                                         {miopenTensorBatchnormDY, dyDesc},
+                                         {miopenTensorBatchnormDX, dxDesc},
+                                         {miopenTensorBatchnormScale, bnScaleBiasDiffDesc},
+                                         {miopenTensorBatchnormScaleDiff, bnScaleBiasDiffDesc},
+                                         {miopenTensorBatchnormBiasDiff, bnScaleBiasDiffDesc}};
+    if(useSaved)
+    {
+        descriptors.emplace(miopenTensorBatchnormSavedMean, bnScaleBiasDiffDesc);
+        descriptors.emplace(miopenTensorBatchnormSavedInvVariance, bnScaleBiasDiffDesc);
+    }
+
+    auto required = std::vector<miopenTensorArgumentId_t>{};
+    for(const auto& descriptor : descriptors)
+        required.push_back(descriptor.first);
+
+    return {Plan::Kind::BatchNormBackward,
+            invoker,
+            std::move(params),
+            0,
+            std::move(descriptors),
+            required};
+}
+
 } // namespace miopen
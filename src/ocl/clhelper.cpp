@@ -226,14 +226,13 @@ ClProgramPtr LoadProgram(cl_context ctx,
     }
 }
 
-void GetProgramBinary(const ClProgramPtr& program, std::string& binary)
+void GetProgramBinary(cl_program program, std::string& binary)
 {
     size_t binary_size;
-    clGetProgramInfo(program.get(), CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binary_size, nullptr);
+    clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binary_size, nullptr);
     binary.resize(binary_size);
     char* src[1] = {&binary[0]};
-    if(clGetProgramInfo(program.get(), CL_PROGRAM_BINARIES, sizeof(src), &src, nullptr) !=
-       CL_SUCCESS)
+    if(clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(src), &src, nullptr) != CL_SUCCESS)
         MIOPEN_THROW(miopenStatusInternalError, "Could not extract binary from program");
 }
 
@@ -36,6 +36,7 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/invoker.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
@@ -47,9 +48,12 @@
 #include <miopen/conv/compiled_in_parameters.hpp>
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/conv/heuristic_model/solver_ranking.hpp>
 
 #include <cassert>
+#include <sstream>
 #include <type_traits>
+#include <unordered_map>
 
 #include <boost/range/adaptors.hpp>
 
@@ -63,6 +67,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_PATH)
 
@@ -345,6 +350,9 @@ static void DirConvFindCore(Handle& handle,
     AutoEnableProfiling enableProfiling{handle};
     ValidateGroupCount(xDesc, wDesc, conv);
 
+    // Tuning results of all solvers are committed to the perf db at once.
+    const auto perf_db_session = GetDb(ctx).BeginWriteSession();
+
     const auto network_config = problem.BuildConfKey();
     const auto invoke_ctx     = conv::DataInvokeParams{InvokeType::Evaluate,
                                                    {xDesc, x, wDesc, w, yDesc, y},
@@ -827,6 +835,31 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         return 10.0f / wti; // Assume WTI == 1.0 (100%) is 10 ms.
     };
 
+    // Times predicted by the solver ranking model of the device, if there is one. Solvers the
+    // model does not know are ranked after the ones it does, by their WTI.
+    auto predicted = std::unordered_map<std::string, float>{};
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_ENABLE_AI_IMMED_MODE_FALLBACK{}))
+    {
+        const auto model = ai::ranking::SolverRankingModel::Get(handle.GetDeviceName());
+        if(model != nullptr)
+        {
+            std::ostringstream db_key;
+            problem.Serialize(db_key);
+            try
+            {
+                if(!model->Predict(db_key.str(), predicted))
+                    MIOPEN_LOG_I2("Solver ranking model is not applicable to " << db_key.str());
+            }
+            catch(const std::exception& ex)
+            {
+                predicted.clear();
+                MIOPEN_LOG_W("Solver ranking model failed: " << ex.what());
+            }
+        }
+    }
+#endif
+
     for(const auto& solver_id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
     {
         // solver_id is always valid here, because taken from registry.
@@ -842,13 +875,26 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         if(!s.IsApplicable(ctx, problem))
             continue;
 
-        const auto wti = s.GetWti(ctx, problem);
-        MIOPEN_LOG_I2(solver_id.ToString() << " Estimated WTI = " << wti);
-        if(wti < 0.0f) // Skip unknown WTIs.
-            continue;
+        auto time             = 0.0f;
+        const auto prediction = predicted.find(solver_id.ToString());
+        if(prediction != predicted.end())
+        {
+            time = prediction->second;
+            MIOPEN_LOG_I2(solver_id.ToString() << " Predicted time = " << time);
+        }
+        else
+        {
+            const auto wti = s.GetWti(ctx, problem);
+            MIOPEN_LOG_I2(solver_id.ToString() << " Estimated WTI = " << wti);
+            if(wti < 0.0f) // Skip unknown WTIs.
+                continue;
+            time = wti2time(wti);
+            // Negative times are coarse estimates, which SolutionSortWrapper puts last.
+            if(!predicted.empty())
+                time = -time;
+        }
 
-        interim.emplace_back(
-            wti2time(wti), s.GetWorkspaceSize(ctx, problem), solver_id.Value(), algo);
+        interim.emplace_back(time, s.GetWorkspaceSize(ctx, problem), solver_id.Value(), algo);
     }
 
     MIOPEN_LOG_I2("maxSolutionCount = " << maxSolutionCount << ", available = " << interim.size());
@@ -1024,6 +1070,38 @@ Invoker LoadOrPrepareInvoker(Handle& handle,
     return PrepareInvoker(handle, ctx, problem, config, solver_id, dir);
 }
 
+/// Immediate mode runs the same problems over and over. Their invokers are also kept in a table
+/// keyed by the binary ProblemKey, so once a problem has been seen its calls neither make the
+/// ProblemDescription nor format the network config.
+static void RunImmediate(Handle& handle,
+                         const ConvolutionDescriptor& conv,
+                         const TensorDescriptor& in,
+                         const TensorDescriptor& weights,
+                         const TensorDescriptor& out,
+                         solver::Id solver_id,
+                         conv::Direction dir,
+                         const AnyInvokeParams& invoke_ctx)
+{
+    auto key = ProblemKey{'c'};
+    key.Add(dir).Add(in).Add(weights).Add(out);
+    key.Add(conv.mode).Add(conv.paddingMode).Add(conv.group_count).Add(double{conv.lowp_quant});
+    key.Add(conv.pads).Add(conv.strides).Add(conv.dilations).Add(conv.trans_output_pads);
+
+    if(const auto invoker = handle.GetInvoker(key, solver_id.Value()))
+    {
+        (*invoker)(handle, invoke_ctx);
+        return;
+    }
+
+    const auto problem = ProblemDescription{in, weights, out, conv, dir};
+    auto ctx           = ConvolutionContext{};
+    ctx.SetStream(&handle);
+
+    const auto invoker = LoadOrPrepareInvoker(handle, ctx, problem, solver_id, dir);
+    handle.RegisterInvoker(invoker, key, solver_id.Value());
+    invoker(handle, invoke_ctx);
+}
+
 static void CompileSolution(Handle& handle,
                             const solver::Id solver_id,
                             ConvolutionContext& ctx,
@@ -1036,6 +1114,38 @@ static void CompileSolution(Handle& handle,
     LoadOrPrepareInvoker(handle, ctx, problem, solver_id, dir);
 }
 
+solver::ConvSolution
+ConvolutionDescriptor::GetImmediateSolution(Handle& handle, const ProblemDescription& problem) const
+{
+    const auto algo_resolver = [&](const std::string& s) {
+        if(problem.direction.IsForward())
+            return static_cast<int>(StringToConvolutionFwdAlgo(s));
+        if(problem.direction.IsBackwardData())
+            return static_cast<int>(StringToConvolutionBwdDataAlgo(s));
+        return static_cast<int>(StringToConvolutionBwdWeightsAlgo(s));
+    };
+
+    auto found = miopenConvSolution_t{};
+    auto count = std::size_t{0};
+    GetSolutions(handle, problem, 1, &count, &found, algo_resolver);
+    if(count == 0)
+        GetSolutionsFallback(handle, problem, 1, &count, &found);
+    if(count == 0)
+        return {miopenStatusNotImplemented};
+
+    const auto solver_id = solver::Id{found.solution_id};
+    MIOPEN_LOG_I2("solver_id = " << solver_id.ToString());
+
+    auto ctx = ConvolutionContext{};
+    ctx.SetStream(&handle);
+    ctx.disable_search_enforce = true;
+    ctx.DetectRocm();
+    ctx.SetupFloats(problem);
+
+    auto db = GetDb(ctx);
+    return solver_id.GetSolver().FindSolution(ctx, problem, db, {});
+}
+
 void ConvolutionDescriptor::CompileForwardSolution(Handle& handle,
                                                    const TensorDescriptor& wDesc,
                                                    const TensorDescriptor& xDesc,
@@ -1071,16 +1181,10 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
 
     ConvForwardCheckNumerics(handle, tensors, [&]() {
-        const auto problem =
-            ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
-        auto ctx = ConvolutionContext{};
-        ctx.SetStream(&handle);
-
-        const auto invoker =
-            LoadOrPrepareInvoker(handle, ctx, problem, solver_id, conv::Direction::Forward);
         const auto invoke_ctx = conv::DataInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetFwd()};
-        invoker(handle, invoke_ctx);
+        RunImmediate(
+            handle, *this, xDesc, wDesc, yDesc, solver_id, conv::Direction::Forward, invoke_ctx);
     });
 }
 
@@ -1147,6 +1251,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
         }();
 
         found = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
+            const auto perf_db_session     = GetDb(ctx).BeginWriteSession();
             const auto network_config      = problem.BuildConfKey();
             const auto invoke_ctx          = conv::DataInvokeParams{InvokeType::Evaluate,
                                                            {dyDesc, dy, wDesc, w, dxDesc, dx},
@@ -1442,16 +1547,16 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
         }
         ValidateGroupCount(dxDesc, wDesc, *this);
 
-        const auto problem =
-            ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
-        auto ctx = ConvolutionContext{};
-        ctx.SetStream(&handle);
-
-        const auto invoker =
-            LoadOrPrepareInvoker(handle, ctx, problem, solver_id, conv::Direction::BackwardData);
         const auto invoke_ctx = conv::DataInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetBwd()};
-        invoker(handle, invoke_ctx);
+        RunImmediate(handle,
+                     *this,
+                     dxDesc,
+                     wDesc,
+                     dyDesc,
+                     solver_id,
+                     conv::Direction::BackwardData,
+                     invoke_ctx);
     });
 }
 
@@ -1520,12 +1625,13 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             ctx.SetStream(&handle);
             ctx.SetupFloats(problem);
             ctx.DetectRocm();
-            const auto network_config = problem.BuildConfKey();
-            const auto invoke_ctx     = conv::WrWInvokeParams{InvokeType::Evaluate,
-                                                          {dyDesc, dy, xDesc, x, dwDesc, dw},
-                                                          workSpace,
-                                                          workSpaceSize,
-                                                          this->attribute.gfx90aFp16alt.GetWrW()};
+            const auto perf_db_session = GetDb(ctx).BeginWriteSession();
+            const auto network_config  = problem.BuildConfKey();
+            const auto invoke_ctx      = conv::WrWInvokeParams{InvokeType::Evaluate,
+                                                           {dyDesc, dy, xDesc, x, dwDesc, dw},
+                                                           workSpace,
+                                                           workSpaceSize,
+                                                           this->attribute.gfx90aFp16alt.GetWrW()};
 
             // Find solutions
             const auto gemm        = !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{})
@@ -1794,16 +1900,16 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
     ConvWrwCheckNumerics(handle, tensors, &beta, [&]() {
         ValidateGroupCount(xDesc, dwDesc, *this);
 
-        const auto problem =
-            ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
-        auto ctx = ConvolutionContext{};
-        ctx.SetStream(&handle);
-
-        const auto invoker =
-            LoadOrPrepareInvoker(handle, ctx, problem, solver_id, conv::Direction::BackwardWeights);
         const auto invoke_ctx = conv::WrWInvokeParams{
             tensors, workSpace, workSpaceSize, this->attribute.gfx90aFp16alt.GetWrW()};
-        invoker(handle, invoke_ctx);
+        RunImmediate(handle,
+                     *this,
+                     xDesc,
+                     dwDesc,
+                     dyDesc,
+                     solver_id,
+                     conv::Direction::BackwardWeights,
+                     invoke_ctx);
     });
 }
 
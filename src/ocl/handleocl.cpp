@@ -270,8 +270,19 @@ Handle::Handle() : impl(new HandleImpl())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+// The tasks of the other handle may still use its impl, so they finish before it is moved.
+Handle::Handle(Handle&& other) noexcept
+    : impl((other.background_tasks.Wait(), std::move(other.impl))),
+      find_map(std::move(other.find_map)),
+#if MIOPEN_USE_MIOPENGEMM
+      geo_map(std::move(other.geo_map)),
+#endif
+      invokers(std::move(other.invokers)),
+      invoker_table(std::move(other.invoker_table))
+{
+}
+
+Handle::~Handle() = default;
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -369,8 +380,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -448,6 +459,31 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
+std::string Handle::GetProgramBinary(const std::string& program_name,
+                                     const std::string& params) const
+{
+    auto program = this->impl->cache.GetProgram(program_name, params);
+    if(!program)
+    {
+        program = this->LoadProgram(program_name, params, false, "");
+        this->AddProgram(*program, program_name, params);
+    }
+    std::string binary;
+    miopen::GetProgramBinary(program->get(), binary);
+    return binary;
+}
+
+void Handle::AddProgramBinary(const std::string& program_name,
+                              const std::string& params,
+                              const std::string& binary) const
+{
+    this->AddProgram(LoadBinaryProgram(miopen::GetContext(this->GetStream()),
+                                       miopen::GetDevice(this->GetStream()),
+                                       binary),
+                     program_name,
+                     params);
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -34,6 +34,7 @@
 #include <miopen/find_solution.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/mlo_internal.hpp>
+#include <miopen/plan.hpp>
 
 namespace miopen {
 
@@ -53,43 +54,23 @@ static auto PoolingBackwardSolvers()
                                    solver::pooling::TransposedPoolingBwdNd>{};
 }
 
-miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
-                                          const void* alpha,
-                                          const TensorDescriptor& xDesc,
-                                          ConstData_t x,
-                                          const void* beta,
-                                          const TensorDescriptor& yDesc,
-                                          Data_t y,
-                                          bool save_index,
-                                          Data_t workSpace,
-                                          size_t /*workSpaceSize*/) const
+static void ValidateForward(const PoolingDescriptor& pooling,
+                            const TensorDescriptor& xDesc,
+                            bool save_index)
 {
-
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
-    {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
-    }
-    if(miopen::CheckNumericsEnabled())
-    {
-        miopen::checkNumericsInput(handle, xDesc, x);
-        if(!float_equal(*(static_cast<const float*>(beta)), 0))
-        {
-            miopen::checkNumericsInput(handle, yDesc, y);
-        }
-    }
-
     int pool_dim = xDesc.GetSize();
     if(pool_dim != 4 && pool_dim != 5)
     {
         MIOPEN_THROW("Unsupported pooling dimension");
     }
 
-    auto index_max = get_index_max(GetIndexType());
+    const auto& lens              = pooling.GetLengths();
+    const auto workspaceIndexMode = pooling.GetWorkspaceIndexMode();
+    auto index_max                = get_index_max(pooling.GetIndexType());
 
     // for kernel implementation max pooling backward pass,
     //   "index_max" means ghost, and thus should not be reached
-    if(mode == miopenPoolingMax && save_index)
+    if(pooling.GetMode() == miopenPoolingMax && save_index)
     {
         if((workspaceIndexMode == miopenPoolingWorkspaceIndexMask &&
             !(index_max >= std::accumulate(lens.begin(), lens.end(), 1, std::multiplies<int>()))) ||
@@ -106,17 +87,62 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
         {
             MIOPEN_THROW("3D pooling doesn't support workspace index mask mode");
         }
+    }
+}
+
+static AlgorithmName ForwardAlgorithm(const TensorDescriptor& xDesc)
+{
+    return AlgorithmName{xDesc.GetSize() == 5 ? "miopenPoolingNdForward"
+                                              : "miopenPooling2dForward"};
+}
+
+static AlgorithmName BackwardAlgorithm(const TensorDescriptor& dyDesc)
+{
+    const auto pool_dim = dyDesc.GetSize();
+    if(pool_dim != 4 && pool_dim != 5)
+    {
+        MIOPEN_THROW("Unsupported pooling dimension");
+    }
+
+    return AlgorithmName{pool_dim == 5 ? "miopenPoolingNdBackward" : "miopenPooling2dBackward"};
+}
+
+miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
+                                          const void* alpha,
+                                          const TensorDescriptor& xDesc,
+                                          ConstData_t x,
+                                          const void* beta,
+                                          const TensorDescriptor& yDesc,
+                                          Data_t y,
+                                          bool save_index,
+                                          Data_t workSpace,
+                                          size_t /*workSpaceSize*/) const
+{
 
-        if(workSpace == nullptr)
+    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
+       !float_equal(*(static_cast<const float*>(beta)), 0))
+    {
+        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+    }
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        if(!float_equal(*(static_cast<const float*>(beta)), 0))
         {
-            throw std::invalid_argument("workSpace cannot be NULL in Forward Pooling MAX mode when "
-                                        "backward pass is requested");
+            miopen::checkNumericsInput(handle, yDesc, y);
         }
     }
 
-    const auto algo_name =
-        AlgorithmName{pool_dim == 5 ? "miopenPoolingNdForward" : "miopenPooling2dForward"};
-    const auto problem = pooling::ProblemDescription{*this, xDesc, yDesc, save_index};
+    ValidateForward(*this, xDesc, save_index);
+
+    if(mode == miopenPoolingMax && save_index && workSpace == nullptr)
+    {
+        throw std::invalid_argument("workSpace cannot be NULL in Forward Pooling MAX mode when "
+                                    "backward pass is requested");
+    }
+
+    const auto algo_name = ForwardAlgorithm(xDesc);
+    const auto problem   = pooling::ProblemDescription{*this, xDesc, yDesc, save_index};
 
     const auto invoke_params = [&]() {
         auto tmp      = pooling::FwdInvokeParams{};
@@ -172,15 +198,8 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     assert(yDesc.GetElementSize() == dyDesc.GetElementSize() &&
            xDesc.GetElementSize() == dxDesc.GetElementSize());
 
-    int pool_dim = dyDesc.GetSize();
-    if(pool_dim != 4 && pool_dim != 5)
-    {
-        MIOPEN_THROW("Unsupported pooling dimension");
-    }
-
-    const auto problem = pooling::ProblemDescription{*this, xDesc, yDesc, dxDesc, dyDesc};
-    const auto algo_name =
-        AlgorithmName{pool_dim == 5 ? "miopenPoolingNdBackward" : "miopenPooling2dBackward"};
+    const auto algo_name = BackwardAlgorithm(dyDesc);
+    const auto problem   = pooling::ProblemDescription{*this, xDesc, yDesc, dxDesc, dyDesc};
 
     const auto invoke_params = [&]() {
         auto tmp      = pooling::BwdInvokeParams{};
@@ -204,4 +223,66 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     return miopenStatusSuccess;
 }
 
+Plan PoolingDescriptor::MakeForwardPlan(Handle& handle,
+                                        const TensorDescriptor& xDesc,
+                                        const TensorDescriptor& yDesc,
+                                        bool save_index) const
+{
+    ValidateForward(*this, xDesc, save_index);
+
+    const auto problem = pooling::ProblemDescription{*this, xDesc, yDesc, save_index};
+    const auto& invoker =
+        PoolingForwardSolvers().GetPrimitiveInvoker(handle, problem, ForwardAlgorithm(xDesc));
+
+    auto params    = pooling::FwdInvokeParams{};
+    params.type    = InvokeType::Run;
+    params.xDesc   = xDesc;
+    params.yDesc   = yDesc;
+    params.pooling = *this;
+
+    auto required =
+        std::vector<miopenTensorArgumentId_t>{miopenTensorPoolingX, miopenTensorPoolingY};
+    if(mode == miopenPoolingMax && save_index)
+        required.push_back(miopenTensorPoolingIndices);
+
+    return {Plan::Kind::PoolingForward,
+            invoker,
+            std::move(params),
+            0,
+            {{miopenTensorPoolingX, xDesc}, {miopenTensorPoolingY, yDesc}},
+            required};
+}
+
+Plan PoolingDescriptor::MakeBackwardPlan(Handle& handle,
+                                         const TensorDescriptor& yDesc,
+                                         const TensorDescriptor& dyDesc,
+                                         const TensorDescriptor& xDesc,
+                                         const TensorDescriptor& dxDesc) const
+{
+    const auto algo_name = BackwardAlgorithm(dyDesc);
+    const auto problem   = pooling::ProblemDescription{*this, xDesc, yDesc, dxDesc, dyDesc};
+    const auto& invoker  = PoolingBackwardSolvers().GetPrimitiveInvoker(handle, problem, algo_name);
+
+    auto params    = pooling::BwdInvokeParams{};
+    params.type    = InvokeType::Run;
+    params.dxDesc  = dxDesc;
+    params.dyDesc  = dyDesc;
+    params.pooling = *this;
+
+    auto required =
+        std::vector<miopenTensorArgumentId_t>{miopenTensorPoolingDY, miopenTensorPoolingDX};
+    if(mode == miopenPoolingMax)
+        required.push_back(miopenTensorPoolingIndices);
+
+    return {Plan::Kind::PoolingBackward,
+            invoker,
+            std::move(params),
+            0,
+            {{miopenTensorPoolingX, xDesc},
+             {miopenTensorPoolingY, yDesc},
+             {miopenTensorPoolingDX, dxDesc},
+             {miopenTensorPoolingDY, dyDesc}},
+            required};
+}
+
 } // namespace miopen
@@ -0,0 +1,325 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/plan.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/batchnorm/invoke_params.hpp>
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/pooling/invoke_params.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <boost/variant/get.hpp>
+
+#include <limits>
+
+namespace miopen {
+
+static std::uint64_t Bit(miopenTensorArgumentId_t id)
+{
+    // Ids come from the user and may be out of the enum, so they are checked before shifting.
+    if(id < 0 || id >= std::numeric_limits<std::uint64_t>::digits)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid tensor argument id " + std::to_string(id) + ".");
+    return std::uint64_t{1} << static_cast<unsigned>(id);
+}
+
+Plan::Plan(Kind kind_,
+           Invoker invoker_,
+           AnyInvokeParams params_,
+           std::size_t workspace_required_,
+           Descriptors descriptors_,
+           const std::vector<miopenTensorArgumentId_t>& required_)
+    : kind(kind_),
+      invoker(std::move(invoker_)),
+      params(std::move(params_)),
+      workspace_required(workspace_required_),
+      descriptors(std::move(descriptors_))
+{
+    for(const auto id : required_)
+        required |= Bit(id);
+
+    if(kind == Kind::BatchNormForwardInference)
+        params.CastTo<batchnorm::InfInvokeParams>().xDesc =
+            &GetTensorDescriptor(miopenTensorBatchnormX);
+}
+
+const TensorDescriptor& Plan::GetTensorDescriptor(miopenTensorArgumentId_t id) const
+{
+    const auto found = descriptors.find(id);
+    if(found == descriptors.end())
+        MIOPEN_THROW(miopenStatusInvalidValue,
+                     "The plan has no tensor argument " + std::to_string(id) + ".");
+    return found->second;
+}
+
+void Plan::Run(const Handle& handle,
+               const miopenTensorArgument_t* arguments,
+               std::size_t count,
+               Data_t workspace,
+               std::size_t workspace_size)
+{
+    if(workspace_size < workspace_required)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The plan requires at least " + std::to_string(workspace_required) +
+                         " workspace, while " + std::to_string(workspace_size) +
+                         " was provided");
+    if(arguments == nullptr && count != 0)
+        MIOPEN_THROW(miopenStatusBadParm, "arguments cannot be nullptr");
+
+    auto bound = std::uint64_t{0};
+
+    for(auto i = std::size_t{0}; i < count; ++i)
+    {
+        const auto& argument = arguments[i];
+
+        if((required & Bit(argument.id)) == 0)
+            MIOPEN_THROW(miopenStatusInvalidValue,
+                         "The plan has no tensor argument " + std::to_string(argument.id) + ".");
+        if(argument.descriptor != nullptr)
+            MIOPEN_THROW(miopenStatusNotImplemented,
+                         "Plans do not support overriding the tensor descriptors.");
+        if(argument.buffer == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Buffer of the tensor argument " + std::to_string(argument.id) +
+                             " cannot be nullptr.");
+
+        Bind(argument.id, DataCast(argument.buffer));
+        bound |= Bit(argument.id);
+    }
+
+    if(bound != required)
+        MIOPEN_THROW(miopenStatusBadParm, "Not all the tensor arguments of the plan are set.");
+
+    if(kind == Kind::ConvolutionForward || kind == Kind::ConvolutionBackwardData)
+    {
+        auto& data         = params.CastTo<conv::DataInvokeParams>();
+        data.workSpace     = workspace;
+        data.workSpaceSize = workspace_size;
+    }
+    else if(kind == Kind::ConvolutionBackwardWeights)
+    {
+        auto& wrw         = params.CastTo<conv::WrWInvokeParams>();
+        wrw.workSpace     = workspace;
+        wrw.workSpaceSize = workspace_size;
+    }
+
+    invoker(handle, params);
+}
+
+void Plan::Bind(miopenTensorArgumentId_t id, Data_t buffer)
+{
+    // The transposed convolutions run the opposite direction with the X and Y swapped.
+    if(swap_xy && id == miopenTensorConvolutionX)
+        id = miopenTensorConvolutionY;
+    else if(swap_xy && id == miopenTensorConvolutionY)
+        id = miopenTensorConvolutionX;
+
+    switch(kind)
+    {
+    case Kind::ConvolutionForward:
+    case Kind::ConvolutionBackwardData: {
+        auto& data       = params.CastTo<conv::DataInvokeParams>();
+        const auto in_id = kind == Kind::ConvolutionForward ? miopenTensorConvolutionX
+                                                            : miopenTensorConvolutionY;
+        if(id == in_id)
+            data.tensors.in = buffer;
+        else if(id == miopenTensorConvolutionW)
+            data.tensors.w = buffer;
+        else
+            data.tensors.out = buffer;
+        break;
+    }
+    case Kind::ConvolutionBackwardWeights: {
+        auto& wrw = params.CastTo<conv::WrWInvokeParams>();
+        if(id == miopenTensorConvolutionX)
+            wrw.tensors.x = buffer;
+        else if(id == miopenTensorConvolutionW)
+            wrw.tensors.dw = buffer;
+        else
+            wrw.tensors.dy = buffer;
+        break;
+    }
+    case Kind::PoolingForward: {
+        auto& fwd = params.CastTo<pooling::FwdInvokeParams>();
+        if(id == miopenTensorPoolingX)
+            fwd.x = buffer;
+        else if(id == miopenTensorPoolingY)
+            fwd.y = buffer;
+        else
+            fwd.workspace = buffer;
+        break;
+    }
+    case Kind::PoolingBackward: {
+        auto& bwd = params.CastTo<pooling::BwdInvokeParams>();
+        if(id == miopenTensorPoolingDY)
+            bwd.dy = buffer;
+        else if(id == miopenTensorPoolingDX)
+            bwd.dx = buffer;
+        else
+            bwd.workspace = buffer;
+        break;
+    }
+    case Kind::BatchNormForwardInference: {
+        auto& inf = params.CastTo<batchnorm::InfInvokeParams>();
+        switch(id)
+        {
+        case miopenTensorBatchnormX: inf.x = buffer; break;
+        case miopenTensorBatchnormY: inf.y = buffer; break;
+        case miopenTensorBatchnormScale: inf.bnScale = buffer; break;
+        case miopenTensorBatchnormBias: inf.bnBias = buffer; break;
+        case miopenTensorBatchnormRunningMean: inf.estimatedMean = buffer; break;
+        case miopenTensorBatchnormRunningVariance: inf.estimatedVariance = buffer; break;
+        default: MIOPEN_THROW(miopenStatusInternalError);
+        }
+        break;
+    }
+    case Kind::BatchNormForwardTraining: {
+        auto& fwd = params.CastTo<batchnorm::InvokeParams>();
+        switch(id)
+        {
+        case miopenTensorBatchnormX: fwd.x = buffer; break;
+        case miopenTensorBatchnormY: fwd.y = buffer; break;
+        case miopenTensorBatchnormScale: fwd.bnScale = buffer; break;
+        case miopenTensorBatchnormBias: fwd.bnBias = buffer; break;
+        case miopenTensorBatchnormRunningMean: fwd.resultRunningMean = buffer; break;
+        case miopenTensorBatchnormRunningVariance: fwd.resultRunningVariance = buffer; break;
+        case miopenTensorBatchnormSavedMean: fwd.resultSaveMean = buffer; break;
+        case miopenTensorBatchnormSavedInvVariance: fwd.resultSaveInvVariance = buffer; break;
+        default: MIOPEN_THROW(miopenStatusInternalError);
+        }
+        break;
+    }
+    case Kind::BatchNormBackward: {
+        auto& bwd = params.CastTo<batchnorm::BwdInvokeParams>();
+        switch(id)
+        {
+        case miopenTensorBatchnormX: bwd.x = buffer; break;
+        case miopenTensorBatchnormDY: bwd.dy = buffer; break;
+        case miopenTensorBatchnormDX: bwd.dx = buffer; break;
+        case miopenTensorBatchnormScale: bwd.bnScale = buffer; break;
+        case miopenTensorBatchnormScaleDiff: bwd.resultBnScaleDiff = buffer; break;
+        case miopenTensorBatchnormBiasDiff: bwd.resultBnBiasDiff = buffer; break;
+        case miopenTensorBatchnormSavedMean: bwd.savedMean = buffer; break;
+        case miopenTensorBatchnormSavedInvVariance: bwd.savedInvVariance = buffer; break;
+        default: MIOPEN_THROW(miopenStatusInternalError);
+        }
+        break;
+    }
+    }
+}
+
+Plan MakeConvolutionPlan(Handle& handle,
+                         const Problem& problem,
+                         const solver::Id& solver,
+                         const std::string& perf_cfg)
+{
+    const auto& conv_desc = boost::get<ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+    const auto transposed = conv_desc.mode == miopenTranspose;
+    const auto actual     = transposed ? problem.MakeTransposed() : problem;
+
+    const auto& x =
+        actual.GetTensorDescriptorChecked(miopenTensorConvolutionX, "miopenTensorConvolutionX");
+    const auto& w =
+        actual.GetTensorDescriptorChecked(miopenTensorConvolutionW, "miopenTensorConvolutionW");
+    const auto& y =
+        actual.GetTensorDescriptorChecked(miopenTensorConvolutionY, "miopenTensorConvolutionY");
+    const auto conv_problem = actual.AsConvolution();
+    const auto& conv        = conv_problem.GetConv();
+
+    if(y.GetLengths()[1] != w.GetLengths()[0])
+        MIOPEN_THROW(miopenStatusBadParm);
+    Problem::ValidateGroupCount(x, w, conv);
+
+    const auto conv_prob = ProblemDescription{conv_problem};
+    const auto solution  = [&]() {
+        if(!solver.IsValid())
+            return conv.GetImmediateSolution(handle, conv_prob);
+
+        auto ctx                   = ConvolutionContext{{&handle}};
+        ctx.disable_search_enforce = true;
+        ctx.DetectRocm();
+        ctx.SetupFloats(conv_prob);
+        decltype(auto) db = GetDb(ctx);
+        return solver.GetSolver().FindSolution(ctx, conv_prob, db, {}, perf_cfg);
+    }();
+
+    if(!solution.Succeeded() || !solution.invoker_factory)
+        MIOPEN_THROW(miopenStatusNotImplemented, "No solution found for the convolution plan.");
+
+    auto invoker = handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
+
+    auto params = [&]() -> AnyInvokeParams {
+        const auto& fp16alt = conv.attribute.gfx90aFp16alt;
+        switch(actual.GetDirection())
+        {
+        case miopenProblemDirectionForward:
+            return conv::DataInvokeParams{
+                {x, nullptr, w, nullptr, y, nullptr}, nullptr, 0, fp16alt.GetFwd()};
+        case miopenProblemDirectionBackward:
+            return conv::DataInvokeParams{
+                {y, nullptr, w, nullptr, x, nullptr}, nullptr, 0, fp16alt.GetBwd()};
+        case miopenProblemDirectionBackwardWeights:
+            return conv::WrWInvokeParams{
+                {y, nullptr, x, nullptr, w, nullptr}, nullptr, 0, fp16alt.GetWrW()};
+        }
+        MIOPEN_THROW(miopenStatusNotImplemented);
+    }();
+
+    const auto kind = [&]() {
+        switch(actual.GetDirection())
+        {
+        case miopenProblemDirectionForward: return Plan::Kind::ConvolutionForward;
+        case miopenProblemDirectionBackward: return Plan::Kind::ConvolutionBackwardData;
+        case miopenProblemDirectionBackwardWeights: return Plan::Kind::ConvolutionBackwardWeights;
+        }
+        MIOPEN_THROW(miopenStatusNotImplemented);
+    }();
+
+    const auto ids = std::vector<miopenTensorArgumentId_t>{
+        miopenTensorConvolutionX, miopenTensorConvolutionW, miopenTensorConvolutionY};
+    auto descriptors = Plan::Descriptors{};
+    for(const auto id : ids)
+        descriptors.emplace(id, problem.GetTensorDescriptor(id));
+
+    auto plan = Plan{kind,
+                     std::move(invoker),
+                     std::move(params),
+                     solution.workspace_sz,
+                     std::move(descriptors),
+                     ids};
+    plan.swap_xy = transposed;
+    return plan;
+}
+
+} // namespace miopen
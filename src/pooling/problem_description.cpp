@@ -27,6 +27,7 @@
 #include <miopen/pooling/problem_description.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/pooling.hpp>
+#include <miopen/problem_key.hpp>
 
 #include <sstream>
 
@@ -202,6 +203,18 @@ NetworkConfig ProblemDescription::MakeNetworkConfig() const
     return NetworkConfig{ss.str()};
 }
 
+ProblemKey ProblemDescription::MakeProblemKey() const
+{
+    auto key = ProblemKey{'p'};
+    key.Add(direction).Add(save_index).Add(xDesc).Add(yDesc).Add(dxDesc).Add(dyDesc);
+    key.Add(pooling.GetMode())
+        .Add(pooling.GetPaddingMode())
+        .Add(pooling.GetIndexType())
+        .Add(pooling.GetWorkspaceIndexMode());
+    key.Add(pooling.lens).Add(pooling.strides).Add(pooling.pads);
+    return key;
+}
+
 } // namespace pooling
 
 } // namespace miopen
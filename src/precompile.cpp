@@ -0,0 +1,311 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/precompile.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <istream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace miopen {
+
+std::size_t PrecompileProblems(Handle& handle, const std::vector<Problem>& problems)
+{
+    auto solutions = std::vector<solver::ConvSolution>{};
+    auto resolved  = std::set<std::string>{};
+
+    for(const auto& problem : problems)
+    {
+        const auto& conv_desc = boost::get<ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+
+        // Same as in Problem::FindSolutions, transposed convolutions are solved by the opposite
+        // direction.
+        const auto& actual = conv_desc.mode == miopenTranspose ? problem.MakeTransposed() : problem;
+
+        const auto conv_problem = actual.AsConvolution();
+
+        // Networks tend to repeat the same layers many times.
+        if(!resolved.insert(conv_problem.BuildConfKey().ToString()).second)
+            continue;
+
+        try
+        {
+            auto solution = conv_desc.GetImmediateSolution(handle, conv_problem);
+            if(!solution.Succeeded())
+            {
+                MIOPEN_LOG_W("No solution found for " << conv_problem.BuildConfKey().ToString());
+                continue;
+            }
+            MIOPEN_LOG_I2(solution);
+            solutions.push_back(std::move(solution));
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W(conv_problem.BuildConfKey().ToString() << ": " << ex.what());
+        }
+    }
+
+    auto pointers = std::vector<const solver::ConvSolution*>{};
+    pointers.reserve(solutions.size());
+    std::transform(solutions.begin(),
+                   solutions.end(),
+                   std::back_inserter(pointers),
+                   [](const auto& solution) { return &solution; });
+
+    solver::PrecompileSolutions(handle, pointers);
+    MIOPEN_LOG_I("Precompiled " << solutions.size() << " solutions for " << problems.size()
+                                << " problems");
+    return solutions.size();
+}
+
+namespace {
+
+class DriverArgs
+{
+public:
+    explicit DriverArgs(std::istream& tokens)
+    {
+        // Only the short forms of the flags which affect the problem are recognized.
+        static const auto short_names = std::map<char, std::string>{
+            {'n', "batchsize"},
+            {'c', "in_channels"},
+            {'!', "in_d"},
+            {'H', "in_h"},
+            {'W', "in_w"},
+            {'k', "out_channels"},
+            {'@', "fil_d"},
+            {'y', "fil_h"},
+            {'x', "fil_w"},
+            {'#', "conv_stride_d"},
+            {'u', "conv_stride_h"},
+            {'v', "conv_stride_w"},
+            {'$', "pad_d"},
+            {'p', "pad_h"},
+            {'q', "pad_w"},
+            {'^', "dilation_d"},
+            {'l', "dilation_h"},
+            {'j', "dilation_w"},
+            {'%', "trans_output_pad_d"},
+            {'Y', "trans_output_pad_h"},
+            {'X', "trans_output_pad_w"},
+            {'g', "group_count"},
+            {'m', "mode"},
+            {'z', "pad_mode"},
+            {'F', "forw"},
+            {'_', "spatial_dim"},
+            {'I', "in_layout"},
+            {'O', "out_layout"},
+            {'f', "fil_layout"},
+        };
+
+        std::string token;
+        while(tokens >> token)
+        {
+            std::string name;
+            if(token.size() > 2 && token.compare(0, 2, "--") == 0)
+            {
+                name = token.substr(2);
+            }
+            else if(token.size() == 2 && token[0] == '-')
+            {
+                const auto it = short_names.find(token[1]);
+                if(it != short_names.end())
+                    name = it->second;
+            }
+
+            std::string value;
+            if(!(tokens >> value))
+                MIOPEN_THROW(miopenStatusBadParm, "Missing value of " + token);
+            if(!name.empty())
+                values[name] = value;
+        }
+    }
+
+    std::string GetString(const std::string& name, const std::string& default_value) const
+    {
+        const auto it = values.find(name);
+        return it == values.end() ? default_value : it->second;
+    }
+
+    int GetInt(const std::string& name, int default_value) const
+    {
+        const auto it = values.find(name);
+        if(it == values.end())
+            return default_value;
+        try
+        {
+            return std::stoi(it->second);
+        }
+        catch(const std::exception&)
+        {
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid value of --" + name + ": " + it->second);
+        }
+    }
+
+private:
+    std::map<std::string, std::string> values;
+};
+
+miopenTensorLayout_t GetLayout(const DriverArgs& args, const std::string& name, int spatial_dim)
+{
+    const auto layout = args.GetString(name, spatial_dim == 3 ? "NCDHW" : "NCHW");
+    if(layout == "NCHW")
+        return miopenTensorNCHW;
+    if(layout == "NHWC")
+        return miopenTensorNHWC;
+    if(layout == "NCDHW")
+        return miopenTensorNCDHW;
+    if(layout == "NDHWC")
+        return miopenTensorNDHWC;
+    MIOPEN_THROW(miopenStatusBadParm, "Unsupported --" + name + ": " + layout);
+}
+
+} // namespace
+
+std::vector<Problem> ParseDriverCommand(const std::string& line)
+{
+    std::istringstream tokens{line};
+    std::string command;
+
+    if(!(tokens >> command) || command[0] == '#')
+        return {};
+    if(command.size() >= 12 && command.compare(command.size() - 12, 12, "MIOpenDriver") == 0)
+        tokens >> command;
+
+    miopenDataType_t type;
+    if(command == "conv")
+        type = miopenFloat;
+    else if(command == "convfp16")
+        type = miopenHalf;
+    else if(command == "convbfp16")
+        type = miopenBFloat16;
+    else
+    {
+        MIOPEN_LOG_I2("Skipping driver command: " << command);
+        return {};
+    }
+
+    const auto args        = DriverArgs{tokens};
+    const auto spatial_dim = args.GetInt("spatial_dim", 2);
+    if(spatial_dim != 2 && spatial_dim != 3)
+        MIOPEN_THROW(miopenStatusBadParm, "Unsupported --spatial_dim");
+
+    // The lists below follow the driver: depth first, and only for 3d problems.
+    const auto dhw = [&](const std::string& prefix, int default_value) {
+        auto ret = std::vector<int>{};
+        if(spatial_dim == 3)
+            ret.push_back(args.GetInt(prefix + "d", default_value));
+        ret.push_back(args.GetInt(prefix + "h", default_value));
+        ret.push_back(args.GetInt(prefix + "w", default_value));
+        return ret;
+    };
+
+    const auto mode_name = args.GetString("mode", "conv");
+    if(mode_name != "conv" && mode_name != "trans")
+        MIOPEN_THROW(miopenStatusBadParm, "Unsupported --mode: " + mode_name);
+    const auto mode = mode_name == "trans" ? miopenTranspose : miopenConvolution;
+
+    const auto pad_mode_name = args.GetString("pad_mode", "default");
+    const auto pad_mode      = pad_mode_name == "same"    ? miopenPaddingSame
+                               : pad_mode_name == "valid" ? miopenPaddingValid
+                                                          : miopenPaddingDefault;
+
+    const auto group_count = std::max(args.GetInt("group_count", 1), 1);
+
+    const auto conv = ConvolutionDescriptor{static_cast<std::size_t>(spatial_dim),
+                                            mode,
+                                            pad_mode,
+                                            dhw("pad_", 0),
+                                            dhw("conv_stride_", 1),
+                                            dhw("dilation_", 1),
+                                            dhw("trans_output_pad_", 0),
+                                            group_count};
+
+    const auto in_channels  = args.GetInt("in_channels", 3);
+    const auto out_channels = args.GetInt("out_channels", 32);
+
+    auto in_lens  = std::vector<int>{args.GetInt("batchsize", 100), in_channels};
+    auto wei_lens = mode == miopenTranspose
+                        ? std::vector<int>{in_channels, out_channels / group_count}
+                        : std::vector<int>{out_channels, in_channels / group_count};
+    for(const auto len : dhw("in_", 32))
+        in_lens.push_back(len);
+    for(const auto len : dhw("fil_", 3))
+        wei_lens.push_back(len);
+
+    const auto x = TensorDescriptor{type, GetLayout(args, "in_layout", spatial_dim), in_lens};
+    const auto w = TensorDescriptor{type, GetLayout(args, "fil_layout", spatial_dim), wei_lens};
+    const auto y = conv.GetForwardOutputTensorWithLayout(
+        x, w, args.GetString("out_layout", spatial_dim == 3 ? "NCDHW" : "NCHW"), type);
+
+    const auto forw = args.GetInt("forw", 0);
+    auto problems   = std::vector<Problem>{};
+
+    for(const auto direction : {miopenProblemDirectionForward,
+                                miopenProblemDirectionBackward,
+                                miopenProblemDirectionBackwardWeights})
+    {
+        if(forw != 0 && (forw & (1 << direction)) == 0)
+            continue;
+
+        auto problem = Problem{};
+        problem.SetOperatorDescriptor(conv);
+        problem.SetDirection(direction);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionX, x);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionW, w);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionY, y);
+        problems.push_back(std::move(problem));
+    }
+
+    return problems;
+}
+
+std::vector<Problem> ParseDriverCommands(std::istream& stream)
+{
+    auto problems = std::vector<Problem>{};
+    std::string line;
+
+    while(std::getline(stream, line))
+    {
+        auto line_problems = ParseDriverCommand(line);
+        std::move(line_problems.begin(), line_problems.end(), std::back_inserter(problems));
+    }
+
+    return problems;
+}
+
+} // namespace miopen
@@ -29,6 +29,7 @@
 #include <miopen/conv/problem_description.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/conv_algo_name.hpp>
+#include <miopen/conv_solution.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/execution_context.hpp>
 #include <miopen/handle.hpp>
@@ -43,6 +44,9 @@
 #include <boost/variant/apply_visitor.hpp>
 #include <boost/hof/match.hpp>
 
+#include <algorithm>
+#include <string>
+
 namespace miopen::debug {
 // Todo: This should be updated when a separate driver command is implemented
 void LogCmdFindConvolution(const miopen::TensorDescriptor& x,
@@ -156,6 +160,132 @@ Problem::FindSolutions(Handle& handle, const FindOptions& options, std::size_t m
     return ret;
 }
 
+namespace {
+
+std::string GetFindKey(const Problem& problem)
+{
+    const auto& conv_desc = boost::get<ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+    const auto& actual    = conv_desc.mode == miopenTranspose ? problem.MakeTransposed() : problem;
+    return actual.AsConvolution().BuildConfKey().ToString();
+}
+
+/// Builds the kernels find would build for the problems, all in one parallel pass. Kernels of
+/// tunable solvers are skipped for exhaustive search, since the search builds its own ones.
+void PrecompileFindCandidates(Handle& handle,
+                              const std::vector<const Problem*>& problems,
+                              bool exhaustive_search)
+{
+    auto candidates = std::vector<solver::ConvSolution>{};
+
+    for(const auto problem : problems)
+    {
+        const auto& conv_desc = boost::get<ConvolutionDescriptor>(problem->GetOperatorDescriptor());
+        const auto& actual =
+            conv_desc.mode == miopenTranspose ? problem->MakeTransposed() : *problem;
+        const auto conv_prob = ProblemDescription{actual.AsConvolution()};
+        auto conv_ctx        = ConvolutionContext{{&handle}};
+        conv_ctx.DetectRocm();
+        conv_ctx.SetupFloats(conv_prob);
+
+        decltype(auto) db = GetDb(conv_ctx);
+
+        for(const auto& id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+        {
+            const auto& s = id.GetSolver();
+            if(s.IsEmpty() || (exhaustive_search && s.IsTunable()))
+                continue;
+
+            try
+            {
+                if(!s.IsApplicable(conv_ctx, conv_prob))
+                    continue;
+                auto solution = s.FindSolution(conv_ctx, conv_prob, db, {});
+                if(solution.Succeeded())
+                    candidates.push_back(std::move(solution));
+            }
+            catch(const Exception& ex)
+            {
+                MIOPEN_LOG_I2(id.ToString() << ": " << ex.what());
+            }
+        }
+    }
+
+    auto pointers = std::vector<const solver::ConvSolution*>{};
+    pointers.reserve(candidates.size());
+    for(const auto& candidate : candidates)
+        pointers.push_back(&candidate);
+
+    solver::PrecompileSolutions(handle, pointers);
+}
+
+} // namespace
+
+std::vector<std::vector<Solution>> FindSolutions(Handle& handle,
+                                                 const std::vector<Problem>& problems,
+                                                 const FindOptions& options,
+                                                 std::size_t max_solutions)
+{
+    // Networks tend to repeat the same layers many times, those are found only once.
+    auto distinct = std::vector<const Problem*>{};
+    auto same_as  = std::vector<std::size_t>(problems.size());
+    auto first    = std::unordered_map<std::string, std::size_t>{};
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        const auto inserted = first.emplace(GetFindKey(problems[i]), i);
+        same_as[i]          = inserted.first->second;
+        if(inserted.second)
+            distinct.push_back(&problems[i]);
+    }
+
+    MIOPEN_LOG_I("Batched find: " << distinct.size() << " distinct of " << problems.size()
+                                  << " problems");
+
+    PrecompileFindCandidates(handle, distinct, options.exhaustive_search);
+
+    // The tensors of all the problems are allocated once, with the size of the largest one.
+    auto shared_options = options;
+    auto owned_buffers  = std::vector<Allocator::ManageDataPtr>{};
+    auto buffer_sizes   = std::unordered_map<miopenTensorArgumentId_t, std::size_t>{};
+
+    for(const auto problem : distinct)
+    {
+        for(const auto& pair : problem->tensor_descriptors)
+        {
+            if(options.preallocated_tensors.count(pair.first) != 0)
+                continue;
+            const auto& descriptor = pair.second;
+            const auto size = descriptor.GetElementSpace() * get_data_size(descriptor.GetType());
+            auto& max_size  = buffer_sizes[pair.first];
+            max_size        = std::max(max_size, size);
+        }
+    }
+
+    for(const auto& pair : buffer_sizes)
+    {
+        auto buffer = handle.Write(std::vector<char>(pair.second));
+        shared_options.preallocated_tensors.emplace(pair.first, buffer.get());
+        owned_buffers.emplace_back(std::move(buffer));
+    }
+
+    auto ret = std::vector<std::vector<Solution>>(problems.size());
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        if(same_as[i] == i)
+        {
+            ret[i] = problems[i].FindSolutions(handle, shared_options, max_solutions);
+            continue;
+        }
+
+        ret[i] = ret[same_as[i]];
+        for(auto& solution : ret[i])
+            solution.SetProblem(problems[i]);
+    }
+
+    return ret;
+}
+
 const TensorDescriptor& Problem::GetTensorDescriptorChecked(miopenTensorArgumentId_t name,
                                                             const std::string& name_str) const
 {
@@ -26,6 +26,7 @@
 
 #include <miopen/ramdb.hpp>
 
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -44,6 +45,18 @@
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_RAMDB_SNAPSHOT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_RAMDB_SNAPSHOT_REFRESH_MS)
+
+static bool IsSnapshotMode() { return miopen::IsEnabled(MIOPEN_RAMDB_SNAPSHOT{}); }
+
+static ramdb_clock::duration GetSnapshotRefreshInterval()
+{
+    static const auto interval =
+        std::chrono::milliseconds{miopen::Value(MIOPEN_RAMDB_SNAPSHOT_REFRESH_MS{}, 1000)};
+    return interval;
+}
+
 std::string RamDb::GetTimeFilePath(const std::string& path) { return path + ".time"; }
 
 static ramdb_clock::time_point GetDbModificationTime(const std::string& path)
@@ -123,6 +136,9 @@ RamDb& RamDb::GetCached(const std::string& path, bool is_system)
 
 boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
 {
+    if(IsSnapshotMode())
+        return FindSnapshotRecord(problem);
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
@@ -155,6 +171,7 @@ bool RamDb::StoreRecord(const DbRecord& record)
 #else
     Prefetch();
 #endif
+    snapshot_stale = true;
     return true;
 }
 
@@ -178,6 +195,7 @@ bool RamDb::UpdateRecord(DbRecord& record)
 #else
     Prefetch();
 #endif
+    snapshot_stale = true;
     return true;
 }
 
@@ -208,7 +226,7 @@ bool RamDb::RemoveRecord(const std::string& key)
 #else
     Prefetch();
 #endif
-
+    snapshot_stale = true;
     return true;
 }
 
@@ -255,7 +273,7 @@ bool RamDb::Remove(const std::string& key, const std::string& id)
 #else
     Prefetch();
 #endif
-
+    snapshot_stale = true;
     return true;
 }
 
@@ -267,19 +285,96 @@ boost::optional<miopen::DbRecord> RamDb::FindRecordUnsafe(const std::string& pro
     if(it == cache.end())
         return boost::none;
 
+    return ParseItem(problem, it->second);
+}
+
+boost::optional<miopen::DbRecord> RamDb::ParseItem(const std::string& problem,
+                                                   const CacheItem& item) const
+{
     auto record = DbRecord{problem};
 
-    if(!record.ParseContents(it->second.content))
+    if(!record.ParseContents(item.content))
     {
         MIOPEN_LOG_E("Error parsing payload under the key: "
-                     << problem << " form file " << GetFileName() << "#" << it->second.line);
-        MIOPEN_LOG_E("Contents: " << it->second.content);
+                     << problem << " form file " << GetFileName() << "#" << item.line);
+        MIOPEN_LOG_E("Contents: " << item.content);
         return boost::none;
     }
 
     return record;
 }
 
+boost::optional<miopen::DbRecord> RamDb::FindSnapshotRecord(const std::string& problem)
+{
+    auto current = std::atomic_load(&snapshot);
+
+    // The writes made since the snapshot was published are in the next one, so that a thread
+    // reads its own writes.
+    if(!current || snapshot_stale)
+    {
+        RefreshSnapshot(true);
+        current = std::atomic_load(&snapshot);
+    }
+    else if(ramdb_clock::now().time_since_epoch().count() - snapshot_check_time >
+            GetSnapshotRefreshInterval().count())
+    {
+        RefreshSnapshot(false);
+        current = std::atomic_load(&snapshot);
+    }
+
+    MIOPEN_LOG_I2("Looking for key " << problem << " in snapshot for file " << GetFileName());
+    const auto it = current->find(problem);
+
+    if(it == current->end())
+        return boost::none;
+
+    return ParseItem(problem, it->second);
+}
+
+void RamDb::RefreshSnapshot(bool wait)
+{
+    auto refresh_lock = std::unique_lock<std::mutex>{refresh_mutex, std::defer_lock};
+
+    if(wait)
+    {
+        refresh_lock.lock();
+    }
+    else
+    {
+        // Another thread is refreshing already, the caller keeps using the current snapshot.
+        if(!refresh_lock.try_lock())
+            return;
+        if(ramdb_clock::now().time_since_epoch().count() - snapshot_check_time <=
+           GetSnapshotRefreshInterval().count())
+            return;
+    }
+
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    SyncSnapshotUnsafe();
+}
+
+void RamDb::SyncSnapshotUnsafe()
+{
+    // The writes since the last snapshot are published together, as each copies the cache.
+    auto cache_changed = snapshot_stale.exchange(false);
+
+    if(!ValidateUnsafe())
+    {
+        MIOPEN_LOG_I2("RamDb file is newer than snapshot, prefetching");
+        Prefetch();
+        cache_changed = true;
+    }
+
+    if(cache_changed || !std::atomic_load(&snapshot))
+    {
+        const auto published = std::make_shared<const Snapshot>(cache.begin(), cache.end());
+        std::atomic_store(&snapshot, published);
+    }
+
+    snapshot_check_time = ramdb_clock::now().time_since_epoch().count();
+}
+
 template <class TFunc>
 static void Measure(const std::string& funcName, TFunc&& func)
 {
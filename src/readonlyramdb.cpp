@@ -25,6 +25,8 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/compiled_db.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
 
@@ -40,6 +42,8 @@
 #include <sstream>
 #include <map>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILED_SYSTEM_DB)
+
 namespace miopen {
 
 namespace debug {
@@ -77,6 +81,56 @@ ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path, bool warn_if_un
     return *instance;
 }
 
+boost::optional<DbRecord> ReadonlyRamDb::FindRecord(const std::string& problem) const
+{
+    if(compiled)
+        return FindCompiledRecord(problem);
+
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+    const auto it = cache.find(problem);
+
+    if(it == cache.end())
+        return boost::none;
+
+    auto record = DbRecord{problem};
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+    MIOPEN_LOG_I2("Contents found: " << it->second.content);
+
+    if(!record.ParseContents(it->second.content))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: "
+                     << problem << " form file " << db_path << "#" << it->second.line);
+        MIOPEN_LOG_E("Contents: " << it->second.content);
+        return boost::none;
+    }
+
+    return record;
+}
+
+boost::optional<DbRecord> ReadonlyRamDb::FindCompiledRecord(const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << compiled->GetName());
+    const auto found = compiled->Find(problem);
+
+    if(found == nullptr)
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+
+    // Ids and values are split by CompiledDb::Compile() and validated by CompiledDb::Find().
+    auto record      = DbRecord{problem};
+    const auto items = compiled->GetItems(*found);
+
+    for(auto i = 0ULL; i < found->item_count; ++i)
+    {
+        record.map.emplace(compiled->GetString(items[i].id_offset, items[i].id_size),
+                           compiled->GetString(items[i].value_offset, items[i].value_size));
+    }
+
+    return record;
+}
+
 template <class TFunc>
 static auto Measure(const std::string& funcName, TFunc&& func)
 {
@@ -126,11 +180,43 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unre
     }
 }
 
+bool ReadonlyRamDb::LoadCompiled()
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_COMPILED_SYSTEM_DB{}))
+        return false;
+
+    // Compiled dbs are not embedded, the text one is parsed instead.
+    constexpr bool isEmbedded = MIOPEN_EMBED_DB;
+    // cppcheck-suppress knownConditionTrueFalse
+    if(!debug::rordb_embed_fs_override() && isEmbedded)
+        return false;
+
+    const auto compiled_path = CompiledDb::GetCompiledPath(db_path);
+    auto db                  = CompiledDb::Open(compiled_path);
+
+    // The text file is preferred if it has been changed after the compilation.
+    if(db && db->IsOutdated(db_path))
+    {
+        MIOPEN_LOG_W("Compiled db " << compiled_path << " is outdated, ignored");
+        db.reset();
+    }
+
+    if(!db)
+        return false;
+
+    MIOPEN_LOG_I2("Using compiled db " << compiled_path << " with " << db->GetRecordCount()
+                                       << " records");
+    compiled = std::move(db);
+    return true;
+}
+
 void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
 {
     Measure("Prefetch", [this, warn_if_unreadable]() {
         if(db_path.empty())
             return;
+        if(LoadCompiled())
+            return;
         constexpr bool isEmbedded = MIOPEN_EMBED_DB;
         // cppcheck-suppress knownConditionTrueFalse
         if(!debug::rordb_embed_fs_override() && isEmbedded)
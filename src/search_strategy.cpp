@@ -0,0 +1,686 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/generic_search_controls.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+const char* GetStrategyName(SearchStrategyKind kind)
+{
+    switch(kind)
+    {
+    case SearchStrategyKind::Exhaustive: return "exhaustive";
+    case SearchStrategyKind::SuccessiveHalving: return "halving";
+    case SearchStrategyKind::Annealing: return "annealing";
+    case SearchStrategyKind::Genetic: return "genetic";
+    case SearchStrategyKind::Bayesian: return "bayesian";
+    }
+    return "<unknown>";
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& stream, SearchStrategyKind kind)
+{
+    return stream << GetStrategyName(kind);
+}
+
+SearchStrategyKind GetTuningSearchStrategy(SearchStrategyKind solver_default)
+{
+    const auto value = GetStringEnv(MIOPEN_DEBUG_TUNING_SEARCH_STRATEGY{});
+    if(value == nullptr)
+        return solver_default;
+    for(const auto kind : {SearchStrategyKind::Exhaustive,
+                           SearchStrategyKind::SuccessiveHalving,
+                           SearchStrategyKind::Annealing,
+                           SearchStrategyKind::Genetic,
+                           SearchStrategyKind::Bayesian})
+    {
+        if(value == std::string{GetStrategyName(kind)})
+            return kind;
+    }
+    MIOPEN_LOG_W("Unknown MIOPEN_DEBUG_TUNING_SEARCH_STRATEGY value: " << value);
+    return solver_default;
+}
+
+ConfigFeatures GetConfigFeatures(const std::string& serialized)
+{
+    ConfigFeatures features;
+    std::istringstream ss(serialized);
+    std::string field;
+    while(std::getline(ss, field, ','))
+        features.push_back(field);
+    return features;
+}
+
+namespace {
+
+std::size_t Distance(const ConfigFeatures& lhs, const ConfigFeatures& rhs)
+{
+    const auto common    = std::min(lhs.size(), rhs.size());
+    std::size_t distance = std::max(lhs.size(), rhs.size()) - common;
+    for(std::size_t i = 0; i < common; ++i)
+        if(lhs[i] != rhs[i])
+            ++distance;
+    return distance;
+}
+
+std::string JoinFeatures(const ConfigFeatures& features, std::size_t skipped_field)
+{
+    std::string key = std::to_string(skipped_field);
+    for(std::size_t i = 0; i < features.size(); ++i)
+    {
+        key += ',';
+        if(i != skipped_field)
+            key += features[i];
+    }
+    return key;
+}
+
+/// Bookkeeping shared by the strategies: which configs were proposed, the results of
+/// regular measurements and an index of configs differing in a single field.
+class SpaceStrategy : public SearchStrategy
+{
+public:
+    SpaceStrategy(std::vector<ConfigFeatures> space_, unsigned seed)
+        : space(std::move(space_)),
+          proposed(space.size(), false),
+          rng(seed),
+          unproposed(space.size()),
+          position(space.size())
+    {
+        std::iota(unproposed.begin(), unproposed.end(), 0);
+        std::iota(position.begin(), position.end(), 0);
+        for(std::size_t idx = 0; idx < space.size(); ++idx)
+        {
+            exact.emplace(JoinFeatures(space[idx], space[idx].size()), idx);
+            for(std::size_t field = 0; field < space[idx].size(); ++field)
+                buckets[JoinFeatures(space[idx], field)].push_back(idx);
+        }
+    }
+
+    bool IsExhausted() const override { return unproposed.empty(); }
+
+    void Replay(std::size_t index, boost::optional<float> time) override
+    {
+        if(proposed[index])
+            return;
+        Observe(Take(index), time);
+    }
+
+    void Observe(const SearchProposal& proposal, boost::optional<float> time) override
+    {
+        if(proposal.repeats != 0)
+            return;
+        if(time)
+            measured.emplace_back(proposal.index, *time);
+    }
+
+protected:
+    std::vector<ConfigFeatures> space;
+    std::vector<bool> proposed;
+    std::vector<std::pair<std::size_t, float>> measured;
+    std::default_random_engine rng;
+
+    SearchProposal Take(std::size_t idx)
+    {
+        proposed[idx]             = true;
+        const auto last           = unproposed.back();
+        unproposed[position[idx]] = last;
+        position[last]            = position[idx];
+        unproposed.pop_back();
+        return {idx, 0};
+    }
+
+    boost::optional<std::size_t> RandomUnproposed()
+    {
+        if(IsExhausted())
+            return boost::none;
+        return PickRandom(unproposed);
+    }
+
+    std::vector<std::size_t> UnproposedNeighbours(const ConfigFeatures& features) const
+    {
+        std::vector<std::size_t> result;
+        for(std::size_t field = 0; field < features.size(); ++field)
+        {
+            const auto bucket = buckets.find(JoinFeatures(features, field));
+            if(bucket == buckets.end())
+                continue;
+            for(const auto idx : bucket->second)
+                if(!proposed[idx])
+                    result.push_back(idx);
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    boost::optional<std::size_t> Find(const ConfigFeatures& features) const
+    {
+        const auto it = exact.find(JoinFeatures(features, features.size()));
+        if(it == exact.end())
+            return boost::none;
+        return it->second;
+    }
+
+    std::size_t RandomIndex(std::size_t size)
+    {
+        return std::uniform_int_distribution<std::size_t>{0, size - 1}(rng);
+    }
+
+    std::size_t PickRandom(const std::vector<std::size_t>& items)
+    {
+        return items[RandomIndex(items.size())];
+    }
+
+    std::vector<std::pair<std::size_t, float>> Best(std::size_t count) const
+    {
+        std::vector<std::pair<std::size_t, float>> best(std::min(count, measured.size()));
+        std::partial_sort_copy(measured.begin(),
+                               measured.end(),
+                               best.begin(),
+                               best.end(),
+                               [](const auto& lhs, const auto& rhs) {
+                                   return lhs.second < rhs.second;
+                               });
+        return best;
+    }
+
+private:
+    std::vector<std::size_t> unproposed;
+    std::vector<std::size_t> position;
+    std::unordered_map<std::string, std::size_t> exact;
+    std::unordered_map<std::string, std::vector<std::size_t>> buckets;
+};
+
+class ExhaustiveStrategy : public SearchStrategy
+{
+public:
+    explicit ExhaustiveStrategy(std::size_t n_configs)
+        : replayed(n_configs, false), n_remaining(n_configs)
+    {
+    }
+
+    boost::optional<SearchProposal> Propose() override
+    {
+        if(IsExhausted())
+            return boost::none;
+        while(replayed[next])
+            ++next;
+        --n_remaining;
+        return SearchProposal{next++, 0};
+    }
+
+    void Observe(const SearchProposal&, boost::optional<float>) override {}
+    bool IsExhausted() const override { return n_remaining == 0; }
+
+    void Replay(std::size_t index, boost::optional<float>) override
+    {
+        if(index < next || replayed[index])
+            return;
+        replayed[index] = true;
+        --n_remaining;
+    }
+
+private:
+    std::vector<bool> replayed;
+    std::size_t n_remaining;
+    std::size_t next = 0;
+};
+
+/// Measures a sample of configs with a single run, then keeps re-measuring the best third of
+/// them with three times more runs. The survivors of 9 runs get the regular measurement.
+class SuccessiveHalvingStrategy : public SearchStrategy
+{
+public:
+    SuccessiveHalvingStrategy(std::size_t n_configs, std::size_t budget_, unsigned seed)
+        : rung(n_configs), replayed(n_configs, false), budget(budget_)
+    {
+        std::iota(rung.begin(), rung.end(), 0);
+        std::shuffle(rung.begin(), rung.end(), std::default_random_engine{seed});
+    }
+
+    boost::optional<SearchProposal> Propose() override
+    {
+        if(!started)
+            Start();
+        if(next == rung.size())
+            return boost::none;
+        return SearchProposal{rung[next++], repeats};
+    }
+
+    void Observe(const SearchProposal& proposal, boost::optional<float> time) override
+    {
+        if(proposal.repeats != repeats)
+            return;
+        if(time)
+            results.emplace_back(proposal.index, *time);
+        if(++n_observed < rung.size() || repeats == 0)
+            return;
+
+        std::sort(results.begin(), results.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second < rhs.second;
+        });
+        results.resize(std::min(results.size(), (rung.size() + eta - 1) / eta));
+        MIOPEN_LOG_I2("Successive halving: " << results.size() << " of " << rung.size()
+                                             << " configs survive " << repeats << " run(s)");
+
+        rung.clear();
+        for(const auto& result : results)
+            rung.push_back(result.first);
+        results.clear();
+        next       = 0;
+        n_observed = 0;
+        repeats    = (rung.size() <= eta || repeats == max_repeats) ? 0 : repeats * eta;
+    }
+
+    bool IsExhausted() const override
+    {
+        return started && repeats == 0 && next == rung.size();
+    }
+
+    void Replay(std::size_t index, boost::optional<float>) override
+    {
+        // The result is already known, so the config does not need screening.
+        if(started || replayed[index])
+            return;
+        replayed[index] = true;
+        if(budget != 0)
+            --budget;
+    }
+
+private:
+    static constexpr std::size_t eta         = 3;
+    static constexpr std::size_t max_repeats = eta * eta;
+    std::vector<std::size_t> rung;
+    std::vector<bool> replayed;
+    std::size_t budget;
+    bool started = false;
+    std::vector<std::pair<std::size_t, float>> results;
+    std::size_t next       = 0;
+    std::size_t n_observed = 0;
+    std::size_t repeats    = 1;
+
+    void Start()
+    {
+        started = true;
+        rung.erase(std::remove_if(rung.begin(),
+                                  rung.end(),
+                                  [&](std::size_t idx) { return replayed[idx]; }),
+                   rung.end());
+        // The sum of all rungs is below 3/2 of the first one, plus rounding.
+        const auto n_first = budget > 4 ? (budget - 4) * 2 / 3 : 1;
+        rung.resize(std::min(rung.size(), n_first));
+        if(rung.size() <= eta)
+            repeats = 0;
+    }
+};
+
+class AnnealingStrategy : public SpaceStrategy
+{
+public:
+    using SpaceStrategy::SpaceStrategy;
+
+    boost::optional<SearchProposal> Propose() override
+    {
+        if(current)
+        {
+            // Go back to the best config if the walk does not improve for a while.
+            if(n_stalled > 2 * space[*current].size() + 4)
+            {
+                current      = best;
+                current_time = best_time;
+                n_stalled    = 0;
+            }
+            const auto neighbours = UnproposedNeighbours(space[*current]);
+            if(!neighbours.empty())
+                return Take(PickRandom(neighbours));
+        }
+        const auto idx = RandomUnproposed();
+        if(!idx)
+            return boost::none;
+        return Take(*idx);
+    }
+
+    void Observe(const SearchProposal& proposal, boost::optional<float> time) override
+    {
+        SpaceStrategy::Observe(proposal, time);
+        temperature = std::max(temperature * cooling, min_temperature);
+        ++n_stalled;
+        if(!time)
+            return;
+        if(!best || *time < best_time)
+        {
+            best      = proposal.index;
+            best_time = *time;
+            n_stalled = 0;
+        }
+        const auto worse_by = current ? *time / current_time - 1.0f : 0.0f;
+        if(worse_by <= 0.0f ||
+           std::uniform_real_distribution<float>{}(rng) < std::exp(-worse_by / temperature))
+        {
+            current      = proposal.index;
+            current_time = *time;
+        }
+    }
+
+private:
+    static constexpr float cooling         = 0.97f;
+    static constexpr float min_temperature = 1e-3f;
+    float temperature                      = 0.1f;
+    boost::optional<std::size_t> current;
+    float current_time = 0.0f;
+    boost::optional<std::size_t> best;
+    float best_time       = 0.0f;
+    std::size_t n_stalled = 0;
+};
+
+class GeneticStrategy : public SpaceStrategy
+{
+public:
+    using SpaceStrategy::SpaceStrategy;
+
+    boost::optional<SearchProposal> Propose() override
+    {
+        if(measured.size() >= population)
+        {
+            const auto parents = Best(population);
+            for(auto attempt = 0; attempt < 8; ++attempt)
+            {
+                const auto& lhs = space[Select(parents)];
+                const auto& rhs = space[Select(parents)];
+                auto child      = lhs;
+                for(std::size_t i = 0; i < std::min(lhs.size(), rhs.size()); ++i)
+                    if(std::bernoulli_distribution{0.5}(rng))
+                        child[i] = rhs[i];
+                if(!child.empty() && std::bernoulli_distribution{mutation}(rng))
+                {
+                    const auto field  = RandomIndex(child.size());
+                    const auto& donor = space[RandomIndex(space.size())];
+                    if(field < donor.size())
+                        child[field] = donor[field];
+                }
+                const auto idx = Find(child);
+                if(idx && !proposed[*idx])
+                    return Take(*idx);
+                const auto neighbours = UnproposedNeighbours(child);
+                if(!neighbours.empty())
+                    return Take(PickRandom(neighbours));
+            }
+        }
+        const auto idx = RandomUnproposed();
+        if(!idx)
+            return boost::none;
+        return Take(*idx);
+    }
+
+private:
+    static constexpr std::size_t population = 16;
+    static constexpr double mutation        = 0.3;
+
+    /// Tournament of two.
+    std::size_t Select(const std::vector<std::pair<std::size_t, float>>& parents)
+    {
+        const auto& a = parents[RandomIndex(parents.size())];
+        const auto& b = parents[RandomIndex(parents.size())];
+        return a.second <= b.second ? a.first : b.first;
+    }
+};
+
+/// Predicts the kernel time as a distance-weighted mean over the nearest measured configs
+/// and proposes the candidate with the lowest prediction, minus a bonus for being far from
+/// anything measured.
+class BayesianStrategy : public SpaceStrategy
+{
+public:
+    using SpaceStrategy::SpaceStrategy;
+
+    boost::optional<SearchProposal> Propose() override
+    {
+        if(measured.size() < n_initial)
+        {
+            const auto idx = RandomUnproposed();
+            if(!idx)
+                return boost::none;
+            return Take(*idx);
+        }
+
+        // The model only looks at the fastest configs, which keeps proposals cheap in large
+        // spaces and is where the accuracy matters.
+        const auto reference = Best(n_reference);
+        std::vector<std::size_t> pool;
+        for(const auto& good : Best(4))
+        {
+            const auto neighbours = UnproposedNeighbours(space[good.first]);
+            pool.insert(pool.end(), neighbours.begin(), neighbours.end());
+        }
+        while(pool.size() < pool_size)
+        {
+            const auto idx = RandomUnproposed();
+            if(!idx)
+                break;
+            pool.push_back(*idx);
+        }
+        if(pool.empty())
+            return boost::none;
+
+        float mean = 0.0f;
+        for(const auto& m : reference)
+            mean += std::log(m.second);
+        mean /= reference.size();
+        float spread = 0.0f;
+        for(const auto& m : reference)
+            spread += (std::log(m.second) - mean) * (std::log(m.second) - mean);
+        spread = std::sqrt(spread / reference.size());
+
+        auto best_score    = std::numeric_limits<float>::max();
+        std::size_t chosen = pool.front();
+        for(const auto idx : pool)
+        {
+            if(proposed[idx])
+                continue;
+            const auto score = Predict(idx, reference, spread);
+            if(score < best_score)
+            {
+                best_score = score;
+                chosen     = idx;
+            }
+        }
+        return Take(chosen);
+    }
+
+private:
+    static constexpr std::size_t n_initial = 8;
+    static constexpr std::size_t n_reference = 128;
+    static constexpr std::size_t pool_size   = 32;
+    static constexpr std::size_t k_nearest   = 3;
+
+    float Predict(std::size_t idx,
+                  const std::vector<std::pair<std::size_t, float>>& reference,
+                  float spread) const
+    {
+        std::vector<std::pair<std::size_t, float>> nearest;
+        nearest.reserve(reference.size());
+        for(const auto& m : reference)
+            nearest.emplace_back(Distance(space[idx], space[m.first]), std::log(m.second));
+        const auto k = std::min(k_nearest, nearest.size());
+        std::partial_sort(nearest.begin(),
+                          nearest.begin() + k,
+                          nearest.end(),
+                          [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        float weighted = 0.0f;
+        float weights  = 0.0f;
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            const auto weight = 1.0f / (1.0f + nearest[i].first);
+            weighted += weight * nearest[i].second;
+            weights += weight;
+        }
+        const auto n_fields    = std::max<std::size_t>(space[idx].size(), 1);
+        const auto uncertainty = static_cast<float>(nearest.front().first) / n_fields;
+        return weighted / weights - uncertainty * spread;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(SearchStrategyKind kind,
+                                                   std::vector<ConfigFeatures> space,
+                                                   std::size_t budget,
+                                                   unsigned seed)
+{
+    switch(kind)
+    {
+    case SearchStrategyKind::Exhaustive:
+        return std::make_unique<ExhaustiveStrategy>(space.size());
+    case SearchStrategyKind::SuccessiveHalving:
+        return std::make_unique<SuccessiveHalvingStrategy>(space.size(), budget, seed);
+    case SearchStrategyKind::Annealing:
+        return std::make_unique<AnnealingStrategy>(std::move(space), seed);
+    case SearchStrategyKind::Genetic:
+        return std::make_unique<GeneticStrategy>(std::move(space), seed);
+    case SearchStrategyKind::Bayesian:
+        return std::make_unique<BayesianStrategy>(std::move(space), seed);
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown search strategy");
+}
+
+TuningSearch::TuningSearch(std::unique_ptr<SearchStrategy> strategy_, std::size_t budget_)
+    : strategy(std::move(strategy_)), budget(budget_)
+{
+}
+
+boost::optional<PendingProposal> TuningSearch::Next()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while(budget != 0 && !strategy->IsExhausted())
+    {
+        const auto proposal = strategy->Propose();
+        if(proposal)
+        {
+            --budget;
+            ++in_flight;
+            return PendingProposal{*this, *proposal};
+        }
+        // The strategy waits for results, but there is nothing left to report them.
+        if(in_flight == 0)
+            break;
+        reported.wait(lock);
+    }
+    return boost::none;
+}
+
+void TuningSearch::Replay(std::size_t index, boost::optional<float> time)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(budget != 0)
+        --budget;
+    strategy->Replay(index, time);
+}
+
+bool TuningSearch::IsComplete()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return in_flight == 0 && (budget == 0 || strategy->IsExhausted());
+}
+
+void TuningSearch::Report(const SearchProposal& proposal, boost::optional<float> time)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        --in_flight;
+        strategy->Observe(proposal, time);
+    }
+    reported.notify_all();
+}
+
+PendingProposal::PendingProposal(TuningSearch& search_, const SearchProposal& proposal_)
+    : search(&search_), proposal(proposal_)
+{
+}
+
+PendingProposal::PendingProposal(PendingProposal&& other) noexcept
+    : search(std::exchange(other.search, nullptr)), proposal(other.proposal)
+{
+}
+
+PendingProposal& PendingProposal::operator=(PendingProposal&& other) noexcept
+{
+    if(this != &other)
+    {
+        Drop();
+        search   = std::exchange(other.search, nullptr);
+        proposal = other.proposal;
+    }
+    return *this;
+}
+
+PendingProposal::~PendingProposal() { Drop(); }
+
+void PendingProposal::Drop() noexcept
+{
+    if(search == nullptr)
+        return;
+    try
+    {
+        std::exchange(search, nullptr)->Report(proposal, boost::none);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to report dropped config #" << proposal.index << ": " << ex.what());
+    }
+}
+
+void PendingProposal::Report(boost::optional<float> time)
+{
+    assert(search != nullptr);
+    const auto reported_to = std::exchange(search, nullptr);
+    reported_to->Report(proposal, time);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -35,6 +35,8 @@
 
 #include <boost/hof/match.hpp>
 
+#include <algorithm>
+
 namespace miopen::debug {
 // Todo: This should be updated when a separate driver command is implemented
 void LogCmdConvolution(const miopen::TensorDescriptor& x,
@@ -85,6 +87,67 @@ void Solution::LogDriverCommand(const ConvolutionDescriptor& conv_desc) const
         x_desc, w_desc, conv_desc, y_desc, problem.GetDirection(), solver.Value());
 }
 
+void Solution::EmbedKernels(Handle& handle)
+{
+    const auto embed = boost::hof::match(
+        [&](const ConvolutionDescriptor& op_desc) { EmbedKernels(handle, op_desc); });
+
+    boost::apply_visitor(embed, problem.GetOperatorDescriptor());
+    serialization_cache.clear();
+}
+
+void Solution::EmbedKernels(Handle& handle, const ConvolutionDescriptor& conv_desc)
+{
+    const auto problem_ =
+        conv_desc.mode == miopenTranspose ? GetProblem().MakeTransposed() : GetProblem();
+    const auto conv_prob = ProblemDescription{problem_.AsConvolution()};
+    auto conv_ctx        = ConvolutionContext{{&handle}};
+    conv_ctx.DetectRocm();
+    conv_ctx.SetupFloats(conv_prob);
+
+    decltype(auto) db   = GetDb(conv_ctx);
+    const auto& solver_ = GetSolver().GetSolver();
+    if(!perf_cfg.has_value())
+        perf_cfg = solver_.GetPerfCfgParams(conv_ctx, conv_prob, db);
+    const auto conv_solution = solver_.FindSolution(conv_ctx, conv_prob, db, {}, *perf_cfg);
+
+    kernels_target = handle.GetTargetProperties().DbId();
+    kernels.clear();
+
+    for(const auto& k : conv_solution.construction_params)
+    {
+        const auto duplicate = std::any_of(kernels.begin(), kernels.end(), [&](auto&& e) {
+            return e.program == k.kernel_file && e.options == k.comp_options;
+        });
+        if(duplicate)
+            continue;
+        auto binary = handle.GetProgramBinary(k.kernel_file, k.comp_options);
+        kernels.push_back({k.kernel_file, k.comp_options, std::move(binary)});
+    }
+
+    MIOPEN_LOG_I2("Embedded " << kernels.size() << " kernel(s) of " << GetSolver().ToString());
+}
+
+void Solution::LoadKernels(const Handle& handle) const
+{
+    if(kernels.empty())
+        return;
+
+    if(kernels_target != handle.GetTargetProperties().DbId())
+    {
+        MIOPEN_LOG_W("Kernels of " << GetSolver().ToString() << " were built for "
+                                   << kernels_target << " and are ignored on "
+                                   << handle.GetTargetProperties().DbId());
+        return;
+    }
+
+    for(const auto& kernel : kernels)
+    {
+        if(!handle.HasProgram(kernel.program, kernel.options))
+            handle.AddProgramBinary(kernel.program, kernel.options, kernel.binary);
+    }
+}
+
 void Solution::RunImpl(Handle& handle,
                        const std::unordered_map<miopenTensorArgumentId_t, RunInput>& inputs,
                        Data_t workspace,
@@ -191,6 +254,8 @@ void Solution::RunImpl(Handle& handle,
         return;
     }
 
+    LoadKernels(handle);
+
     const auto conv_prob = ProblemDescription{conv_problem};
     auto conv_ctx        = ConvolutionContext{{&handle}};
     conv_ctx.DetectRocm();
@@ -247,6 +312,21 @@ void to_json(nlohmann::json& json, const Solution& solution)
 
     if(solution.perf_cfg.has_value())
         json["perf_cfg"] = *solution.perf_cfg;
+
+    if(!solution.kernels.empty())
+    {
+        auto kernels = nlohmann::json::array();
+        for(const auto& kernel : solution.kernels)
+        {
+            kernels.push_back({
+                {"program", kernel.program},
+                {"options", kernel.options},
+                {"binary",
+                 nlohmann::json::binary({kernel.binary.begin(), kernel.binary.end()})},
+            });
+        }
+        json["kernels"] = {{"target", solution.kernels_target}, {"list", std::move(kernels)}};
+    }
 }
 
 void from_json(const nlohmann::json& json, Solution& solution)
@@ -273,5 +353,20 @@ void from_json(const nlohmann::json& json, Solution& solution)
     solution.perf_cfg        = perf_cfg_json != json.end()
                                    ? std::optional{perf_cfg_json->get<std::string>()}
                                    : std::nullopt;
+
+    solution.kernels_target.clear();
+    solution.kernels.clear();
+    const auto kernels_json = json.find("kernels");
+    if(kernels_json != json.end())
+    {
+        kernels_json->at("target").get_to(solution.kernels_target);
+        for(const auto& kernel : kernels_json->at("list"))
+        {
+            const auto& binary = kernel.at("binary").get_binary();
+            solution.kernels.push_back({kernel.at("program").get<std::string>(),
+                                        kernel.at("options").get<std::string>(),
+                                        {binary.begin(), binary.end()}});
+        }
+    }
 }
 } // namespace miopen
@@ -41,6 +41,7 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
+#include <set>
 
 namespace miopen {
 namespace solver {
@@ -61,14 +62,15 @@ std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<Kernel
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
 
+    // Compilations take very different times, so they are handed out one at a time.
     // clang-format off
-    par_for_strided(kernels.size(),
-                    // max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
-                    max_threads{GetTuningThreadsMax()},
-                    [&](auto i) {
-                        const KernelInfo& k = kernels[i];
-                        programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
-                    });
+    par_for(kernels.size(),
+            // max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
+            max_threads{GetTuningThreadsMax()},
+            [&](auto i) {
+                const KernelInfo& k = kernels[i];
+                programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+            });
     // clang-format on
     ct.Log("PrecompileKernels");
     return programs;
@@ -76,8 +78,10 @@ std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<Kernel
 
 void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols)
 {
-    // Find all kernels that need to be compiled from the solutions
+    // Find all kernels that need to be compiled from the solutions. Solutions often share
+    // kernels, so each one is compiled only once.
     std::vector<KernelInfo> kernels;
+    std::set<std::pair<std::string, std::string>> unique;
     for(auto&& sol : sols)
     {
         if(!sol->Succeeded())
@@ -86,6 +90,8 @@ void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>
         {
             if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
                 continue;
+            if(!unique.emplace(kernel.kernel_file, kernel.comp_options).second)
+                continue;
             kernels.push_back(kernel);
         }
     }
@@ -370,6 +370,13 @@ int SQLite::Statement::BindInt64(int idx, const int64_t num)
     return 0;
 }
 
+void SQLite::Statement::Reset()
+{
+    // sqlite3_reset() repeats the error of the last step, which has been reported already.
+    std::ignore = sqlite3_reset(pImpl->ptrStmt.get());
+    sqlite3_clear_bindings(pImpl->ptrStmt.get());
+}
+
 SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system_)
     : SQLiteBase(filename_, is_system_)
 {
@@ -453,4 +460,130 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system_)
         }
     }
 }
+
+bool SQLitePerfDb::ExecuteUpdate(const PendingUpdate& update)
+{
+    {
+        auto stmt = SQLite::Statement{sql, update.config_query, update.config_values};
+        auto rc   = stmt.Step(sql);
+        if(rc != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "Failed to insert config: " + sql.ErrorMessage());
+        auto cnt = sql.Changes();
+        MIOPEN_LOG_I2(cnt << " rows updated");
+    }
+    {
+        auto stmt = SQLite::Statement{sql, update.perf_query, update.perf_values};
+        auto rc   = stmt.Step(sql);
+        if(rc != SQLITE_DONE)
+        {
+            MIOPEN_LOG_E("Failed to insert performance record in the database: " +
+                         sql.ErrorMessage());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SQLitePerfDb::DeferUpdate(const std::string& key,
+                               const std::string& id,
+                               const PendingUpdate& update)
+{
+    const std::lock_guard<std::mutex> lock{batch->mutex};
+    const auto thread = batch->threads.find(std::this_thread::get_id());
+    if(thread == batch->threads.end())
+        return false;
+    thread->second.updates[key][id] = update;
+    return true;
+}
+
+void SQLitePerfDb::MergeDeferred(const std::string& key, DbRecord& record)
+{
+    const std::lock_guard<std::mutex> lock{batch->mutex};
+    const auto thread = batch->threads.find(std::this_thread::get_id());
+    if(thread == batch->threads.end())
+        return;
+    const auto it = thread->second.updates.find(key);
+    if(it == thread->second.updates.end())
+        return;
+    // perf_values end with the solver id and the serialized params
+    for(const auto& update : it->second)
+        record.SetValues(update.first, update.second.perf_values.back());
+}
+
+void SQLitePerfDb::DropDeferred(const std::string& key, const std::string* id)
+{
+    const std::lock_guard<std::mutex> lock{batch->mutex};
+    const auto thread = batch->threads.find(std::this_thread::get_id());
+    if(thread == batch->threads.end())
+        return;
+    const auto it = thread->second.updates.find(key);
+    if(it == thread->second.updates.end())
+        return;
+    if(id == nullptr)
+        thread->second.updates.erase(it);
+    else
+        it->second.erase(*id);
+}
+
+DbWriteSession SQLitePerfDb::BeginWriteSession()
+{
+    if(dbInvalid || (!is_system && DisableUserDbFileIO))
+        return {};
+    // The session ends the batch of the thread that began it, even if destroyed elsewhere.
+    const auto thread = std::this_thread::get_id();
+    {
+        const std::lock_guard<std::mutex> lock{batch->mutex};
+        ++batch->threads[thread].sessions;
+    }
+    return DbWriteSession{[this, thread]() { EndWriteSession(thread); }};
+}
+
+void SQLitePerfDb::EndWriteSession(std::thread::id thread)
+{
+    auto updates = PendingUpdates{};
+    {
+        const std::lock_guard<std::mutex> lock{batch->mutex};
+        const auto it = batch->threads.find(thread);
+        assert(it != batch->threads.end() && it->second.sessions > 0);
+        if(--it->second.sessions != 0)
+            return;
+        std::swap(updates, it->second.updates);
+        batch->threads.erase(it);
+    }
+    if(updates.empty())
+        return;
+
+    std::size_t count = 0;
+    const std::lock_guard<std::mutex> lock{batch->transaction_mutex};
+    try
+    {
+        // Take the write lock right away rather than upgrading a read lock mid-transaction.
+        sql.Exec("BEGIN IMMEDIATE;");
+        try
+        {
+            for(const auto& config : updates)
+            {
+                for(const auto& update : config.second)
+                {
+                    if(ExecuteUpdate(update.second))
+                        ++count;
+                }
+            }
+            sql.Exec("COMMIT;");
+        }
+        catch(...)
+        {
+            sql.Exec("ROLLBACK;");
+            throw;
+        }
+        MIOPEN_LOG_I2("Committed " << count << " deferred perf db records to " << filename);
+    }
+    catch(const std::exception& ex)
+    {
+        // Runs from a destructor, so the error is reported but not propagated.
+        MIOPEN_LOG_E("Failed to commit deferred perf db records to " << filename << ": "
+                                                                     << ex.what());
+    }
+}
 } // namespace miopen
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/tmp_dir.hpp>
+#include <miopen/compiler_workers.hpp>
 #include <miopen/env.hpp>
 #include <boost/filesystem.hpp>
 #include <miopen/errors.hpp>
@@ -66,6 +67,15 @@ void TmpDir::Execute(std::string exe, std::string args) const
     {
         MIOPEN_LOG_I2(this->path.string());
     }
+#ifndef MIOPEN_USE_CLANG_TIDY
+    if(CompilerWorkers::IsAvailable())
+    {
+        const auto cmd = exe + " " + args;
+        if(CompilerWorkers::Get().Run(cmd, this->path) != 0)
+            MIOPEN_THROW("Can't execute " + cmd);
+        return;
+    }
+#endif
     std::string cd  = "cd " + this->path.string() + "; ";
     std::string cmd = cd + exe + " " + args; // + " > /dev/null";
     SystemCmd(cmd);
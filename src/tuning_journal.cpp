@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tuning_journal.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_JOURNAL)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+const std::string failed_value = "failed"; // NOLINT (cert-err58-cpp)
+} // namespace
+
+TuningJournal::TuningJournal(boost::filesystem::path path_, std::string key_)
+    : path(std::move(path_)), key(std::move(key_))
+{
+    std::ifstream in(path.string());
+    if(!in)
+        return;
+
+    std::string line;
+    if(!std::getline(in, line) || line != key)
+    {
+        MIOPEN_LOG_W("Tuning journal " << path << " belongs to another search, ignored");
+        return;
+    }
+    is_resumed = true;
+
+    while(std::getline(in, line))
+    {
+        // A line without the end-of-line has been cut off by termination of the process.
+        if(in.eof())
+            break;
+        const auto separator = line.rfind('=');
+        if(separator == std::string::npos)
+            continue;
+        const auto config = line.substr(0, separator);
+        const auto value  = line.substr(separator + 1);
+        if(value == failed_value)
+        {
+            entries[config] = boost::none;
+            continue;
+        }
+        char* end       = nullptr;
+        const auto time = std::strtof(value.c_str(), &end);
+        if(end == value.c_str() || *end != '\0')
+            continue;
+        entries[config] = time;
+    }
+    MIOPEN_LOG_I("Tuning journal " << path << ": " << entries.size() << " measurements loaded");
+}
+
+std::unique_ptr<TuningJournal> TuningJournal::Open(const std::string& key)
+{
+    const auto& udb = GetUserDbPath();
+    if(DisableUserDbFileIO || udb.empty() || IsDisabled(MIOPEN_DEBUG_TUNING_JOURNAL{}))
+        return nullptr;
+    const auto directory = boost::filesystem::path(udb) / "tuning";
+    return std::make_unique<TuningJournal>(directory / (md5(key) + ".journal"), key);
+}
+
+boost::optional<boost::optional<float>> TuningJournal::Find(const std::string& config) const
+{
+    const auto it = entries.find(config);
+    if(it == entries.end())
+        return boost::none;
+    return it->second;
+}
+
+void TuningJournal::Append(const std::string& config, boost::optional<float> time)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[config] = time;
+
+    if(!file.is_open())
+    {
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(path.parent_path(), ec);
+        // A file of another search is overwritten.
+        const auto is_new = !is_resumed || !boost::filesystem::exists(path);
+        file.open(path.string(), is_new ? std::ios::trunc : std::ios::app);
+        if(!file)
+        {
+            MIOPEN_LOG_W("Unable to write tuning journal " << path);
+            return;
+        }
+        if(is_new)
+            file << key << '\n';
+    }
+
+    if(time)
+        file << config << '=' << *time << '\n';
+    else
+        file << config << '=' << failed_value << '\n';
+    file.flush();
+}
+
+void TuningJournal::Remove()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    file.close();
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+    entries.clear();
+    is_resumed = false;
+}
+
+} // namespace solver
+} // namespace miopen
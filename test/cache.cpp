@@ -27,9 +27,16 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/kern_db.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/tmp_dir.hpp>
 
 #include <miopen/md5.hpp>
 #include "test.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <ctime>
+#include <fstream>
+#include <vector>
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 #include "random.hpp"
 #endif
@@ -89,6 +96,38 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_lz4()
+{
+    std::string decompressed_str;
+    bool success = true;
+    EXPECT(miopen::lz4::compress("", &success).empty());
+    EXPECT(!success);
+
+    auto orig_str = std::string{};
+    for(auto i = 0; i < 64; ++i)
+        orig_str += random_string(GET_RAND() % 64 + 1);
+    orig_str += orig_str;
+    orig_str += std::string(300, 'a');
+
+    const auto compressed_str = miopen::lz4::compress(orig_str, &success);
+    EXPECT(success);
+    EXPECT(compressed_str.size() < orig_str.size());
+    EXPECT(miopen::lz4::decompress(compressed_str, orig_str.size()) == orig_str);
+
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() { decompressed_str = miopen::lz4::decompress(compressed_str, 10); }));
+    // NOLINTNEXTLINE (bugprone-assignment-in-if-condition)
+    CHECK(throws([&]() {
+        decompressed_str =
+            miopen::lz4::decompress(compressed_str.substr(0, compressed_str.size() / 2), 8192);
+    }));
+
+    // Random data does not shrink and is stored as is.
+    const auto random_str = std::string{random_string(512)};
+    EXPECT(miopen::lz4::compress(random_str, &success) == random_str);
+    EXPECT(!success);
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -113,6 +152,30 @@ void check_kern_db()
         CHECK(!clean_db.FindRecordUnsafe(cfg0));
     }
 
+    {
+        // Prepared statements are reused across records; values are bound, not inlined.
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb reuse_db(std::string(temp_file), false);
+
+        miopen::KernelConfig cfg1;
+        cfg1.kernel_name = "kernel'2";
+        cfg1.kernel_args = "-DQUOTE='1' " + random_string(64);
+        cfg1.kernel_blob = random_string(1024);
+
+        for(auto i = 0; i < 3; ++i)
+        {
+            CHECK(reuse_db.StoreRecordUnsafe(cfg0));
+            CHECK(reuse_db.StoreRecordUnsafe(cfg1));
+            CHECK(reuse_db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+            CHECK(reuse_db.FindRecordUnsafe(cfg1).get() == cfg1.kernel_blob);
+            CHECK(reuse_db.RemoveRecordUnsafe(cfg0));
+            CHECK(!reuse_db.FindRecordUnsafe(cfg0));
+            CHECK(reuse_db.FindRecordUnsafe(cfg1));
+            CHECK(reuse_db.RemoveRecordUnsafe(cfg1));
+            CHECK(!reuse_db.FindRecordUnsafe(cfg1));
+        }
+    }
+
     {
         miopen::TempFile temp_file("tmp-kerndb");
         miopen::KernDb err_db(
@@ -134,6 +197,136 @@ void check_kern_db()
         CHECK(err_db.FindRecordUnsafe(cfg0));
         CHECK(err_db.RemoveRecordUnsafe(cfg0));
     }
+
+    miopen::KernelConfig cfg_lz4;
+    cfg_lz4.kernel_name = "kernel3";
+    cfg_lz4.kernel_args = random_string(64);
+    for(auto i = 0; i < 128; ++i)
+        cfg_lz4.kernel_blob += cfg_lz4.kernel_args;
+
+    {
+        // The codec is stored per record, so records of both codecs are read back.
+        miopen::TempFile temp_file("tmp-kerndb");
+        {
+            miopen::KernDb bz2_db(std::string(temp_file), false, miopen::KernelCodec::Bzip2);
+            CHECK(bz2_db.StoreRecordUnsafe(cfg0));
+        }
+
+        miopen::KernDb lz4_db(std::string(temp_file), false, miopen::KernelCodec::Lz4);
+        CHECK(lz4_db.StoreRecordUnsafe(cfg_lz4));
+        CHECK(lz4_db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+        CHECK(lz4_db.FindRecordUnsafe(cfg_lz4).get() == cfg_lz4.kernel_blob);
+
+        miopen::KernDb bz2_db(std::string(temp_file), false, miopen::KernelCodec::Bzip2);
+        CHECK(bz2_db.FindRecordUnsafe(cfg_lz4).get() == cfg_lz4.kernel_blob);
+    }
+
+    {
+        // Databases created before the codec column are upgraded on open.
+        miopen::TempFile temp_file("tmp-kerndb");
+        {
+            const auto sql = miopen::SQLite{std::string(temp_file), false};
+            sql.Exec("CREATE TABLE `kern_db` (`id` INTEGER PRIMARY KEY ASC"
+                     ",`kernel_name` TEXT NOT NULL,`kernel_args` TEXT NOT NULL"
+                     ",`kernel_blob` BLOB NOT NULL,`kernel_hash` TEXT NOT NULL"
+                     ",`uncompressed_size` INT NOT NULL);");
+            auto stmt = miopen::SQLite::Statement{
+                sql,
+                "INSERT INTO `kern_db` (kernel_name, kernel_args, kernel_blob, kernel_hash, "
+                "uncompressed_size) VALUES(?, ?, ?, ?, ?);"};
+            stmt.BindText(1, cfg0.kernel_name);
+            stmt.BindText(2, cfg0.kernel_args);
+            stmt.BindBlob(3, miopen::compress(cfg0.kernel_blob));
+            stmt.BindText(4, miopen::md5(cfg0.kernel_blob));
+            stmt.BindInt64(5, cfg0.kernel_blob.size());
+            CHECK(stmt.Step(sql) == SQLITE_DONE);
+        }
+
+        miopen::KernDb legacy_db(std::string(temp_file), false, miopen::KernelCodec::Lz4);
+        CHECK(legacy_db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+        CHECK(legacy_db.StoreRecordUnsafe(cfg_lz4));
+        CHECK(legacy_db.FindRecordUnsafe(cfg_lz4).get() == cfg_lz4.kernel_blob);
+
+        // Compaction moves the inline code object to the blob table...
+        auto stats = legacy_db.Compact();
+        CHECK(stats.moved == 1);
+        CHECK(stats.removed == 0);
+        CHECK(legacy_db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+
+        // ...drops the ones no record refers to...
+        CHECK(legacy_db.RemoveRecordUnsafe(cfg0));
+        stats = legacy_db.Compact();
+        CHECK(stats.moved == 0);
+        CHECK(stats.removed == 1);
+
+        // ...and recompresses the rest on request.
+        stats = legacy_db.Compact(miopen::KernelCodec::Bzip2);
+        CHECK(stats.recompressed == 1);
+        CHECK(legacy_db.FindRecordUnsafe(cfg_lz4).get() == cfg_lz4.kernel_blob);
+        CHECK(legacy_db.Compact(miopen::KernelCodec::Bzip2).recompressed == 0);
+    }
+
+    {
+        // Identical code objects built with different names or options are stored once.
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb dedup_db(std::string(temp_file), false);
+
+        auto cfg1        = cfg_lz4;
+        cfg1.kernel_name = "kernel4";
+        auto cfg2        = cfg_lz4;
+        cfg2.kernel_args = random_string(64);
+        CHECK(dedup_db.StoreRecordUnsafe(cfg_lz4));
+        CHECK(dedup_db.StoreRecordUnsafe(cfg1));
+        CHECK(dedup_db.StoreRecordUnsafe(cfg2));
+
+        const auto count_blobs = [&]() {
+            const auto sql = miopen::SQLite{std::string(temp_file), false};
+            return sql.Exec("SELECT COUNT(*) AS n FROM `kern_blob`;").front().at("n");
+        };
+        CHECK(count_blobs() == "1");
+        CHECK(dedup_db.FindRecordUnsafe(cfg1).get() == cfg_lz4.kernel_blob);
+        CHECK(dedup_db.FindRecordUnsafe(cfg2).get() == cfg_lz4.kernel_blob);
+
+        // The code object is kept for as long as any record refers to it.
+        CHECK(dedup_db.RemoveRecordUnsafe(cfg_lz4));
+        CHECK(dedup_db.Compact().removed == 0);
+        CHECK(dedup_db.FindRecordUnsafe(cfg1).get() == cfg_lz4.kernel_blob);
+        CHECK(dedup_db.RemoveRecordUnsafe(cfg1));
+        CHECK(dedup_db.RemoveRecordUnsafe(cfg2));
+        CHECK(dedup_db.Compact().removed == 1);
+        CHECK(count_blobs() == "0");
+    }
+
+    {
+        // Exceeding the size budget evicts the least recently used records.
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb lru_db(std::string(temp_file), false, miopen::KernelCodec::Lz4);
+
+        auto cfgs = std::vector<miopen::KernelConfig>(4);
+        for(auto i = std::size_t{0}; i < cfgs.size(); ++i)
+        {
+            cfgs[i].kernel_name = "kernel_lru" + std::to_string(i);
+            cfgs[i].kernel_args = random_string(16);
+            cfgs[i].kernel_blob = random_string(64 * 1024);
+        }
+        for(auto i = 0; i < 3; ++i)
+            CHECK(lru_db.StoreRecordUnsafe(cfgs[i]));
+
+        {
+            const auto sql = miopen::SQLite{std::string(temp_file), false};
+            sql.Exec("UPDATE `kern_db` SET last_access = id * 100;");
+        }
+        // Loading a record refreshes its access time.
+        CHECK(lru_db.FindRecordUnsafe(cfgs[0]));
+
+        lru_db.SetSizeLimit(256 * 1024);
+        CHECK(lru_db.StoreRecordUnsafe(cfgs[3]));
+        CHECK(lru_db.FindRecordUnsafe(cfgs[0]).get() == cfgs[0].kernel_blob);
+        CHECK(!lru_db.FindRecordUnsafe(cfgs[1]));
+        CHECK(!lru_db.FindRecordUnsafe(cfgs[2]));
+        CHECK(lru_db.FindRecordUnsafe(cfgs[3]).get() == cfgs[3].kernel_blob);
+        CHECK(boost::filesystem::file_size(std::string(temp_file)) <= 256 * 1024);
+    }
 }
 #endif
 
@@ -143,6 +336,65 @@ void check_cache_file()
     CHECK(p.filename().string() == "base.o");
 }
 
+void check_cache_file_eviction()
+{
+    const auto tmp = miopen::TmpDir{"cache-eviction"};
+    const auto now = std::time(nullptr);
+
+    // Binaries of three configurations, the oldest one first.
+    auto files = std::vector<boost::filesystem::path>{};
+    for(auto i = 0; i < 3; ++i)
+    {
+        const auto dir = tmp.path / std::to_string(i);
+        boost::filesystem::create_directories(dir);
+        for(auto j = 0; j < 2; ++j)
+        {
+            files.push_back(dir / (std::to_string(j) + ".o"));
+            std::ofstream{files.back().string()} << std::string(1024, 'x');
+            boost::filesystem::last_write_time(files.back(), now - (3 - i) * 100 + j);
+        }
+    }
+    // Other files in the cache directory are left alone.
+    std::ofstream{(tmp.path / "perf.udb").string()} << std::string(1024, 'x');
+
+    CHECK(miopen::EvictCacheFiles(tmp.path, 6 * 1024) == 0);
+    CHECK(miopen::EvictCacheFiles(tmp.path, 5 * 1024) == 3);
+    CHECK(!boost::filesystem::exists(tmp.path / "0"));
+    CHECK(!boost::filesystem::exists(files[2]));
+    CHECK(boost::filesystem::exists(files[3]));
+    CHECK(boost::filesystem::exists(files[4]));
+    CHECK(boost::filesystem::exists(tmp.path / "perf.udb"));
+}
+
+void check_cache_size_tracker()
+{
+    const auto tmp   = miopen::TmpDir{"cache-size-tracker"};
+    const auto now   = std::time(nullptr);
+    const auto store = [&](int i) {
+        const auto dir = tmp.path / std::to_string(i);
+        boost::filesystem::create_directories(dir);
+        std::ofstream{(dir / "0.o").string()} << std::string(1024, 'x');
+        boost::filesystem::last_write_time(dir / "0.o", now - 100 + i);
+    };
+
+    auto tracker = miopen::CacheSizeTracker{tmp.path, 3 * 1024};
+    store(0);
+    CHECK(tracker.Add(1024) == 0);
+    store(1);
+    store(2);
+    CHECK(tracker.Add(1024) == 0);
+    CHECK(tracker.Add(1024) == 0);
+    // Replacing a binary does not grow the cache.
+    store(2);
+    CHECK(tracker.Add(1024, 1024) == 0);
+    store(3);
+    CHECK(tracker.Add(1024) == 2);
+    CHECK(!boost::filesystem::exists(tmp.path / "0"));
+    CHECK(!boost::filesystem::exists(tmp.path / "1"));
+    CHECK(boost::filesystem::exists(tmp.path / "2"));
+    CHECK(boost::filesystem::exists(tmp.path / "3"));
+}
+
 void check_cache_str()
 {
     auto p    = miopen::GetCacheFile("gfx", "base", "args", true);
@@ -154,9 +406,12 @@ int main()
 {
     check_cache_file();
     check_cache_str();
+    check_cache_file_eviction();
+    check_cache_size_tracker();
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
     check_bz2_compress();
     check_bz2_decompress();
+    check_lz4();
     check_kern_db();
 #endif
 }
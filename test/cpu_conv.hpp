@@ -27,14 +27,20 @@
 #define GUARD_CPU_CONV_HPP
 
 #include "test.hpp"
+#include <algorithm>
 #include <array>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
 #include <miopen/tensor.hpp>
+#include <numeric>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
@@ -350,6 +356,461 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
     });
 }
 
+/// c += a * b for row-major a (m x k), b (k x n) and c (m x n). Each tile of c is updated four
+/// rows at a time from a block of b that stays in the cache, and the innermost loop runs over
+/// contiguous elements of b and c, so that compilers vectorize it. Every element of c sums
+/// its products in the order of k, like the naive loops do.
+template <typename T>
+void cpu_gemm(std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              const T* a,
+              const T* b,
+              T* c,
+              bool parallel)
+{
+    constexpr std::size_t block_m = 32;
+    constexpr std::size_t block_n = 512;
+    constexpr std::size_t block_k = 128;
+
+    const auto tiles_n = (n + block_n - 1) / block_n;
+    const auto tiles   = (m + block_m - 1) / block_m * tiles_n;
+
+    const auto tile = [&](std::size_t t) {
+        const auto i0    = t / tiles_n * block_m;
+        const auto i1    = std::min(m, i0 + block_m);
+        const auto j0    = t % tiles_n * block_n;
+        const auto width = std::min(n, j0 + block_n) - j0;
+
+        for(std::size_t l0 = 0; l0 < k; l0 += block_k)
+        {
+            const auto l1 = std::min(k, l0 + block_k);
+            auto i        = i0;
+            for(; i + 4 <= i1; i += 4)
+            {
+                T* c0 = c + i * n + j0;
+                T* c1 = c0 + n;
+                T* c2 = c1 + n;
+                T* c3 = c2 + n;
+                for(auto l = l0; l < l1; ++l)
+                {
+                    const T a0     = a[i * k + l];
+                    const T a1     = a[(i + 1) * k + l];
+                    const T a2     = a[(i + 2) * k + l];
+                    const T a3     = a[(i + 3) * k + l];
+                    const T* b_row = b + l * n + j0;
+                    for(std::size_t j = 0; j < width; ++j)
+                    {
+                        const T b_val = b_row[j];
+                        c0[j] += a0 * b_val;
+                        c1[j] += a1 * b_val;
+                        c2[j] += a2 * b_val;
+                        c3[j] += a3 * b_val;
+                    }
+                }
+            }
+            for(; i < i1; ++i)
+            {
+                T* c_row = c + i * n + j0;
+                for(auto l = l0; l < l1; ++l)
+                {
+                    const T a_val  = a[i * k + l];
+                    const T* b_row = b + l * n + j0;
+                    for(std::size_t j = 0; j < width; ++j)
+                        c_row[j] += a_val * b_row[j];
+                }
+            }
+        }
+    };
+
+    if(parallel)
+    {
+        miopen::par_for(tiles, 1, tile);
+    }
+    else
+    {
+        for(std::size_t t = 0; t < tiles; ++t)
+            tile(t);
+    }
+}
+
+/// Shapes of a convolution as the GEMM based reference sees them. The weights of a group form
+/// a k_per_group x rows matrix, and the im2col matrix of an image and a group is
+/// rows x out_size, where rows = c_per_group * wei_size. The im2col matrix is built in tiles
+/// of tile_size output positions, so its memory footprint stays bounded for large shapes.
+template <std::size_t ConvDim>
+struct cpu_conv_gemm_geometry
+{
+    std::size_t n_len;
+    std::size_t groups;
+    std::size_t k_per_group;
+    std::size_t c_per_group;
+    std::size_t wei_size;
+    std::size_t out_size;
+    std::size_t rows;
+    std::size_t tile_size;
+    std::array<std::size_t, ConvDim> in_len;
+    std::array<std::size_t, ConvDim> wei_len;
+    std::array<std::size_t, ConvDim> out_len;
+    std::array<std::size_t, ConvDim + 2> in_str;
+    std::array<std::size_t, ConvDim + 2> wei_str;
+    std::array<std::size_t, ConvDim + 2> out_str;
+    std::array<std::ptrdiff_t, ConvDim> pads;
+    std::array<std::ptrdiff_t, ConvDim> strides;
+    std::array<std::ptrdiff_t, ConvDim> dilations;
+
+    template <typename Tin, typename Twei, typename Tout, typename Range>
+    cpu_conv_gemm_geometry(const tensor<Tin>& in,
+                           const tensor<Twei>& wei,
+                           const tensor<Tout>& out,
+                           const Range& pads_,
+                           const Range& strides_,
+                           const Range& dilations_,
+                           std::size_t group_count)
+    {
+        n_len       = in.desc.GetLengths()[0];
+        groups      = group_count;
+        k_per_group = wei.desc.GetLengths()[0] / group_count;
+        c_per_group = wei.desc.GetLengths()[1];
+        std::copy_n(in.desc.GetLengths().begin() + 2, ConvDim, in_len.begin());
+        std::copy_n(wei.desc.GetLengths().begin() + 2, ConvDim, wei_len.begin());
+        std::copy_n(out.desc.GetLengths().begin() + 2, ConvDim, out_len.begin());
+        std::copy_n(in.desc.GetStrides().begin(), ConvDim + 2, in_str.begin());
+        std::copy_n(wei.desc.GetStrides().begin(), ConvDim + 2, wei_str.begin());
+        std::copy_n(out.desc.GetStrides().begin(), ConvDim + 2, out_str.begin());
+        std::copy_n(pads_.begin(), ConvDim, pads.begin());
+        std::copy_n(strides_.begin(), ConvDim, strides.begin());
+        std::copy_n(dilations_.begin(), ConvDim, dilations.begin());
+
+        const auto product = [](const auto& lens) {
+            return std::accumulate(
+                lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+        };
+        wei_size = product(wei_len);
+        out_size = product(out_len);
+        rows     = c_per_group * wei_size;
+
+        // Tiles consist of whole rows of the innermost dimension and hold up to 2M elements.
+        constexpr std::size_t tile_limit = std::size_t{1} << 21;
+        const auto inner                 = out_len[ConvDim - 1];
+        const auto tile_rows             = std::max<std::size_t>(1, tile_limit / (rows * inner));
+        tile_size                        = std::min(out_size, tile_rows * inner);
+    }
+
+    /// Offsets of the spatial positions of a tensor in row-major order of the positions.
+    static std::vector<std::size_t> spatial_offsets(const std::array<std::size_t, ConvDim>& lens,
+                                                    const std::array<std::size_t, ConvDim + 2>& str)
+    {
+        std::vector<std::size_t> offsets{0};
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            std::vector<std::size_t> next;
+            next.reserve(offsets.size() * lens[i]);
+            for(const auto offset : offsets)
+                for(std::size_t x = 0; x < lens[i]; ++x)
+                    next.push_back(offset + x * str[i + 2]);
+            offsets = std::move(next);
+        }
+        return offsets;
+    }
+
+    /// Offset of the weight in the given im2col row, relative to the first output channel.
+    std::size_t wei_offset(std::size_t row) const
+    {
+        auto offset = row / wei_size * wei_str[1];
+        auto tap    = row % wei_size;
+        for(std::size_t i = ConvDim; i-- > 0;)
+        {
+            offset += tap % wei_len[i] * wei_str[i + 2];
+            tap /= wei_len[i];
+        }
+        return offset;
+    }
+
+    /// Calls f(out_pos - begin, in_offset) for the output positions in [begin, end) of the
+    /// im2col row that read inside the input, in_offset being relative to the first input
+    /// channel of the group. Positions in the padding are skipped. The range shall be a tile.
+    template <typename F>
+    void for_each_in_row(std::size_t row, std::size_t begin, std::size_t end, F f) const
+    {
+        std::array<std::ptrdiff_t, ConvDim> shift{};
+        auto tap = row % wei_size;
+        for(std::size_t i = ConvDim; i-- > 0;)
+        {
+            shift[i] = static_cast<std::ptrdiff_t>(tap % wei_len[i]) * dilations[i] - pads[i];
+            tap /= wei_len[i];
+        }
+
+        constexpr auto last = ConvDim - 1;
+        const auto inner    = out_len[last];
+        const auto outer    = out_size / inner;
+        const auto channel  = static_cast<std::ptrdiff_t>(row / wei_size * in_str[1]);
+        const auto len_x    = static_cast<std::ptrdiff_t>(in_len[last]);
+        const auto stride_x = static_cast<std::ptrdiff_t>(in_str[last + 2]);
+
+        for(auto o = begin / inner; o < std::min(outer, (end + inner - 1) / inner); ++o)
+        {
+            auto base  = channel;
+            auto valid = true;
+            auto pos   = o;
+            for(std::size_t i = last; i-- > 0;)
+            {
+                const auto x =
+                    static_cast<std::ptrdiff_t>(pos % out_len[i]) * strides[i] + shift[i];
+                pos /= out_len[i];
+                valid = valid && x >= 0 && x < static_cast<std::ptrdiff_t>(in_len[i]);
+                base += x * static_cast<std::ptrdiff_t>(in_str[i + 2]);
+            }
+            if(!valid)
+                continue;
+
+            for(std::size_t x = 0; x < inner; ++x)
+            {
+                const auto in_x = static_cast<std::ptrdiff_t>(x) * strides[last] + shift[last];
+                if(in_x >= 0 && in_x < len_x)
+                    f(o * inner + x - begin, static_cast<std::size_t>(base + in_x * stride_x));
+            }
+        }
+    }
+};
+
+/// Calls f(i, parallel) for i in [0, n). When there are enough calls to occupy the cores they
+/// run concurrently, otherwise one after another with f expected to parallelize its own work.
+template <typename F>
+void cpu_conv_gemm_for_each(std::size_t n, F f)
+{
+    if(n >= std::thread::hardware_concurrency())
+    {
+        miopen::par_for(n, 1, [&](std::size_t i) { f(i, false); });
+    }
+    else
+    {
+        for(std::size_t i = 0; i < n; ++i)
+            f(i, true);
+    }
+}
+
+template <typename F>
+void cpu_conv_gemm_for(std::size_t n, bool parallel, F f)
+{
+    if(parallel)
+    {
+        miopen::par_for(n, f);
+    }
+    else
+    {
+        for(std::size_t i = 0; i < n; ++i)
+            f(i);
+    }
+}
+
+// The im2col + GEMM forms of the convolutions below compute the same sums as the naive *_impl
+// loops, which are kept as the correctness oracle, in a fraction of the time for large shapes.
+// Each image is processed in tiles of output positions, which bounds the im2col buffers.
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_forward_gemm(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    // Vectorized layouts are only supported by the naive loops.
+    if(in.desc.GetVectorLength() > 1 || wei.desc.GetLayout_str() == "CHWNc")
+    {
+        cpu_convolution_forward_impl<ConvDim, Tacc>(
+            in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
+    const auto geo = cpu_conv_gemm_geometry<ConvDim>{
+        in, wei, out, pads, strides, dilations, group_count};
+    const auto rows        = geo.rows;
+    const auto out_offsets = geo.spatial_offsets(geo.out_len, geo.out_str);
+
+    std::vector<Tacc> w(geo.groups * geo.k_per_group * rows);
+    miopen::par_for(geo.groups * geo.k_per_group, [&](std::size_t k) {
+        for(std::size_t row = 0; row < rows; ++row)
+            w[k * rows + row] = Tacc(wei.data[k * geo.wei_str[0] + geo.wei_offset(row)]);
+    });
+
+    cpu_conv_gemm_for_each(geo.n_len * geo.groups, [&](std::size_t ng, bool parallel) {
+        const auto n       = ng / geo.groups;
+        const auto g       = ng % geo.groups;
+        const auto in_base = n * geo.in_str[0] + g * geo.c_per_group * geo.in_str[1];
+
+        const auto out_base = n * geo.out_str[0] + g * geo.k_per_group * geo.out_str[1];
+
+        std::vector<Tacc> col(rows * geo.tile_size);
+        std::vector<Tacc> res(geo.k_per_group * geo.tile_size);
+        for(std::size_t begin = 0; begin < geo.out_size; begin += geo.tile_size)
+        {
+            const auto size = std::min(geo.tile_size, geo.out_size - begin);
+            std::fill(col.begin(), col.end(), Tacc(0));
+            cpu_conv_gemm_for(rows, parallel, [&](std::size_t row) {
+                auto* col_row = &col[row * size];
+                geo.for_each_in_row(row, begin, begin + size, [&](auto pos, auto offset) {
+                    col_row[pos] = Tacc(in.data[in_base + offset]);
+                });
+            });
+
+            std::fill(res.begin(), res.end(), Tacc(0));
+            cpu_gemm(geo.k_per_group,
+                     size,
+                     rows,
+                     &w[g * geo.k_per_group * rows],
+                     col.data(),
+                     res.data(),
+                     parallel);
+
+            for(std::size_t k = 0; k < geo.k_per_group; ++k)
+                for(std::size_t pos = 0; pos < size; ++pos)
+                    out.data[out_base + k * geo.out_str[1] + out_offsets[begin + pos]] =
+                        res[k * size + pos];
+        }
+    });
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_data_gemm(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count)
+{
+    const auto geo = cpu_conv_gemm_geometry<ConvDim>{
+        in, wei, out, pads, strides, dilations, group_count};
+    const auto rows        = geo.rows;
+    const auto kpg         = geo.k_per_group;
+    const auto in_offsets  = geo.spatial_offsets(geo.in_len, geo.in_str);
+    const auto out_offsets = geo.spatial_offsets(geo.out_len, geo.out_str);
+
+    // Transposed weights, a rows x k_per_group matrix per group.
+    std::vector<Tacc> wt(geo.groups * rows * kpg);
+    miopen::par_for(geo.groups * rows, [&](std::size_t g_row) {
+        const auto g   = g_row / rows;
+        const auto row = g_row % rows;
+        for(std::size_t k = 0; k < kpg; ++k)
+            wt[g_row * kpg + k] =
+                Tacc(wei.data[(g * kpg + k) * geo.wei_str[0] + geo.wei_offset(row)]);
+    });
+
+    cpu_conv_gemm_for_each(geo.n_len * geo.groups, [&](std::size_t ng, bool parallel) {
+        const auto n        = ng / geo.groups;
+        const auto g        = ng % geo.groups;
+        const auto out_base = n * geo.out_str[0] + g * kpg * geo.out_str[1];
+
+        // din is indexed like the input tensor from in_base.
+        const auto in_base = n * geo.in_str[0] + g * geo.c_per_group * geo.in_str[1];
+        const auto din_size =
+            (geo.c_per_group - 1) * geo.in_str[1] + in_offsets.back() + std::size_t{1};
+        std::vector<Tacc> din(din_size, Tacc(0));
+
+        std::vector<Tacc> dout(kpg * geo.tile_size);
+        std::vector<Tacc> col(rows * geo.tile_size);
+        for(std::size_t begin = 0; begin < geo.out_size; begin += geo.tile_size)
+        {
+            const auto size = std::min(geo.tile_size, geo.out_size - begin);
+            for(std::size_t k = 0; k < kpg; ++k)
+                for(std::size_t pos = 0; pos < size; ++pos)
+                    dout[k * size + pos] =
+                        Tacc(out.data[out_base + k * geo.out_str[1] + out_offsets[begin + pos]]);
+
+            std::fill(col.begin(), col.end(), Tacc(0));
+            cpu_gemm(rows, size, kpg, &wt[g * rows * kpg], dout.data(), col.data(), parallel);
+
+            // col2im: the rows of one channel add up to the same input positions, so channels
+            // are the unit of parallelism.
+            cpu_conv_gemm_for(geo.c_per_group, parallel, [&](std::size_t c) {
+                for(auto row = c * geo.wei_size; row < (c + 1) * geo.wei_size; ++row)
+                {
+                    const auto* col_row = &col[row * size];
+                    geo.for_each_in_row(row, begin, begin + size, [&](auto pos, auto offset) {
+                        din[offset] += col_row[pos];
+                    });
+                }
+            });
+        }
+
+        cpu_conv_gemm_for(geo.c_per_group, parallel, [&](std::size_t c) {
+            for(const auto offset : in_offsets)
+                in.data[in_base + c * geo.in_str[1] + offset] = din[c * geo.in_str[1] + offset];
+        });
+    });
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_weight_gemm(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    const auto geo = cpu_conv_gemm_geometry<ConvDim>{
+        in, wei, out, pads, strides, dilations, group_count};
+    const auto rows        = geo.rows;
+    const auto kpg         = geo.k_per_group;
+    const auto out_offsets = geo.spatial_offsets(geo.out_len, geo.out_str);
+
+    // The images of a group accumulate into the same weights, so groups are the unit of
+    // parallelism and the images of a group are processed one after another.
+    cpu_conv_gemm_for_each(geo.groups, [&](std::size_t g, bool parallel) {
+        std::vector<Tacc> dwei(kpg * rows, Tacc(0));
+        std::vector<Tacc> dout(kpg * geo.tile_size);
+        // Transposed im2col tile, tile_size x rows.
+        std::vector<Tacc> col(geo.tile_size * rows);
+
+        for(std::size_t n = 0; n < geo.n_len; ++n)
+        {
+            const auto out_base = n * geo.out_str[0] + g * kpg * geo.out_str[1];
+            const auto in_base  = n * geo.in_str[0] + g * geo.c_per_group * geo.in_str[1];
+            for(std::size_t begin = 0; begin < geo.out_size; begin += geo.tile_size)
+            {
+                const auto size = std::min(geo.tile_size, geo.out_size - begin);
+                for(std::size_t k = 0; k < kpg; ++k)
+                    for(std::size_t pos = 0; pos < size; ++pos)
+                        dout[k * size + pos] = Tacc(
+                            out.data[out_base + k * geo.out_str[1] + out_offsets[begin + pos]]);
+
+                std::fill(col.begin(), col.end(), Tacc(0));
+                cpu_conv_gemm_for(rows, parallel, [&](std::size_t row) {
+                    geo.for_each_in_row(row, begin, begin + size, [&](auto pos, auto offset) {
+                        col[pos * rows + row] = Tacc(in.data[in_base + offset]);
+                    });
+                });
+
+                cpu_gemm(kpg, rows, size, dout.data(), col.data(), dwei.data(), parallel);
+            }
+        }
+
+        for(std::size_t k = 0; k < kpg; ++k)
+            for(std::size_t row = 0; row < rows; ++row)
+                wei.data[(g * kpg + k) * geo.wei_str[0] + geo.wei_offset(row)] =
+                    dwei[k * rows + row];
+    });
+}
+
 template <typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward(std::size_t spatial_dim,
                              const tensor<Tin>& in,
@@ -365,22 +826,22 @@ void cpu_convolution_forward(std::size_t spatial_dim,
     switch(spatial_dim)
     {
     case 1: {
-        cpu_convolution_forward_impl<1, acc_type>(
+        cpu_convolution_forward_gemm<1, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 2: {
-        cpu_convolution_forward_impl<2, acc_type>(
+        cpu_convolution_forward_gemm<2, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 3: {
-        cpu_convolution_forward_impl<3, acc_type>(
+        cpu_convolution_forward_gemm<3, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 4: {
-        cpu_convolution_forward_impl<4, acc_type>(
+        cpu_convolution_forward_gemm<4, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
@@ -405,22 +866,22 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
     switch(spatial_dim)
     {
     case 1: {
-        cpu_convolution_backward_data_impl<1, acc_type>(
+        cpu_convolution_backward_data_gemm<1, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 2: {
-        cpu_convolution_backward_data_impl<2, acc_type>(
+        cpu_convolution_backward_data_gemm<2, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 3: {
-        cpu_convolution_backward_data_impl<3, acc_type>(
+        cpu_convolution_backward_data_gemm<3, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 4: {
-        cpu_convolution_backward_data_impl<4, acc_type>(
+        cpu_convolution_backward_data_gemm<4, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
@@ -445,22 +906,22 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
     switch(spatial_dim)
     {
     case 1: {
-        cpu_convolution_backward_weight_impl<1, acc_type>(
+        cpu_convolution_backward_weight_gemm<1, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 2: {
-        cpu_convolution_backward_weight_impl<2, acc_type>(
+        cpu_convolution_backward_weight_gemm<2, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 3: {
-        cpu_convolution_backward_weight_impl<3, acc_type>(
+        cpu_convolution_backward_weight_gemm<3, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
     case 4: {
-        cpu_convolution_backward_weight_impl<4, acc_type>(
+        cpu_convolution_backward_weight_gemm<4, acc_type>(
             in, wei, out, pads, strides, dilations, group_count);
         break;
     }
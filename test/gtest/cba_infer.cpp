@@ -139,6 +139,39 @@ TEST_P(ConvBiasActivInferTestFloat, ConvBinWinogradRxSf2x3g1Fused)
     RunSolver<miopen::solver::fusion::ConvBinWinogradRxSf2x3g1Fused>(
         fusePlanDesc, plan_params, conv_config, test_skipped);
 }
+TEST_P(ConvBiasActivInferTestFloat, CompileBestFirst)
+{
+    auto& handle              = get_handle();
+    fusePlanDesc.compile_mode = miopenFusionCompileBestFirst;
+    if(fusePlanDesc.Compile(handle) != miopenStatusSuccess)
+    {
+        test_skipped = true;
+        GTEST_SKIP() << "No fused solution is applicable" << conv_config;
+    }
+    std::size_t built   = 0;
+    std::size_t pending = 0;
+    fusePlanDesc.GetCompileStatus(built, pending);
+    EXPECT_GE(built, 1);
+    ASSERT_EQ(fusePlanDesc.solutions.size(), 1);
+    EXPECT_EQ(fusePlanDesc.Execute(
+                  handle, input.desc, in_dev.get(), output.desc, out_dev.get(), params),
+              miopenStatusSuccess);
+    handle.Finish();
+    if(fusePlanDesc.background_compile.valid())
+        fusePlanDesc.background_compile.wait();
+    fusePlanDesc.GetCompileStatus(built, pending);
+    EXPECT_EQ(pending, 0);
+    // The solutions built in the background are registered by the next compilation.
+    const auto built_in_background = built;
+    fusePlanDesc.compile_mode      = miopenFusionCompileAll;
+    ASSERT_EQ(fusePlanDesc.Compile(handle), miopenStatusSuccess);
+    fusePlanDesc.GetCompileStatus(built, pending);
+    EXPECT_EQ(built, built_in_background);
+    EXPECT_EQ(fusePlanDesc.Execute(
+                  handle, input.desc, in_dev.get(), output.desc, out_dev.get(), params),
+              miopenStatusSuccess);
+    handle.Finish();
+}
 
 TEST_P(ConvBiasActivInferTestHalf, ConvCKIgemmFwdBiasActivFused)
 {
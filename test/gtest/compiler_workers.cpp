@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/compiler_workers.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Stands in for the compiler: "stub_cc <input> -o <output>" copies the input to the output and
+// fails if the input contains "error". The sleep keeps several commands in flight at once.
+const auto stub_compiler = R"(#!/bin/sh
+if grep -q error "$1"; then
+    echo "$1: error" >&2
+    exit 1
+fi
+sleep 0.05
+echo "compiled $1"
+cp "$1" "$3"
+)";
+
+std::string ReadFile(const boost::filesystem::path& path)
+{
+    std::ifstream file(path.string());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+struct CompilerWorkersTest : testing::Test
+{
+    miopen::TmpDir tools{"compiler-workers"};
+    std::string compiler;
+
+    void SetUp() override
+    {
+        const auto path = tools.path / "stub_cc";
+        miopen::WriteFile(std::string{stub_compiler}, path);
+        boost::filesystem::permissions(path,
+                                       boost::filesystem::owner_all |
+                                           boost::filesystem::group_read |
+                                           boost::filesystem::others_read);
+        compiler = path.string();
+    }
+};
+
+} // namespace
+
+TEST_F(CompilerWorkersTest, RunsInDirectory)
+{
+    miopen::CompilerWorkers workers{1};
+    miopen::TmpDir build{"build"};
+    miopen::WriteFile(std::string{"kernel"}, build.path / "kernel.cpp");
+
+    EXPECT_EQ(workers.Run(compiler + " kernel.cpp -o kernel.o", build.path), 0);
+    EXPECT_EQ(ReadFile(build.path / "kernel.o"), "kernel");
+
+    // The directory does not leak into the next command.
+    EXPECT_NE(workers.Run("test -f kernel.o", tools.path), 0);
+}
+
+TEST_F(CompilerWorkersTest, ExitCodes)
+{
+    miopen::CompilerWorkers workers{2};
+    miopen::TmpDir build{"build"};
+    miopen::WriteFile(std::string{"error"}, build.path / "kernel.cpp");
+
+    EXPECT_EQ(workers.Run(compiler + " kernel.cpp -o kernel.o", build.path), 1);
+    EXPECT_FALSE(boost::filesystem::exists(build.path / "kernel.o"));
+    EXPECT_EQ(workers.Run("exit 3", build.path), 3);
+    EXPECT_NE(workers.Run("cd missing_dir", build.path), 0);
+    EXPECT_NE(workers.Run("true", build.path / "missing_dir"), 0);
+    // The worker survives failing commands.
+    EXPECT_EQ(workers.Run("true", build.path), 0);
+    EXPECT_ANY_THROW(workers.Run("true\ntrue", build.path));
+}
+
+TEST_F(CompilerWorkersTest, DeadWorker)
+{
+    miopen::CompilerWorkers workers{1};
+
+    // $$ is the worker shell itself, not the subshell running the command.
+    EXPECT_ANY_THROW(workers.Run("kill -9 $$", tools.path));
+    EXPECT_EQ(workers.Run("true", tools.path), 0);
+}
+
+TEST_F(CompilerWorkersTest, Parallel)
+{
+    constexpr auto n_threads = 4;
+    constexpr auto n_kernels = 8;
+    miopen::CompilerWorkers workers{2};
+    std::atomic<int> failures{0};
+
+    std::vector<std::thread> threads;
+    for(auto thread_idx = 0; thread_idx < n_threads; ++thread_idx)
+    {
+        threads.emplace_back([&, thread_idx]() {
+            for(auto idx = thread_idx; idx < n_kernels; idx += n_threads)
+            {
+                miopen::TmpDir build{"build"};
+                const auto src = "kernel " + std::to_string(idx);
+                miopen::WriteFile(src, build.path / "kernel.cpp");
+                if(workers.Run(compiler + " kernel.cpp -o kernel.o 1>/dev/null", build.path) != 0 ||
+                   ReadFile(build.path / "kernel.o") != src)
+                    ++failures;
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(failures.load(), 0);
+}
+
+TEST_F(CompilerWorkersTest, TmpDirExecute)
+{
+    miopen::TmpDir build{"build"};
+    miopen::WriteFile(std::string{"kernel"}, build.path / "kernel.cpp");
+    build.Execute(compiler, "kernel.cpp -o kernel.o");
+    EXPECT_EQ(ReadFile(build.path / "kernel.o"), "kernel");
+
+    miopen::WriteFile(std::string{"error"}, build.path / "bad.cpp");
+    EXPECT_ANY_THROW(build.Execute(compiler, "bad.cpp -o bad.o 2>/dev/null"));
+}
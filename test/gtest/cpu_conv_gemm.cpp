@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include "cpu_conv.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+struct ConvCase
+{
+    std::vector<std::size_t> in;
+    std::vector<std::size_t> wei;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    std::size_t groups;
+    /// Packed NCHW-like layouts are miopenTensorNCHW for every number of dimensions.
+    miopenTensorLayout_t layout;
+};
+
+std::vector<ConvCase> GetCases()
+{
+    // clang-format off
+    return {
+        {{2, 3, 17}, {4, 3, 3}, {1}, {1}, {1}, 1, miopenTensorNCHW},
+        {{2, 8, 13, 11}, {16, 8, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1, miopenTensorNCHW},
+        {{1, 6, 14, 14}, {9, 2, 3, 5}, {2, 0}, {2, 1}, {1, 2}, 3, miopenTensorNCHW},
+        {{3, 5, 9, 10}, {7, 5, 1, 1}, {0, 0}, {2, 2}, {1, 1}, 1, miopenTensorNCHW},
+        {{2, 4, 12, 12}, {6, 4, 5, 5}, {3, 3}, {3, 2}, {2, 1}, 1, miopenTensorNHWC},
+        {{1, 4, 6, 7, 5}, {8, 2, 3, 3, 3}, {1, 1, 1}, {1, 2, 1}, {1, 1, 2}, 2, miopenTensorNCHW},
+    };
+    // clang-format on
+}
+
+tensor<float> MakeTensor(const std::vector<std::size_t>& lens,
+                         miopenTensorLayout_t layout,
+                         std::mt19937& rng)
+{
+    auto ret  = layout == miopenTensorNCHW ? tensor<float>{lens}
+                                           : tensor<float>{miopenFloat, layout, lens};
+    auto dist = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    for(auto& x : ret.data)
+        x = dist(rng);
+    return ret;
+}
+
+std::vector<std::size_t> GetOutLengths(const ConvCase& conv)
+{
+    auto ret = std::vector<std::size_t>{conv.in[0], conv.wei[0]};
+    for(std::size_t i = 0; i < conv.pads.size(); ++i)
+    {
+        const auto window = conv.dilations[i] * (conv.wei[i + 2] - 1) + 1;
+        ret.push_back((conv.in[i + 2] + 2 * conv.pads[i] - window) / conv.strides[i] + 1);
+    }
+    return ret;
+}
+
+void ExpectNear(const tensor<float>& actual, const tensor<float>& expected)
+{
+    ASSERT_EQ(actual.data.size(), expected.data.size());
+    for(std::size_t i = 0; i < actual.data.size(); ++i)
+        ASSERT_NEAR(actual.data[i], expected.data[i], 1e-5 * (1 + std::fabs(expected.data[i])))
+            << "at " << i;
+}
+
+template <std::size_t ConvDim>
+void Check(const ConvCase& conv)
+{
+    auto rng       = std::mt19937{static_cast<unsigned>(conv.in.size() * 1000 + conv.wei[0])};
+    const auto in  = MakeTensor(conv.in, conv.layout, rng);
+    const auto wei = MakeTensor(conv.wei, conv.layout, rng);
+    const auto out = MakeTensor(GetOutLengths(conv), conv.layout, rng);
+
+    auto fwd_ref = out;
+    auto fwd     = out;
+    cpu_convolution_forward_impl<ConvDim, double>(
+        in, wei, fwd_ref, conv.pads, conv.strides, conv.dilations, conv.groups);
+    cpu_convolution_forward(
+        ConvDim, in, wei, fwd, conv.pads, conv.strides, conv.dilations, conv.groups);
+    // Both sum the products in the same order.
+    EXPECT_EQ(fwd.data, fwd_ref.data);
+
+    auto bwd_ref = in;
+    auto bwd     = in;
+    cpu_convolution_backward_data_impl<ConvDim, double>(
+        bwd_ref, wei, out, conv.pads, conv.strides, conv.dilations, conv.groups);
+    cpu_convolution_backward_data(
+        ConvDim, bwd, wei, out, conv.pads, conv.strides, conv.dilations, conv.groups);
+    ExpectNear(bwd, bwd_ref);
+
+    auto wrw_ref = wei;
+    auto wrw     = wei;
+    cpu_convolution_backward_weight_impl<ConvDim, double>(
+        in, wrw_ref, out, conv.pads, conv.strides, conv.dilations, conv.groups);
+    cpu_convolution_backward_weight(
+        ConvDim, in, wrw, out, conv.pads, conv.strides, conv.dilations, conv.groups);
+    ExpectNear(wrw, wrw_ref);
+}
+} // namespace
+
+TEST(CpuConvGemm, MatchesNaive)
+{
+    for(const auto& conv : GetCases())
+    {
+        SCOPED_TRACE(conv.in.size() == 3 ? "1D" : conv.in.size() == 4 ? "2D" : "3D");
+        switch(conv.in.size() - 2)
+        {
+        case 1: Check<1>(conv); break;
+        case 2: Check<2>(conv); break;
+        case 3: Check<3>(conv); break;
+        default: FAIL();
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/search_options.hpp>
+#include <miopen/solution.hpp>
+
+#include "get_handle.hpp"
+
+#include <vector>
+
+namespace {
+miopen::Problem MakeProblem(int channels, miopenProblemDirection_t direction)
+{
+    const auto conv = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    const auto x    = miopen::TensorDescriptor{miopenFloat, {2, channels, 14, 14}};
+    const auto w    = miopen::TensorDescriptor{miopenFloat, {channels, channels, 3, 3}};
+
+    auto problem = miopen::Problem{};
+    problem.SetDirection(direction);
+    problem.SetOperatorDescriptor(conv);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionX, x);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionW, w);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionY, conv.GetForwardOutputTensor(x, w));
+    return problem;
+}
+} // namespace
+
+TEST(FindBatched, MatchesProblemOrder)
+{
+    auto&& handle       = get_handle();
+    const auto problems = std::vector<miopen::Problem>{
+        MakeProblem(8, miopenProblemDirectionForward),
+        MakeProblem(16, miopenProblemDirectionBackward),
+        MakeProblem(8, miopenProblemDirectionForward),
+    };
+
+    const auto found = miopen::FindSolutions(handle, problems, miopen::FindOptions{}, 4);
+    ASSERT_EQ(found.size(), problems.size());
+
+    for(std::size_t i = 0; i < found.size(); ++i)
+    {
+        ASSERT_FALSE(found[i].empty()) << "problem " << i;
+        for(const auto& solution : found[i])
+        {
+            EXPECT_EQ(solution.GetProblem().GetDirection(), problems[i].GetDirection());
+            EXPECT_EQ(solution.GetProblem().GetTensorDescriptor(miopenTensorConvolutionX),
+                      problems[i].GetTensorDescriptor(miopenTensorConvolutionX));
+        }
+    }
+
+    // The repeated problem reuses the results of the first one.
+    ASSERT_EQ(found[2].size(), found[0].size());
+    for(std::size_t i = 0; i < found[0].size(); ++i)
+        EXPECT_EQ(found[2][i].GetSolver(), found[0][i].GetSolver());
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/invoker_table.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+miopen::ProblemKey MakeKey(std::size_t i)
+{
+    auto key = miopen::ProblemKey{'t'};
+    key.Add(i).Add(std::vector<int>{1, 2, 3}).Add(std::string{"miopenFakeAlgorithm"});
+    return key;
+}
+
+struct TestInvoker
+{
+    std::size_t value;
+    void operator()(const miopen::Handle&, const miopen::AnyInvokeParams&) const {}
+};
+
+miopen::Invoker MakeInvoker(std::size_t value) { return TestInvoker{value}; }
+
+std::size_t Value(const miopen::Invoker& invoker) { return invoker.target<TestInvoker>()->value; }
+} // namespace
+
+TEST(ProblemKey, Equality)
+{
+    EXPECT_EQ(MakeKey(1), MakeKey(1));
+    EXPECT_EQ(MakeKey(1).GetHash(), MakeKey(1).GetHash());
+    EXPECT_NE(MakeKey(1), MakeKey(2));
+    EXPECT_NE(miopen::ProblemKey{'a'}.Add(1), miopen::ProblemKey{'b'}.Add(1));
+    EXPECT_NE(miopen::ProblemKey{'a'}.Add(0.5), miopen::ProblemKey{'a'}.Add(0.25));
+    EXPECT_NE(miopen::ProblemKey{'a'}.Add(std::string{"abcdefghi"}),
+              miopen::ProblemKey{'a'}.Add(std::string{"abcdefghj"}));
+    // Sizes are part of the key, so the split between the vectors matters.
+    EXPECT_NE(miopen::ProblemKey{'a'}.Add(std::vector<int>{1, 2}).Add(std::vector<int>{3}),
+              miopen::ProblemKey{'a'}.Add(std::vector<int>{1}).Add(std::vector<int>{2, 3}));
+}
+
+TEST(ProblemKey, Overflow)
+{
+    auto key = miopen::ProblemKey{'a'};
+    key.Add(std::vector<std::size_t>(miopen::ProblemKey::capacity, 0));
+    EXPECT_FALSE(key.IsValid());
+    EXPECT_NE(key, key);
+
+    miopen::InvokerTable table;
+    table.Insert(key, 0, MakeInvoker(1));
+    EXPECT_FALSE(table.Find(key, 0));
+}
+
+TEST(InvokerTable, InsertFind)
+{
+    miopen::InvokerTable table;
+    const std::size_t n_keys = 100;
+
+    EXPECT_FALSE(table.Find(MakeKey(0), 0));
+
+    table.Insert(MakeKey(0), 0, MakeInvoker(1));
+    const auto first = table.Find(MakeKey(0), 0);
+    ASSERT_TRUE(first);
+
+    // The first invoker registered for a key is kept.
+    table.Insert(MakeKey(0), 0, MakeInvoker(2));
+    for(std::size_t i = 1; i < n_keys; ++i)
+    {
+        table.Insert(MakeKey(i), 0, MakeInvoker(i + 1));
+        table.Insert(MakeKey(i), 1, MakeInvoker(n_keys + i + 1));
+    }
+
+    // Growing the table does not move the invokers.
+    EXPECT_EQ(Value(*first), 1);
+
+    for(std::size_t i = 1; i < n_keys; ++i)
+    {
+        const auto invoker = table.Find(MakeKey(i), 0);
+        ASSERT_TRUE(invoker);
+        EXPECT_EQ(Value(*invoker), i + 1);
+
+        const auto other = table.Find(MakeKey(i), 1);
+        ASSERT_TRUE(other);
+        EXPECT_EQ(Value(*other), n_keys + i + 1);
+    }
+
+    EXPECT_FALSE(table.Find(MakeKey(n_keys), 0));
+    EXPECT_FALSE(table.Find(MakeKey(1), 2));
+}
+
+TEST(InvokerTable, Concurrent)
+{
+    miopen::InvokerTable table;
+    const std::size_t n_threads = 8;
+    const std::size_t n_keys    = 256;
+    std::atomic<std::size_t> misses{0};
+
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for(std::size_t i = 0; i < n_keys; ++i)
+            {
+                const auto key = (i + t * 31) % n_keys;
+                if(!table.Find(MakeKey(key), 0))
+                {
+                    ++misses;
+                    table.Insert(MakeKey(key), 0, MakeInvoker(key));
+                }
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_GE(misses, n_keys);
+    for(std::size_t i = 0; i < n_keys; ++i)
+    {
+        const auto invoker = table.Find(MakeKey(i), 0);
+        ASSERT_TRUE(invoker);
+        EXPECT_EQ(Value(*invoker), i);
+    }
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/kernel_cache.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+const std::size_t n_threads = 8;
+const std::size_t n_keys    = 64;
+
+std::string Name(std::size_t i) { return "kernel" + std::to_string(i) + ".cl"; }
+std::string Options(std::size_t i) { return "-DMIOPEN_N=" + std::to_string(i); }
+
+template <class F>
+void RunThreads(F f)
+{
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < n_threads; ++t)
+        threads.emplace_back([&, t] { f(t); });
+    for(auto& thread : threads)
+        thread.join();
+}
+} // namespace
+
+TEST(KernelCache, ConcurrentPrograms)
+{
+    miopen::KernelCache cache;
+
+    RunThreads([&](std::size_t t) {
+        for(std::size_t i = t; i < n_keys * n_threads; ++i)
+        {
+            const auto key = i % n_keys;
+            cache.AddProgram(miopen::Program{}, Name(key), Options(key));
+            EXPECT_TRUE(cache.HasProgram(Name(key), Options(key)));
+            EXPECT_FALSE(cache.HasProgram(Name(key), Options(key + 1)));
+        }
+    });
+
+    RunThreads([&](std::size_t t) {
+        for(std::size_t key = t; key < n_keys; key += n_threads)
+            cache.ClearProgram(Name(key), Options(key));
+    });
+
+    for(std::size_t key = 0; key < n_keys; ++key)
+        EXPECT_FALSE(cache.HasProgram(Name(key), Options(key)));
+}
+
+TEST(KernelCache, ConcurrentKernels)
+{
+    miopen::KernelCache cache;
+
+    RunThreads([&](std::size_t t) {
+        for(std::size_t key = 0; key < n_keys; ++key)
+        {
+            cache.AddKernel({"algo", Options(key)}, miopen::Kernel{}, t);
+            const auto kernels = cache.GetKernels("algo", Options(key));
+            EXPECT_GT(kernels.size(), t);
+        }
+    });
+
+    for(std::size_t key = 0; key < n_keys; ++key)
+    {
+        EXPECT_EQ(cache.GetKernels("algo", Options(key)).size(), n_threads);
+        cache.ClearKernels("algo", Options(key));
+        EXPECT_TRUE(cache.GetKernels("algo", Options(key)).empty());
+    }
+    EXPECT_TRUE(cache.GetKernels("other", Options(0)).empty());
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/kernel.hpp>
+
+#include <algorithm>
+#include <string>
+
+TEST(KernelIncludes, TransitiveDeps)
+{
+    const auto deps = miopen::GetHipKernelIncDeps("#include <hip/hip_runtime.h>\n"
+                                                  "  #  include \"static_kernel_tuple.hpp\"\n");
+    const auto has = [&](const std::string& name) {
+        return std::find(deps.begin(), deps.end(), name) != deps.end();
+    };
+
+    // static_kernel_tuple.hpp includes static_kernel_functional.hpp through
+    // static_kernel_sequence.hpp.
+    EXPECT_TRUE(has("static_kernel_tuple.hpp"));
+    EXPECT_TRUE(has("static_kernel_sequence.hpp"));
+    EXPECT_TRUE(has("static_kernel_functional.hpp"));
+    EXPECT_FALSE(has("static_kernel_gridwise_gemm.hpp"));
+    EXPECT_TRUE(std::is_sorted(deps.begin(), deps.end()));
+
+    const auto& all = miopen::GetHipKernelIncList();
+    EXPECT_LT(deps.size(), all.size());
+    for(const auto& dep : deps)
+        EXPECT_NE(std::find(all.begin(), all.end(), dep), all.end()) << dep;
+}
+
+TEST(KernelIncludes, NoEmbeddedDeps)
+{
+    EXPECT_TRUE(miopen::GetHipKernelIncDeps("#include <hip/hip_runtime.h>\n").empty());
+    EXPECT_TRUE(miopen::GetHipKernelIncDeps("int x = 0;").empty());
+}
+
+TEST(KernelIncludes, Hash)
+{
+    const auto kernel = "static_kernel_gridwise_convolution_backward_data_implicit_gemm_v1r1_nchw_"
+                        "kcyx_nkhw.cpp";
+    const auto hash   = miopen::GetHipKernelIncHash(kernel);
+    EXPECT_EQ(hash.size(), 32);
+    EXPECT_EQ(miopen::GetHipKernelIncHash(kernel), hash);
+    EXPECT_NE(miopen::GetHipKernelIncHash("naive_conv.cpp"), hash);
+}
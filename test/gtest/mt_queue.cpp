@@ -25,8 +25,10 @@
  *******************************************************************************/
 #include <gtest/gtest.h>
 #include <miopen/mt_queue.hpp>
+#include <algorithm>
 #include <thread>
 #include <chrono>
+#include <memory>
 
 #include <stdlib.h>
 
@@ -39,7 +41,7 @@ template <typename T>
 using data_t = std::vector<T>;
 
 template <typename T>
-void producer(int thread_idx, data_t<T>& common_data, ThreadSafeQueue<T>& comp_queue)
+void producer(int thread_idx, data_t<T>& common_data, miopen::MPMCQueue<T>& comp_queue)
 {
     for(auto idx = thread_idx; idx < data_len; idx += total_producers)
     {
@@ -51,7 +53,7 @@ void producer(int thread_idx, data_t<T>& common_data, ThreadSafeQueue<T>& comp_q
 
 TEST(UtilMultiThreadQueue, Basic)
 {
-    ThreadSafeQueue<int> comp_queue;
+    miopen::MPMCQueue<int> comp_queue(8);
     int num_cons = 0;
     data_t<int> common_data;
     for(auto idx = 0; idx < data_len; ++idx)
@@ -65,7 +67,7 @@ TEST(UtilMultiThreadQueue, Basic)
 
     for(auto idx = 0; idx < data_len; ++idx)
     {
-        auto res = comp_queue.pop();
+        auto res = *comp_queue.pop();
         std::cerr << res << std::endl;
         num_cons++;
     }
@@ -78,3 +80,106 @@ TEST(UtilMultiThreadQueue, Basic)
         std::cout << tmp << std::endl;
     EXPECT_EQ(num_prod, num_cons);
 }
+
+TEST(UtilMultiThreadQueue, CloseDrains)
+{
+    miopen::MPMCQueue<std::unique_ptr<int>> queue(4);
+    for(auto idx = 0; idx < 3; ++idx)
+        EXPECT_TRUE(queue.push(std::make_unique<int>(idx)));
+    queue.close();
+
+    auto item = std::make_unique<int>(3);
+    EXPECT_FALSE(queue.push(std::move(item)));
+    EXPECT_NE(item, nullptr);
+
+    for(auto idx = 0; idx < 3; ++idx)
+    {
+        auto res = queue.pop();
+        ASSERT_TRUE(res);
+        EXPECT_EQ(**res, idx);
+    }
+    EXPECT_FALSE(queue.pop());
+}
+
+TEST(UtilMultiThreadQueue, CloseWakesWaiters)
+{
+    miopen::MPMCQueue<int> queue(1);
+    EXPECT_TRUE(queue.push(0));
+
+    std::atomic<bool> push_result{true};
+    std::thread blocked_producer([&]() { push_result = queue.push(1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    blocked_producer.join();
+    EXPECT_FALSE(push_result.load());
+
+    EXPECT_EQ(*queue.pop(), 0);
+    EXPECT_FALSE(queue.pop());
+}
+
+TEST(UtilMultiThreadQueue, Capacity)
+{
+    miopen::MPMCQueue<int> queue(2);
+    EXPECT_TRUE(queue.try_push(0));
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_FALSE(queue.try_push(2));
+    EXPECT_EQ(queue.size(), 2);
+
+    // Wraps around the end of the ring buffer.
+    EXPECT_EQ(*queue.try_pop(), 0);
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_EQ(*queue.try_pop(), 1);
+    EXPECT_EQ(*queue.try_pop(), 2);
+    EXPECT_FALSE(queue.try_pop());
+}
+
+TEST(UtilMultiThreadQueue, PopFor)
+{
+    miopen::MPMCQueue<int> queue(2);
+    EXPECT_FALSE(queue.pop_for(std::chrono::milliseconds(10)));
+
+    std::thread delayed_producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.push(42);
+    });
+    const auto res = queue.pop_for(std::chrono::seconds(10));
+    delayed_producer.join();
+    ASSERT_TRUE(res);
+    EXPECT_EQ(*res, 42);
+}
+
+TEST(UtilMultiThreadQueue, PopBatch)
+{
+    constexpr auto n_items   = 1000;
+    constexpr auto n_threads = 4;
+    miopen::MPMCQueue<int> queue(16);
+
+    std::vector<std::thread> producers;
+    for(auto thread_idx = 0; thread_idx < n_threads; ++thread_idx)
+    {
+        producers.emplace_back([&, thread_idx]() {
+            for(auto idx = thread_idx; idx < n_items; idx += n_threads)
+                queue.push(int{idx});
+        });
+    }
+    std::thread closer([&]() {
+        for(auto& prod : producers)
+            prod.join();
+        queue.close();
+    });
+
+    std::vector<int> items;
+    while(true)
+    {
+        const auto n = queue.pop_batch(items, 5);
+        EXPECT_LE(n, 5);
+        if(n == 0)
+            break;
+    }
+    closer.join();
+
+    std::sort(items.begin(), items.end());
+    ASSERT_EQ(items.size(), n_items);
+    for(auto idx = 0; idx < n_items; ++idx)
+        EXPECT_EQ(items[idx], idx);
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/par_for.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+void CheckEachIndexOnce(std::size_t n, std::size_t threads, std::size_t chunk)
+{
+    auto pool   = miopen::thread_pool{3};
+    auto visits = std::vector<std::atomic<int>>(n);
+    pool.parallel_for(n, threads, chunk, [&](std::size_t i) { ++visits[i]; });
+    for(std::size_t i = 0; i < n; ++i)
+        ASSERT_EQ(visits[i].load(), 1) << "n=" << n << " chunk=" << chunk << " i=" << i;
+}
+} // namespace
+
+TEST(ParFor, EachIndexOnce)
+{
+    for(const auto n : {0, 1, 2, 7, 64, 1000, 100003})
+    {
+        CheckEachIndexOnce(n, 4, 1);
+        CheckEachIndexOnce(n, 4, 16);
+        CheckEachIndexOnce(n, 2, 3);
+
+        auto visits = std::vector<std::atomic<int>>(n);
+        miopen::par_for(n, [&](std::size_t i) { ++visits[i]; });
+        miopen::par_for(n, miopen::max_threads{4}, [&](std::size_t i) { ++visits[i]; });
+        for(const auto& visit : visits)
+            ASSERT_EQ(visit.load(), 2);
+    }
+}
+
+TEST(ParFor, Nested)
+{
+    // Every worker is busy with the outer loop, so the inner loops run on their callers.
+    auto pool = miopen::thread_pool{2};
+    auto sum  = std::atomic<std::size_t>{0};
+    pool.parallel_for(16, 4, 1, [&](std::size_t) {
+        pool.parallel_for(100, 4, 1, [&](std::size_t i) { sum += i; });
+    });
+    EXPECT_EQ(sum.load(), 16 * 4950);
+}
+
+TEST(ParFor, Exception)
+{
+    auto pool = miopen::thread_pool{3};
+    EXPECT_THROW(pool.parallel_for(100,
+                                   4,
+                                   1,
+                                   [&](std::size_t i) {
+                                       if(i == 5)
+                                           throw std::runtime_error("par_for");
+                                   }),
+                 std::runtime_error);
+
+    // The pool is still usable afterwards.
+    auto count = std::atomic<int>{0};
+    pool.parallel_for(100, 4, 1, [&](std::size_t) { ++count; });
+    EXPECT_EQ(count.load(), 100);
+}
+
+TEST(ParFor, UnevenIterations)
+{
+    // One slow iteration does not hold back the others, which the rest of the threads take.
+    auto pool        = miopen::thread_pool{3};
+    auto mutex       = std::mutex{};
+    auto slow_thread = std::thread::id{};
+    auto others      = std::set<std::thread::id>{};
+    pool.parallel_for(12, 4, 1, [&](std::size_t i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{i == 0 ? 400 : 20});
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(i == 0)
+            slow_thread = std::this_thread::get_id();
+        else
+            others.insert(std::this_thread::get_id());
+    });
+    EXPECT_EQ(others.count(slow_thread), 0);
+    EXPECT_GT(others.size(), 1);
+}
@@ -0,0 +1,296 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/batch_norm.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/plan.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include "get_handle.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+std::vector<float> MakeData(std::size_t size, std::size_t seed)
+{
+    auto data = std::vector<float>(size);
+    for(std::size_t i = 0; i < size; ++i)
+        data[i] = static_cast<float>((i * 37 + seed * 11) % 101) / 25.f - 2.f;
+    return data;
+}
+
+miopen::PoolingDescriptor MakePooling()
+{
+    return {miopenPoolingMax, miopenPaddingDefault, {2, 2}, {2, 2}, {0, 0}};
+}
+
+miopen::Problem MakeConvolutionProblem(const miopen::ConvolutionDescriptor& conv,
+                                       const miopen::TensorDescriptor& x_desc,
+                                       const miopen::TensorDescriptor& w_desc)
+{
+    auto problem = miopen::Problem{};
+    problem.SetDirection(miopenProblemDirectionForward);
+    problem.SetOperatorDescriptor(conv);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionX, x_desc);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionW, w_desc);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionY,
+                                     conv.GetForwardOutputTensor(x_desc, w_desc));
+    return problem;
+}
+
+// Runs the forward convolution both as a plan and in immediate mode, the same way
+// miopenConvolutionForwardImmediate does, and compares the results.
+void CheckConvolutionPlan(const miopen::ConvolutionDescriptor& conv,
+                          const miopen::TensorDescriptor& x_desc,
+                          const miopen::TensorDescriptor& w_desc,
+                          const miopen::solver::Id& solver)
+{
+    auto&& handle         = get_handle();
+    const auto problem    = MakeConvolutionProblem(conv, x_desc, w_desc);
+    const auto& y_desc    = problem.GetTensorDescriptor(miopenTensorConvolutionY);
+    const auto y_size     = y_desc.GetElementSize();
+    const auto transposed = conv.mode == miopenTranspose;
+
+    auto plan = miopen::MakeConvolutionPlan(handle, problem, solver);
+    EXPECT_EQ(plan.GetKind(),
+              transposed ? miopen::Plan::Kind::ConvolutionBackwardData
+                         : miopen::Plan::Kind::ConvolutionForward);
+    EXPECT_EQ(plan.GetTensorDescriptor(miopenTensorConvolutionY).GetLengths(),
+              y_desc.GetLengths());
+
+    const auto ws_size = plan.GetWorkspaceSize();
+    auto w             = handle.Write(MakeData(w_desc.GetElementSize(), 7));
+    auto y_legacy      = handle.Write(std::vector<float>(y_size));
+    auto y_plan        = handle.Write(std::vector<float>(y_size));
+    auto workspace     = handle.Write(std::vector<char>(std::max<std::size_t>(ws_size, 1)));
+
+    // Runs twice to check the buffers are bound again on each run.
+    for(std::size_t seed = 0; seed < 2; ++seed)
+    {
+        auto x = handle.Write(MakeData(x_desc.GetElementSize(), seed));
+
+        if(transposed)
+            conv.ConvolutionBackwardImmediate(handle,
+                                              x_desc,
+                                              x.get(),
+                                              w_desc,
+                                              w.get(),
+                                              y_desc,
+                                              y_legacy.get(),
+                                              workspace.get(),
+                                              ws_size,
+                                              solver);
+        else
+            conv.ConvolutionForwardImmediate(handle,
+                                             w_desc,
+                                             w.get(),
+                                             x_desc,
+                                             x.get(),
+                                             y_desc,
+                                             y_legacy.get(),
+                                             workspace.get(),
+                                             ws_size,
+                                             solver);
+
+        const miopenTensorArgument_t arguments[] = {
+            {miopenTensorConvolutionX, nullptr, x.get()},
+            {miopenTensorConvolutionW, nullptr, w.get()},
+            {miopenTensorConvolutionY, nullptr, y_plan.get()},
+        };
+        plan.Run(handle, arguments, 3, workspace.get(), ws_size);
+
+        EXPECT_EQ(handle.Read<float>(y_plan, y_size), handle.Read<float>(y_legacy, y_size));
+    }
+}
+} // namespace
+
+TEST(Plan, PoolingForwardMatchesLegacy)
+{
+    auto&& handle      = get_handle();
+    const auto pooling = MakePooling();
+    const auto x_desc  = miopen::TensorDescriptor{miopenFloat, {2, 3, 8, 8}};
+    const auto y_desc  = pooling.GetForwardOutputTensor(x_desc);
+    const auto alpha   = 1.f;
+    const auto beta    = 0.f;
+
+    auto plan = pooling.MakeForwardPlan(handle, x_desc, y_desc, true);
+    EXPECT_EQ(plan.GetWorkspaceSize(), 0);
+
+    auto y_legacy     = handle.Write(std::vector<float>(y_desc.GetElementSize()));
+    auto y_plan       = handle.Write(std::vector<float>(y_desc.GetElementSize()));
+    auto index_legacy = handle.Write(std::vector<char>(pooling.GetWorkSpaceSize(y_desc)));
+    auto index_plan   = handle.Write(std::vector<char>(pooling.GetWorkSpaceSize(y_desc)));
+
+    // Runs twice to check the buffers are bound again on each run.
+    for(std::size_t seed = 0; seed < 2; ++seed)
+    {
+        auto x = handle.Write(MakeData(x_desc.GetElementSize(), seed));
+
+        pooling.Forward(handle,
+                        &alpha,
+                        x_desc,
+                        x.get(),
+                        &beta,
+                        y_desc,
+                        y_legacy.get(),
+                        true,
+                        index_legacy.get(),
+                        pooling.GetWorkSpaceSize(y_desc));
+
+        const miopenTensorArgument_t arguments[] = {
+            {miopenTensorPoolingX, nullptr, x.get()},
+            {miopenTensorPoolingY, nullptr, y_plan.get()},
+            {miopenTensorPoolingIndices, nullptr, index_plan.get()},
+        };
+        plan.Run(handle, arguments, 3, nullptr, 0);
+
+        EXPECT_EQ(handle.Read<float>(y_plan, y_desc.GetElementSize()),
+                  handle.Read<float>(y_legacy, y_desc.GetElementSize()));
+    }
+}
+
+TEST(Plan, ConvolutionForwardMatchesImmediate)
+{
+    const auto conv = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    CheckConvolutionPlan(conv,
+                         miopen::TensorDescriptor{miopenFloat, {2, 8, 10, 10}},
+                         miopen::TensorDescriptor{miopenFloat, {4, 8, 3, 3}},
+                         miopen::solver::Id{"ConvDirectNaiveConvFwd"});
+}
+
+TEST(Plan, TransposedConvolutionMatchesImmediate)
+{
+    // The plan runs backward data with X and Y swapped.
+    const auto conv = miopen::ConvolutionDescriptor{
+        2, miopenTranspose, miopenPaddingDefault, {0, 0}, {2, 2}, {1, 1}};
+    CheckConvolutionPlan(conv,
+                         miopen::TensorDescriptor{miopenFloat, {2, 8, 5, 5}},
+                         miopen::TensorDescriptor{miopenFloat, {8, 4, 2, 2}},
+                         miopen::solver::Id{"ConvDirectNaiveConvBwd"});
+}
+
+TEST(Plan, BatchNormInferenceMatchesLegacy)
+{
+    auto&& handle      = get_handle();
+    const auto mode    = miopenBNSpatial;
+    const auto x_desc  = miopen::TensorDescriptor{miopenFloat, {2, 4, 6, 6}};
+    auto bn_desc       = miopen::TensorDescriptor{};
+    const auto epsilon = 1e-5;
+    const auto alpha   = 1.f;
+    const auto beta    = 0.f;
+    miopen::DeriveBNTensorDescriptor(bn_desc, x_desc, mode);
+
+    auto plan = miopen::MakeBatchNormForwardInferencePlan(
+        handle, mode, x_desc, x_desc, bn_desc, epsilon);
+
+    const auto channels = bn_desc.GetElementSize();
+    auto x              = handle.Write(MakeData(x_desc.GetElementSize(), 0));
+    auto scale          = handle.Write(MakeData(channels, 1));
+    auto bias           = handle.Write(MakeData(channels, 2));
+    auto mean           = handle.Write(MakeData(channels, 3));
+    auto variance       = handle.Write(std::vector<float>(channels, 0.5f));
+    auto y_legacy       = handle.Write(std::vector<float>(x_desc.GetElementSize()));
+    auto y_plan         = handle.Write(std::vector<float>(x_desc.GetElementSize()));
+
+    miopen::BatchNormForwardInference(handle,
+                                      mode,
+                                      &alpha,
+                                      &beta,
+                                      x_desc,
+                                      x.get(),
+                                      x_desc,
+                                      y_legacy.get(),
+                                      bn_desc,
+                                      scale.get(),
+                                      bias.get(),
+                                      mean.get(),
+                                      variance.get(),
+                                      epsilon);
+
+    const miopenTensorArgument_t arguments[] = {
+        {miopenTensorBatchnormX, nullptr, x.get()},
+        {miopenTensorBatchnormY, nullptr, y_plan.get()},
+        {miopenTensorBatchnormScale, nullptr, scale.get()},
+        {miopenTensorBatchnormBias, nullptr, bias.get()},
+        {miopenTensorBatchnormRunningMean, nullptr, mean.get()},
+        {miopenTensorBatchnormRunningVariance, nullptr, variance.get()},
+    };
+    plan.Run(handle, arguments, 6, nullptr, 0);
+
+    EXPECT_EQ(handle.Read<float>(y_plan, x_desc.GetElementSize()),
+              handle.Read<float>(y_legacy, x_desc.GetElementSize()));
+}
+
+TEST(Plan, ChecksArguments)
+{
+    auto&& handle      = get_handle();
+    const auto pooling = MakePooling();
+    const auto x_desc  = miopen::TensorDescriptor{miopenFloat, {1, 1, 4, 4}};
+    const auto y_desc  = pooling.GetForwardOutputTensor(x_desc);
+
+    auto plan = pooling.MakeForwardPlan(handle, x_desc, y_desc, false);
+    EXPECT_EQ(plan.GetTensorDescriptor(miopenTensorPoolingY).GetLengths(), y_desc.GetLengths());
+
+    auto x = handle.Write(std::vector<float>(x_desc.GetElementSize()));
+    auto y = handle.Write(std::vector<float>(y_desc.GetElementSize()));
+
+    const miopenTensorArgument_t missing[] = {{miopenTensorPoolingX, nullptr, x.get()}};
+    EXPECT_ANY_THROW(plan.Run(handle, missing, 1, nullptr, 0));
+
+    const miopenTensorArgument_t unknown[] = {
+        {miopenTensorPoolingX, nullptr, x.get()},
+        {miopenTensorPoolingY, nullptr, y.get()},
+        {miopenTensorConvolutionW, nullptr, y.get()},
+    };
+    EXPECT_ANY_THROW(plan.Run(handle, unknown, 3, nullptr, 0));
+
+    const miopenTensorArgument_t null_buffer[] = {
+        {miopenTensorPoolingX, nullptr, x.get()},
+        {miopenTensorPoolingY, nullptr, nullptr},
+    };
+    EXPECT_ANY_THROW(plan.Run(handle, null_buffer, 2, nullptr, 0));
+
+    for(const auto id : {-1, 64, 1000})
+    {
+        const miopenTensorArgument_t out_of_range[] = {
+            {miopenTensorPoolingX, nullptr, x.get()},
+            {static_cast<miopenTensorArgumentId_t>(id), nullptr, y.get()},
+        };
+        EXPECT_ANY_THROW(plan.Run(handle, out_of_range, 2, nullptr, 0));
+    }
+
+    const miopenTensorArgument_t arguments[] = {
+        {miopenTensorPoolingX, nullptr, x.get()},
+        {miopenTensorPoolingY, nullptr, y.get()},
+    };
+    EXPECT_NO_THROW(plan.Run(handle, arguments, 2, nullptr, 0));
+}
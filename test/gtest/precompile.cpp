@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/precompile.hpp>
+#include <miopen/problem_description.hpp>
+
+#include "get_handle.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace {
+const std::string resnet_layer =
+    "./bin/MIOpenDriver conv --batchsize 64 --spatial_dim 2 --pad_h 0 --pad_w 0 --pad_d 0 "
+    "--conv_stride_h 2 --conv_stride_w 2 --conv_stride_d 1 --dilation_h 1 --dilation_w 1 "
+    "--dilation_d 1 --group_count 1 --mode conv --pad_mode default --trans_output_pad_h 0 "
+    "--trans_output_pad_w 0 --trans_output_pad_d 0 --out_layout NCHW --in_d 1 --in_h 14 "
+    "--in_w 14 --fil_d 1 --fil_h 1 --fil_w 1 --in_channels 1024 --out_channels 2048 --forw 1";
+
+std::vector<std::size_t> Lengths(const miopen::Problem& problem, miopenTensorArgumentId_t id)
+{
+    return problem.GetTensorDescriptor(id).GetLengths();
+}
+} // namespace
+
+TEST(PrecompileDriverCommands, ParsesPerfModelLine)
+{
+    const auto problems = miopen::ParseDriverCommand(resnet_layer);
+
+    ASSERT_EQ(problems.size(), 1);
+    const auto& problem = problems.front();
+    EXPECT_EQ(problem.GetDirection(), miopenProblemDirectionForward);
+    EXPECT_EQ(Lengths(problem, miopenTensorConvolutionX),
+              (std::vector<std::size_t>{64, 1024, 14, 14}));
+    EXPECT_EQ(Lengths(problem, miopenTensorConvolutionW),
+              (std::vector<std::size_t>{2048, 1024, 1, 1}));
+    EXPECT_EQ(Lengths(problem, miopenTensorConvolutionY),
+              (std::vector<std::size_t>{64, 2048, 7, 7}));
+}
+
+TEST(PrecompileDriverCommands, MakesProblemPerDirection)
+{
+    const auto problems = miopen::ParseDriverCommand(
+        "convfp16 -n 8 -c 16 -k 32 -H 28 -W 28 -y 3 -x 3 -p 1 -q 1 -g 2");
+
+    ASSERT_EQ(problems.size(), 3);
+    EXPECT_EQ(problems[0].GetDirection(), miopenProblemDirectionForward);
+    EXPECT_EQ(problems[1].GetDirection(), miopenProblemDirectionBackward);
+    EXPECT_EQ(problems[2].GetDirection(), miopenProblemDirectionBackwardWeights);
+
+    const auto& w = problems[0].GetTensorDescriptor(miopenTensorConvolutionW);
+    EXPECT_EQ(w.GetType(), miopenHalf);
+    EXPECT_EQ(w.GetLengths(), (std::vector<std::size_t>{32, 8, 3, 3}));
+    EXPECT_EQ(Lengths(problems[0], miopenTensorConvolutionY),
+              (std::vector<std::size_t>{8, 32, 28, 28}));
+}
+
+TEST(PrecompileDriverCommands, SkipsOtherLines)
+{
+    std::istringstream file{"# ResNet\n\n" + resnet_layer +
+                            "\n./bin/MIOpenDriver pool -n 64 -c 64 -H 112 -W 112\n" +
+                            resnet_layer + "\n"};
+
+    EXPECT_EQ(miopen::ParseDriverCommands(file).size(), 2);
+    EXPECT_ANY_THROW(miopen::ParseDriverCommand("conv --in_h"));
+}
+
+TEST(PrecompileProblems, BuildsImmediateModeKernels)
+{
+    auto&& handle       = get_handle();
+    const auto problems = miopen::ParseDriverCommand(
+        "conv -n 4 -c 32 -k 64 -H 14 -W 14 -y 3 -x 3 -p 1 -q 1 --forw 3");
+
+    ASSERT_EQ(miopen::PrecompileProblems(handle, problems), problems.size());
+
+    for(const auto& problem : problems)
+    {
+        const auto& conv =
+            boost::get<miopen::ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+
+        const auto solution = conv.GetImmediateSolution(handle, problem.AsConvolution());
+        ASSERT_TRUE(solution.Succeeded());
+        for(const auto& kernel : solution.construction_params)
+            EXPECT_TRUE(handle.HasProgram(kernel.kernel_file, kernel.comp_options))
+                << kernel.kernel_file;
+    }
+}
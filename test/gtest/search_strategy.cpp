@@ -0,0 +1,303 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/search_strategy.hpp>
+#include <miopen/tuning_pipeline.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace miopen::solver;
+
+namespace {
+
+// 4 parameters with 10 values each. The kernel time is a bowl with the minimum of 1.0
+// at (3, 7, 2, 5).
+constexpr std::size_t n_values = 10;
+
+struct Space
+{
+    std::vector<std::vector<std::size_t>> params;
+    std::vector<ConfigFeatures> features;
+
+    Space()
+    {
+        for(std::size_t a = 0; a < n_values; ++a)
+            for(std::size_t b = 0; b < n_values; ++b)
+                for(std::size_t c = 0; c < n_values; ++c)
+                    for(std::size_t d = 0; d < n_values; ++d)
+                    {
+                        params.push_back({a, b, c, d});
+                        features.push_back(GetConfigFeatures(
+                            std::to_string(a) + ',' + std::to_string(b) + ',' +
+                            std::to_string(c) + ',' + std::to_string(d)));
+                    }
+    }
+
+    float Time(std::size_t idx) const
+    {
+        const std::size_t optimum[] = {3, 7, 2, 5};
+        const float weights[]       = {0.5f, 0.2f, 0.05f, 0.01f};
+        float time                  = 1.0f;
+        for(std::size_t i = 0; i < 4; ++i)
+        {
+            const auto diff = static_cast<float>(params[idx][i]) - optimum[i];
+            time += weights[i] * diff * diff;
+        }
+        return time;
+    }
+};
+
+struct SearchResult
+{
+    float best_time         = std::numeric_limits<float>::max();
+    float best_screened     = std::numeric_limits<float>::max();
+    std::size_t evaluations = 0;
+    std::vector<int> proposed;
+};
+
+SearchResult RunSearch(SearchStrategyKind kind, std::size_t budget)
+{
+    const Space space;
+    auto strategy = MakeSearchStrategy(kind, space.features, budget, 42);
+    SearchResult result;
+    result.proposed.resize(space.features.size());
+
+    // Proposals are evaluated in batches to mimic configs in flight in GenericSearch.
+    while(result.evaluations < budget && !strategy->IsExhausted())
+    {
+        std::vector<SearchProposal> batch;
+        while(batch.size() < 4 && result.evaluations + batch.size() < budget)
+        {
+            const auto proposal = strategy->Propose();
+            if(!proposal)
+                break;
+            batch.push_back(*proposal);
+        }
+        if(batch.empty())
+            break;
+        for(const auto& proposal : batch)
+        {
+            ++result.evaluations;
+            const auto time      = space.Time(proposal.index);
+            result.best_screened = std::min(result.best_screened, time);
+            if(proposal.repeats == 0)
+            {
+                ++result.proposed.at(proposal.index);
+                result.best_time = std::min(result.best_time, time);
+            }
+            strategy->Observe(proposal, time);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(TuningSearchStrategy, ExhaustiveVisitsAll)
+{
+    const auto result =
+        RunSearch(SearchStrategyKind::Exhaustive, std::numeric_limits<std::size_t>::max());
+    EXPECT_EQ(result.evaluations, n_values * n_values * n_values * n_values);
+    for(const auto count : result.proposed)
+        EXPECT_EQ(count, 1);
+    EXPECT_FLOAT_EQ(result.best_time, 1.0f);
+}
+
+TEST(TuningSearchStrategy, GuidedSearchesFindNearOptimum)
+{
+    const auto n_configs = n_values * n_values * n_values * n_values;
+    const auto budget    = n_configs / 20;
+
+    for(const auto kind :
+        {SearchStrategyKind::Annealing, SearchStrategyKind::Genetic, SearchStrategyKind::Bayesian})
+    {
+        const auto result = RunSearch(kind, budget);
+        EXPECT_LE(result.evaluations, budget) << kind;
+        EXPECT_LT(result.best_time, 1.1f) << kind;
+        // Final measurements never repeat a config.
+        for(const auto count : result.proposed)
+            EXPECT_LE(count, 1) << kind;
+    }
+}
+
+TEST(TuningSearchStrategy, HalvingKeepsBestScreened)
+{
+    const auto n_configs = n_values * n_values * n_values * n_values;
+    const auto budget    = n_configs / 20;
+
+    // Successive halving samples the space at random, so it is only expected to finally
+    // measure the best config of its sample.
+    const auto result = RunSearch(SearchStrategyKind::SuccessiveHalving, budget);
+    EXPECT_LE(result.evaluations, budget);
+    EXPECT_FLOAT_EQ(result.best_time, result.best_screened);
+    for(const auto count : result.proposed)
+        EXPECT_LE(count, 1);
+}
+
+TEST(TuningSearchStrategy, ReplayedConfigsAreNotProposed)
+{
+    const Space space;
+    for(const auto kind : {SearchStrategyKind::Exhaustive,
+                           SearchStrategyKind::SuccessiveHalving,
+                           SearchStrategyKind::Annealing,
+                           SearchStrategyKind::Genetic,
+                           SearchStrategyKind::Bayesian})
+    {
+        const auto budget = space.features.size() / 4;
+        TuningSearch search(MakeSearchStrategy(kind, space.features, budget, 7), budget);
+        for(std::size_t idx = 0; idx < space.features.size(); idx += 8)
+            search.Replay(idx, space.Time(idx));
+
+        std::size_t n_proposed = 0;
+        while(auto proposal = search.Next())
+        {
+            const auto& current = proposal->Get();
+            if(current.repeats == 0)
+            {
+                ++n_proposed;
+                EXPECT_NE(current.index % 8, 0) << kind;
+            }
+            proposal->Report(space.Time(current.index));
+        }
+        EXPECT_GT(n_proposed, 0u) << kind;
+        EXPECT_TRUE(search.IsComplete()) << kind;
+    }
+}
+
+TEST(TuningSearchStrategy, FeaturesFromSerializedConfig)
+{
+    const auto features = GetConfigFeatures("64,32,4,1");
+    ASSERT_EQ(features.size(), 4u);
+    EXPECT_EQ(features[0], "64");
+    EXPECT_EQ(features[3], "1");
+}
+
+TEST(TuningSearchStrategy, PipelineWithWaitingStrategy)
+{
+    // Successive halving waits for all results of a round before the next one, while the
+    // compile threads keep asking for work.
+    const Space space;
+    const auto budget = space.features.size() / 10;
+    TuningSearch search(
+        MakeSearchStrategy(SearchStrategyKind::SuccessiveHalving, space.features, budget, 1),
+        budget);
+
+    std::mutex mutex;
+    std::size_t n_measured = 0;
+    auto best_time         = std::numeric_limits<float>::max();
+
+    RunTuningPipeline<PendingProposal>(
+        budget,
+        4,
+        2,
+        2,
+        std::chrono::milliseconds{std::chrono::hours{1}},
+        [&](std::size_t) { return search.Next(); },
+        [&](std::size_t, PendingProposal&& proposal) {
+            const auto time = space.Time(proposal.Get().index);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++n_measured;
+                if(proposal.Get().repeats == 0)
+                    best_time = std::min(best_time, time);
+            }
+            proposal.Report(time);
+        });
+
+    EXPECT_GT(n_measured, 0u);
+    EXPECT_LE(n_measured, budget);
+    EXPECT_LT(best_time, std::numeric_limits<float>::max());
+}
+
+TEST(TuningSearchStrategy, PipelineWithFailingCompile)
+{
+    // Proposals lost to compilation errors must still reach the strategy, otherwise the compile
+    // threads wait for their results forever.
+    const Space space;
+    const auto budget = space.features.size() / 10;
+    TuningSearch search(
+        MakeSearchStrategy(SearchStrategyKind::SuccessiveHalving, space.features, budget, 1),
+        budget);
+
+    std::atomic<std::size_t> n_compiled{0};
+    std::atomic<std::size_t> n_measured{0};
+
+    RunTuningPipeline<PendingProposal>(
+        budget,
+        4,
+        2,
+        2,
+        std::chrono::milliseconds{std::chrono::hours{1}},
+        [&](std::size_t) -> boost::optional<PendingProposal> {
+            auto proposal = search.Next();
+            if(proposal && n_compiled++ % 3 == 0)
+                throw std::runtime_error("compilation failed");
+            return proposal;
+        },
+        [&](std::size_t, PendingProposal&& proposal) {
+            ++n_measured;
+            proposal.Report(space.Time(proposal.Get().index));
+        });
+
+    EXPECT_GT(n_measured.load(), 0u);
+    EXPECT_LT(n_measured.load(), n_compiled.load());
+    EXPECT_TRUE(search.IsComplete());
+}
+
+TEST(TuningSearchStrategy, PipelineWithFailingMeasurement)
+{
+    // After a measurement has thrown, the pipeline drains the remaining proposals unmeasured.
+    const Space space;
+    const auto budget = space.features.size() / 10;
+    TuningSearch search(
+        MakeSearchStrategy(SearchStrategyKind::SuccessiveHalving, space.features, budget, 1),
+        budget);
+
+    std::atomic<std::size_t> n_measured{0};
+
+    EXPECT_THROW(RunTuningPipeline<PendingProposal>(
+                     budget,
+                     4,
+                     1,
+                     2,
+                     std::chrono::milliseconds{std::chrono::hours{1}},
+                     [&](std::size_t) { return search.Next(); },
+                     [&](std::size_t, PendingProposal&& proposal) {
+                         if(++n_measured == 5)
+                             throw std::runtime_error("measurement failed");
+                         proposal.Report(space.Time(proposal.Get().index));
+                     }),
+                 std::runtime_error);
+
+    EXPECT_TRUE(search.IsComplete());
+}
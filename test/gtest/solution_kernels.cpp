@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solution.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include "get_handle.hpp"
+
+#include <algorithm>
+
+namespace {
+miopen::Solution MakeSolution()
+{
+    const auto conv = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    const auto x    = miopen::TensorDescriptor{miopenFloat, {1, 8, 16, 16}};
+    const auto w    = miopen::TensorDescriptor{miopenFloat, {8, 8, 3, 3}};
+
+    auto problem = miopen::Problem{};
+    problem.SetDirection(miopenProblemDirectionForward);
+    problem.SetOperatorDescriptor(conv);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionX, x);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionW, w);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionY, conv.GetForwardOutputTensor(x, w));
+
+    auto solution = miopen::Solution{};
+    solution.SetProblem(problem);
+    solution.SetSolver(miopen::solver::Id{"ConvDirectNaiveConvFwd"});
+    return solution;
+}
+} // namespace
+
+TEST(SolutionKernels, SerializedOnlyWhenEmbedded)
+{
+    const nlohmann::json json = MakeSolution();
+    EXPECT_EQ(json.find("kernels"), json.end());
+}
+
+TEST(SolutionKernels, EmbedAndLoad)
+{
+    auto&& handle = get_handle();
+    auto solution = MakeSolution();
+
+    solution.EmbedKernels(handle);
+    ASSERT_TRUE(solution.HasKernels());
+
+    const auto blob     = nlohmann::json::to_msgpack(nlohmann::json(solution));
+    const auto json     = nlohmann::json::from_msgpack(blob);
+    const auto& kernels = json.at("kernels").at("list");
+    ASSERT_FALSE(kernels.empty());
+
+    const auto loaded = json.get<miopen::Solution>();
+    ASSERT_TRUE(loaded.HasKernels());
+
+    const auto program = kernels[0].at("program").get<std::string>();
+    const auto options = kernels[0].at("options").get<std::string>();
+
+    // A new handle starts with an empty program cache.
+    auto fresh = miopen::Handle{};
+    ASSERT_FALSE(fresh.HasProgram(program, options));
+    loaded.LoadKernels(fresh);
+    EXPECT_TRUE(fresh.HasProgram(program, options));
+}
+
+TEST(SolutionKernels, IgnoredOnOtherTarget)
+{
+    auto&& handle = get_handle();
+    auto solution = MakeSolution();
+    solution.EmbedKernels(handle);
+
+    auto json                 = nlohmann::json(solution);
+    json["kernels"]["target"] = "unknown_target";
+
+    const auto loaded  = json.get<miopen::Solution>();
+    const auto& kernel = json["kernels"]["list"][0];
+    const auto program = kernel.at("program").get<std::string>();
+    const auto options = kernel.at("options").get<std::string>();
+
+    auto fresh = miopen::Handle{};
+    loaded.LoadKernels(fresh);
+    EXPECT_FALSE(fresh.HasProgram(program, options));
+}
+
+#if MIOPEN_BACKEND_HIP
+TEST(SolutionKernels, HipSource)
+{
+    // Code objects of HIP sources built from files are read back from the binary cache, which
+    // has the hash of the included headers in the key.
+    auto&& handle = get_handle();
+    auto solution = MakeSolution();
+    solution.EmbedKernels(handle);
+
+    const auto json    = nlohmann::json(solution);
+    const auto& kernel = json.at("kernels").at("list").at(0);
+    const auto program = kernel.at("program").get<std::string>();
+    const auto options = kernel.at("options").get<std::string>();
+    const auto& binary = kernel.at("binary").get_binary();
+    ASSERT_TRUE(miopen::EndsWith(program, ".cpp"));
+    ASSERT_FALSE(binary.empty());
+
+    // Another handle finds the program in the binary cache instead of building it.
+    auto fresh          = miopen::Handle{};
+    const auto reloaded = fresh.GetProgramBinary(program, options);
+    EXPECT_TRUE(std::equal(reloaded.begin(), reloaded.end(), binary.begin(), binary.end()));
+}
+#endif
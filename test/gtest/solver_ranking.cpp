@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/conv/heuristic_model/solver_ranking.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/tensor.hpp>
+
+#include <sstream>
+#include <string>
+
+using miopen::ai::ranking::ConvDbKeyFeatures;
+using miopen::ai::ranking::ParseConvDbKey;
+
+TEST(SolverRanking, ParseKey2D)
+{
+    auto f = ConvDbKeyFeatures{};
+    ASSERT_TRUE(ParseConvDbKey("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F", f));
+    const auto expected = decltype(f.values){
+        576, 1, 4, 4, 1, 1, 1, 192, 1, 4, 4, 8, 0, 1, 1, 1, 2, 2, 1, 3, 3, 0, 1};
+    EXPECT_EQ(f.values, expected);
+    EXPECT_EQ(f.layout, "NCHW");
+    EXPECT_EQ(f.data_type, "FP32");
+    EXPECT_EQ(f.direction, 'F');
+
+    ASSERT_TRUE(ParseConvDbKey("128-56-56-3x3-128-56-56-32-1x1-1x1-1x1-0-NHWC-NCHW-NCHW-FP16-B_g32",
+                               f));
+    EXPECT_EQ(f.values[22], 32);
+    EXPECT_EQ(f.layout, "NHWC");
+    EXPECT_EQ(f.data_type, "FP16");
+    EXPECT_EQ(f.direction, 'B');
+}
+
+TEST(SolverRanking, ParseKey3D)
+{
+    auto f = ConvDbKeyFeatures{};
+    ASSERT_TRUE(
+        ParseConvDbKey("16-8-32-32-3x3x3-32-4-16-16-2-1x1x1-2x2x2-1x1x1-0-NCDHW-BF16-W", f));
+    const auto expected = decltype(f.values){
+        16, 8, 32, 32, 3, 3, 3, 32, 4, 16, 16, 2, 1, 1, 1, 2, 2, 2, 1, 1, 1, 0, 1};
+    EXPECT_EQ(f.values, expected);
+    EXPECT_EQ(f.layout, "NCDHW");
+    EXPECT_EQ(f.data_type, "BF16");
+    EXPECT_EQ(f.direction, 'W');
+}
+
+TEST(SolverRanking, ParseMalformedKey)
+{
+    auto f = ConvDbKeyFeatures{};
+    EXPECT_FALSE(ParseConvDbKey("", f));
+    EXPECT_FALSE(ParseConvDbKey("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-X", f));
+    EXPECT_FALSE(ParseConvDbKey("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32", f));
+    EXPECT_FALSE(ParseConvDbKey("576-4-4-1x1-192-4-a-8-1x1-2x2-3x3-0-NCHW-FP32-F", f));
+    EXPECT_FALSE(ParseConvDbKey("576-4-4-1x1-192-4-4-8-1x1-2x2x2-3x3-0-NCHW-FP32-F", f));
+    EXPECT_FALSE(ParseConvDbKey("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F_x1", f));
+}
+
+TEST(SolverRanking, ParseSerializedProblem)
+{
+    const auto in   = miopen::TensorDescriptor{miopenHalf, miopenTensorNHWC, {16, 64, 28, 28}};
+    const auto wei  = miopen::TensorDescriptor{miopenHalf, miopenTensorNHWC, {128, 32, 3, 3}};
+    const auto conv = miopen::ConvolutionDescriptor{{1, 1}, {2, 2}, {1, 1}, {0, 0}, 2};
+    const auto out  = conv.GetForwardOutputTensorWithLayout(in, wei, "NHWC", miopenHalf);
+    const auto problem =
+        miopen::ProblemDescription{in, wei, out, conv, miopen::conv::Direction::Forward};
+
+    std::ostringstream key;
+    problem.Serialize(key);
+    auto f = ConvDbKeyFeatures{};
+    ASSERT_TRUE(ParseConvDbKey(key.str(), f)) << key.str();
+
+    const auto& p = problem.conv_problem;
+    EXPECT_EQ(f.values[0], p.GetInChannels());
+    EXPECT_EQ(f.values[2], p.GetInHeight());
+    EXPECT_EQ(f.values[5], p.GetWeightsHeight());
+    EXPECT_EQ(f.values[7], p.GetOutChannels());
+    EXPECT_EQ(f.values[10], p.GetOutWidth());
+    EXPECT_EQ(f.values[11], p.GetInBatchSize());
+    EXPECT_EQ(f.values[13], 1); // pad_h
+    EXPECT_EQ(f.values[16], 2); // stride_h
+    EXPECT_EQ(f.values[22], 2); // group count
+    EXPECT_EQ(f.layout, "NHWC");
+    EXPECT_EQ(f.data_type, "FP16");
+    EXPECT_EQ(f.direction, 'F');
+}
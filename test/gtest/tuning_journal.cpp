@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/temp_file.hpp>
+#include <miopen/tuning_journal.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+
+using miopen::solver::TuningJournal;
+
+namespace {
+const std::string key = "gfx908_120 ConvHipImplicitGemmForwardV4R4Xdlops 64-28-28-3x3-128";
+} // namespace
+
+TEST(TuningJournal, ResumesMeasurements)
+{
+    const miopen::TempFile file{"tuning-journal"};
+    {
+        TuningJournal journal{file.Path(), key};
+        EXPECT_EQ(journal.Size(), 0u);
+        journal.Append("64,32,4,1", 0.5f);
+        journal.Append("128,32,4,1", boost::none);
+    }
+
+    TuningJournal journal{file.Path(), key};
+    EXPECT_EQ(journal.Size(), 2u);
+    const auto measured = journal.Find("64,32,4,1");
+    ASSERT_TRUE(measured && *measured);
+    EXPECT_FLOAT_EQ(**measured, 0.5f);
+    const auto failed = journal.Find("128,32,4,1");
+    ASSERT_TRUE(failed);
+    EXPECT_FALSE(*failed);
+    EXPECT_FALSE(journal.Find("256,32,4,1"));
+
+    // Appending to a resumed journal keeps the earlier results.
+    journal.Append("256,32,4,1", 0.25f);
+    EXPECT_EQ(TuningJournal(file.Path(), key).Size(), 3u);
+
+    journal.Remove();
+    EXPECT_FALSE(boost::filesystem::exists(file.Path()));
+}
+
+TEST(TuningJournal, IgnoresTruncatedLine)
+{
+    const miopen::TempFile file{"tuning-journal"};
+    {
+        std::ofstream out(file.Path());
+        out << key << "\n64,32,4,1=0.5\n128,32,4,1=0.7\n256,32,4";
+    }
+    EXPECT_EQ(TuningJournal(file.Path(), key).Size(), 2u);
+}
+
+TEST(TuningJournal, IgnoresOtherSearch)
+{
+    const miopen::TempFile file{"tuning-journal"};
+    {
+        TuningJournal journal{file.Path(), key};
+        journal.Append("64,32,4,1", 0.5f);
+    }
+
+    {
+        TuningJournal journal{file.Path(), "another key"};
+        EXPECT_EQ(journal.Size(), 0u);
+        journal.Append("128,32,4,1", 0.5f);
+    }
+
+    EXPECT_EQ(TuningJournal(file.Path(), key).Size(), 0u);
+    TuningJournal journal{file.Path(), "another key"};
+    EXPECT_EQ(journal.Size(), 1u);
+    EXPECT_TRUE(journal.Find("128,32,4,1"));
+}
@@ -0,0 +1,195 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/tuning_pipeline.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using miopen::solver::RunTuningPipeline;
+
+namespace {
+
+// Stands in for a compiled solution. The measured "kernel time" depends on the config only, so
+// the search result is known in advance.
+struct MockSolution
+{
+    std::size_t config;
+    float time;
+};
+
+float MockKernelTime(std::size_t config) { return 1.0f + static_cast<float>((config * 37) % 101); }
+
+const auto no_budget = std::chrono::milliseconds{std::chrono::hours{1}};
+
+} // namespace
+
+TEST(TuningPipeline, MeasuresEachConfigOnce)
+{
+    constexpr std::size_t n_items         = 500;
+    constexpr std::size_t compile_threads = 4;
+    constexpr std::size_t measure_workers = 3;
+    constexpr std::size_t capacity        = 4;
+
+    std::vector<std::atomic<int>> measured(n_items);
+    std::atomic<int> in_flight{0};
+    std::atomic<int> max_in_flight{0};
+    std::vector<std::atomic<int>> per_worker(measure_workers);
+
+    RunTuningPipeline<MockSolution>(
+        n_items,
+        compile_threads,
+        measure_workers,
+        capacity,
+        no_budget,
+        [&](std::size_t idx) -> boost::optional<MockSolution> {
+            const auto now = ++in_flight;
+            auto prev      = max_in_flight.load();
+            while(prev < now && !max_in_flight.compare_exchange_weak(prev, now)) {}
+            return MockSolution{idx, MockKernelTime(idx)};
+        },
+        [&](std::size_t worker, MockSolution&& solution) {
+            --in_flight;
+            ++measured.at(solution.config);
+            ++per_worker.at(worker);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        });
+
+    for(const auto& count : measured)
+        EXPECT_EQ(count.load(), 1);
+    // Compile threads may each hold one item while waiting for room in the queue and
+    // measurement workers may each hold one popped item.
+    EXPECT_LE(max_in_flight.load(), static_cast<int>(capacity + compile_threads + measure_workers));
+    for(const auto& count : per_worker)
+        EXPECT_GT(count.load(), 0);
+}
+
+TEST(TuningPipeline, SelectsBest)
+{
+    constexpr std::size_t n_items = 300;
+
+    std::mutex mutex;
+    auto best_time   = std::numeric_limits<float>::max();
+    auto best_config = n_items;
+
+    RunTuningPipeline<MockSolution>(
+        n_items,
+        3,
+        2,
+        2,
+        no_budget,
+        [](std::size_t idx) -> boost::optional<MockSolution> {
+            return MockSolution{idx, MockKernelTime(idx)};
+        },
+        [&](std::size_t, MockSolution&& solution) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(solution.time < best_time)
+            {
+                best_time   = solution.time;
+                best_config = solution.config;
+            }
+        });
+
+    std::vector<float> times;
+    for(std::size_t idx = 0; idx < n_items; ++idx)
+        times.push_back(MockKernelTime(idx));
+    const auto expected = std::min_element(times.begin(), times.end()) - times.begin();
+    EXPECT_EQ(best_config, static_cast<std::size_t>(expected));
+}
+
+TEST(TuningPipeline, StopsOnTimeBudget)
+{
+    constexpr std::size_t n_items = 10000;
+    std::atomic<std::size_t> n_measured{0};
+
+    RunTuningPipeline<MockSolution>(
+        n_items,
+        2,
+        1,
+        2,
+        std::chrono::milliseconds{50},
+        [](std::size_t idx) -> boost::optional<MockSolution> {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return MockSolution{idx, MockKernelTime(idx)};
+        },
+        [&](std::size_t, MockSolution&&) { ++n_measured; });
+
+    EXPECT_GT(n_measured.load(), 0);
+    EXPECT_LT(n_measured.load(), n_items);
+}
+
+TEST(TuningPipeline, DrainsAfterFailures)
+{
+    constexpr std::size_t n_items = 100;
+    std::atomic<std::size_t> n_compiled{0};
+
+    EXPECT_THROW(RunTuningPipeline<MockSolution>(
+                     n_items,
+                     4,
+                     2,
+                     1,
+                     no_budget,
+                     [&](std::size_t idx) -> boost::optional<MockSolution> {
+                         ++n_compiled;
+                         if(idx % 10 == 0)
+                             throw std::runtime_error("compilation failed");
+                         return MockSolution{idx, MockKernelTime(idx)};
+                     },
+                     [](std::size_t, MockSolution&& solution) {
+                         if(solution.config == 51)
+                             throw std::runtime_error("measurement failed");
+                     }),
+                 std::runtime_error);
+
+    EXPECT_EQ(n_compiled.load(), n_items);
+}
+
+TEST(TuningPipeline, StopsOnEmptyItem)
+{
+    constexpr std::size_t n_items = 1000;
+    std::atomic<std::size_t> n_measured{0};
+
+    RunTuningPipeline<MockSolution>(
+        n_items,
+        3,
+        2,
+        2,
+        no_budget,
+        [](std::size_t idx) -> boost::optional<MockSolution> {
+            if(idx >= 10)
+                return boost::none;
+            return MockSolution{idx, MockKernelTime(idx)};
+        },
+        [&](std::size_t, MockSolution&&) { ++n_measured; });
+
+    EXPECT_EQ(n_measured.load(), 10u);
+}
@@ -27,6 +27,7 @@
 #include "test.hpp"
 #include "driver.hpp"
 
+#include <miopen/compiled_db.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/lock_file.hpp>
@@ -41,7 +42,9 @@
 #include <array>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <limits>
 #include <random>
@@ -579,6 +582,71 @@ public:
     }
 };
 
+class DbIndexTest : public DbTest
+{
+public:
+    DbIndexTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                          "Test",
+                          "Testing " << ArgsHelper::db_class::Get<PlainTextDb>()
+                                     << " index consistency...");
+
+        const TestData key0(1, 2), key1(3, 4), key2(5, 6);
+
+        {
+            std::ofstream file(temp_file);
+            file << "ill-formed line" << std::endl;
+            file << key1.x << ',' << key1.y << '=' << std::endl;
+            file << key0.x << ',' << key0.y << '=' << id0() << ':' << value0().x << ','
+                 << value0().y << std::endl;
+            file << key1.x << ',' << key1.y << '=' << id0() << ':' << value1().x << ','
+                 << value1().y << std::endl;
+            file << key0.x << ',' << key0.y << '=' << id0() << ':' << value2().x << ','
+                 << value2().y << std::endl;
+        }
+
+        PlainTextDb reader(temp_file);
+        PlainTextDb writer(temp_file);
+        TestData read;
+
+        // Only the first valid record with the key is visible.
+        EXPECT(reader.Load(key0, id0(), read));
+        EXPECT_EQUAL(value0(), read);
+        EXPECT(reader.Load(key1, id0(), read));
+        EXPECT_EQUAL(value1(), read);
+        EXPECT(!reader.FindRecord(key2));
+
+        // Changes made by other instances are detected.
+        EXPECT(writer.Update(key2, id1(), value1()));
+        EXPECT(reader.Load(key2, id1(), read));
+        EXPECT_EQUAL(value1(), read);
+
+        // Same size rewrite of a record in the middle of the file.
+        EXPECT(writer.Update(key1, id0(), value2()));
+        EXPECT(reader.Load(key1, id0(), read));
+        EXPECT_EQUAL(value2(), read);
+        EXPECT(reader.Load(key2, id1(), read));
+        EXPECT_EQUAL(value1(), read);
+
+        // Own writes keep the index valid and shift the following records.
+        EXPECT(reader.Update(key1, id1(), value0()));
+        EXPECT(reader.Load(key1, id1(), read));
+        EXPECT_EQUAL(value0(), read);
+        EXPECT(reader.Load(key2, id1(), read));
+        EXPECT_EQUAL(value1(), read);
+
+        // Removal of the first record uncovers the duplicate.
+        EXPECT(reader.RemoveRecord(key0));
+        EXPECT(reader.Load(key0, id0(), read));
+        EXPECT_EQUAL(value2(), read);
+        EXPECT(writer.Load(key0, id0(), read));
+        EXPECT_EQUAL(value2(), read);
+    }
+};
+
 template <class TDb>
 class DbParallelTest : public DbTest
 {
@@ -1201,6 +1269,128 @@ private:
     }
 };
 
+class DbCompiledReadTest : public DbMultiFileTest
+{
+public:
+    DbCompiledReadTest(TempFile& temp_file_) : DbMultiFileTest(temp_file_) {}
+
+    void Run()
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Running compiled db read test...");
+
+        ResetDb();
+
+        const TestData other_key(3, 4);
+
+        {
+            std::ofstream file(temp_file);
+            file << "ill-formed line" << std::endl;
+            file << key().x << ',' << key().y << '=' << id1() << ':' << value1().x << ','
+                 << value1().y << ';' << id0() << ':' << value0().x << ',' << value0().y
+                 << std::endl;
+            file << other_key.x << ',' << other_key.y << '=' << id0() << ':' << value2().x
+                 << ',' << value2().y << std::endl;
+            file << key().x << ',' << key().y << '=' << id0() << ':' << value2().x << ','
+                 << value2().y << std::endl;
+        }
+
+        const auto compiled_path = CompiledDb::GetCompiledPath(temp_file);
+        EXPECT(CompiledDb::Compile(temp_file, compiled_path));
+
+        const auto compiled = CompiledDb::Open(compiled_path);
+        EXPECT(compiled != nullptr);
+        EXPECT_EQUAL(compiled->GetRecordCount(), 2);
+        EXPECT(compiled->Find(Serialize(other_key)) != nullptr);
+        EXPECT(compiled->Find(Serialize(TestData(100, 200))) == nullptr);
+
+        MultiFileDb<ReadonlyRamDb, RamDb, true> db(temp_file, user_db_path);
+        ValidateSingleEntry(key(), common_data(), db);
+
+        TestData read;
+        EXPECT(db.Load(other_key, id0(), read));
+        EXPECT_EQUAL(value2(), read);
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+
+        CheckCorruptedRecord(compiled_path);
+        CheckOutdated(*compiled, compiled_path);
+    }
+
+private:
+    static std::string Serialize(const TestData& data)
+    {
+        std::ostringstream ss;
+        data.Serialize(ss);
+        return ss.str();
+    }
+
+    static std::string ReadFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    static void WriteFile(const std::string& path, const std::string& contents)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << contents;
+    }
+
+    void CheckCorruptedRecord(const std::string& compiled_path) const
+    {
+        const auto corrupted_path = compiled_path + ".corrupted";
+        auto contents             = ReadFile(compiled_path);
+        auto header               = CompiledDb::Header{};
+        auto records              = std::array<CompiledDb::Record, 2>{};
+        const auto record_pos     = contents.data() + sizeof(CompiledDb::Header);
+
+        std::memcpy(&header, contents.data(), sizeof(header));
+        std::memcpy(records.data(), record_pos, sizeof(records));
+
+        const auto get_key = [&](const CompiledDb::Record& record) {
+            return std::string(contents.data() + header.strings_offset + record.key_offset,
+                               record.key_size);
+        };
+        const auto corrupted_key = get_key(records[0]);
+        const auto valid_key     = get_key(records[1]);
+
+        records[0].key_size = std::numeric_limits<std::uint32_t>::max();
+        std::memcpy(record_pos, records.data(), sizeof(records));
+        WriteFile(corrupted_path, contents);
+
+        // Records are validated on lookup, so other ones are still available.
+        const auto corrupted = CompiledDb::Open(corrupted_path);
+        EXPECT(corrupted != nullptr);
+        EXPECT(corrupted->Find(corrupted_key) == nullptr);
+        EXPECT(corrupted->Find(valid_key) != nullptr);
+        std::remove(corrupted_path.c_str());
+    }
+
+    void CheckOutdated(const CompiledDb& compiled, const std::string& compiled_path) const
+    {
+        const std::string path = temp_file;
+        EXPECT(!compiled.IsOutdated(path));
+
+        // Same contents with other modification time, e.g. after installation.
+        const auto mtime = boost::filesystem::last_write_time(path);
+        boost::filesystem::last_write_time(path, mtime + 10);
+        EXPECT(compiled.IsOutdated(path));
+
+        // Only the stamp is updated then.
+        EXPECT(CompiledDb::Compile(path, compiled_path));
+        const auto restamped = CompiledDb::Open(compiled_path);
+        EXPECT(restamped != nullptr);
+        EXPECT(!restamped->IsOutdated(path));
+        EXPECT_EQUAL(restamped->GetRecordCount(), compiled.GetRecordCount());
+
+        // Same size, other contents.
+        auto contents = ReadFile(path);
+        contents[0]   = contents[0] == 'i' ? 'I' : 'i';
+        WriteFile(path, contents);
+        boost::filesystem::last_write_time(path, mtime + 20);
+        EXPECT(restamped->IsOutdated(path));
+    }
+};
+
 class DbMultiFileWriteTest : public DbMultiFileTest
 {
 public:
@@ -1449,6 +1639,8 @@ struct PerfDbDriver : test_driver
 
         DbTests<RamDb>(temp_file);
         DbTests<PlainTextDb>(temp_file);
+        if(!DisableUserDbFileIO)
+            DbIndexTest{temp_file}.Run();
         MultiFileDbTests(temp_file);
     }
 
@@ -1485,6 +1677,7 @@ private:
             DbMultiFileReadTest<true>{temp_file}.Run();
             DbMultiFileReadTest<false>{temp_file}.Run();
             DbMultiFileWriteTest{temp_file}.Run();
+            DbCompiledReadTest{temp_file}.Run();
         }
         DbMultiFileOperationsTest{temp_file}.Run();
         DbMultiFileMultiThreadedReadTest{temp_file}.Run();
@@ -40,6 +40,7 @@
 #include <boost/thread.hpp>
 
 #include <array>
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -460,6 +461,91 @@ public:
     }
 };
 
+class DbWriteSessionTest : public DbTest
+{
+public:
+    void Run()
+    {
+        std::cout << "Testing batched db writes..." << std::endl;
+
+        ResetDb();
+
+        {
+            const auto session = db_inst.BeginWriteSession();
+            EXPECT(db_inst.Update(key(), id0(), value0()));
+            EXPECT(db_inst.Update(key(), id1(), value1()));
+            EXPECT(db_inst.Update(key(), id2(), value2()));
+
+            {
+                const auto nested = db_inst.BeginWriteSession();
+                EXPECT(db_inst.Remove(key(), id2()));
+            }
+
+            // Nothing is written until the outermost session ends, but the writing thread sees
+            // the queued records. Other threads neither see them nor have their writes queued.
+            EXPECT(!SQLitePerfDb(temp_file, false).FindRecord(key()));
+            Validate(db_inst);
+            const ProblemData other(1);
+            std::thread([&]() {
+                EXPECT(!db_inst.FindRecord(key()));
+                EXPECT(db_inst.Update(other, id0(), value0()));
+            }).join();
+            EXPECT(SQLitePerfDb(temp_file, false).FindRecord(other));
+        }
+
+        SQLitePerfDb db(temp_file, false);
+        Validate(db);
+
+        RunConcurrentSessions();
+    }
+
+private:
+    void RunConcurrentSessions()
+    {
+        std::cout << "Testing concurrent batched db writes..." << std::endl;
+
+        ResetDb();
+
+        // The sessions of all the threads end at once, and each commits its own records.
+        constexpr auto threads_count = 8;
+        auto ready                   = std::atomic<int>{0};
+        auto threads                 = std::vector<std::thread>{};
+        for(auto i = 0; i < threads_count; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                const auto session = db_inst.BeginWriteSession();
+                EXPECT(db_inst.Update(ProblemData(i + 1), id0(), value0()));
+                EXPECT(db_inst.Update(ProblemData(i + 1), id1(), value1()));
+                ++ready;
+                while(ready < threads_count)
+                    std::this_thread::yield();
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        SQLitePerfDb db(temp_file, false);
+        for(auto i = 0; i < threads_count; ++i)
+        {
+            SolverData read0, read1;
+            EXPECT(db.Load(ProblemData(i + 1), id0(), read0));
+            EXPECT(db.Load(ProblemData(i + 1), id1(), read1));
+            EXPECT_EQUAL(read0, value0());
+            EXPECT_EQUAL(read1, value1());
+        }
+    }
+
+    static void Validate(SQLitePerfDb& db)
+    {
+        SolverData read0, read1, read2;
+        EXPECT(db.Load(key(), id0(), read0));
+        EXPECT(db.Load(key(), id1(), read1));
+        EXPECT(!db.Load(key(), id2(), read2));
+        EXPECT_EQUAL(read0, value0());
+        EXPECT_EQUAL(read1, value1());
+    }
+};
+
 class DbParallelTest : public DbTest
 {
 public:
@@ -1253,6 +1339,7 @@ struct PerfDbDriver : test_driver
         }
         DbFindTest().Run();
         DbOperationsTest().Run();
+        DbWriteSessionTest().Run();
         DbParallelTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Compacts a user kernel database (*.ukdb): moves code objects still stored inline into the
+// shared blob table, drops code objects no record refers to and, optionally, recompresses the
+// remaining ones with another codec.
+
+#include <miopen/kern_db.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    if(argc != 2 && !(argc == 4 && std::string{argv[2]} == "--codec"))
+    {
+        std::cerr << "Usage: " << argv[0] << " <file.ukdb> [--codec lz4|bz2]" << std::endl;
+        return 1;
+    }
+
+    const std::string path = argv[1];
+    auto recompress        = boost::optional<miopen::KernelCodec>{};
+    if(argc == 4)
+    {
+        const std::string codec = argv[3];
+        if(codec == "lz4")
+            recompress = miopen::KernelCodec::Lz4;
+        else if(codec == "bz2")
+            recompress = miopen::KernelCodec::Bzip2;
+        else
+        {
+            std::cerr << "Unknown codec: " << codec << std::endl;
+            return 1;
+        }
+    }
+
+    if(!boost::filesystem::exists(path))
+    {
+        std::cerr << "No such file: " << path << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        const auto size_before = boost::filesystem::file_size(path);
+        auto db                = miopen::KernDb{path, false};
+        const auto stats       = db.Compact(recompress);
+        const auto size_after  = boost::filesystem::file_size(path);
+
+        std::cout << path << ": " << stats.moved << " moved, " << stats.removed << " removed, "
+                  << stats.recompressed << " recompressed, " << size_before << " -> "
+                  << size_after << " bytes" << std::endl;
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << "Unable to compact " << path << ": " << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
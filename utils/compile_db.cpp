@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Converts text system databases (e.g. *.fdb.txt) to the binary form which ReadonlyRamDb uses
+// without parsing. By default the output is placed where ReadonlyRamDb looks for it.
+
+#include <miopen/compiled_db.hpp>
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input.txt> [output.bin]" << std::endl;
+        return 1;
+    }
+
+    const std::string input  = argv[1];
+    const std::string output = argc == 3 ? argv[2] : miopen::CompiledDb::GetCompiledPath(input);
+
+    if(!miopen::CompiledDb::Compile(input, output))
+    {
+        std::cerr << "Unable to compile " << input << " to " << output << std::endl;
+        return 1;
+    }
+
+    const auto compiled = miopen::CompiledDb::Open(output);
+    if(compiled == nullptr)
+    {
+        std::cerr << "Unable to open compiled " << output << std::endl;
+        return 1;
+    }
+
+    std::cout << input << " -> " << output << ": " << compiled->GetRecordCount() << " records"
+              << std::endl;
+    return 0;
+}
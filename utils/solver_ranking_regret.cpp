@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Evaluates the solver ranking model used by the immediate mode fallback against a find-db:
+// for every convolution in it, compares the time of the solver the model ranks first with the
+// time of the fastest solver Find() measured. The model is read from the system db directory,
+// which MIOPEN_SYSTEM_DB_PATH overrides.
+//
+// Records the model was trained on should not be evaluated. With --holdout P only the records
+// whose key has a 32-bit FNV-1a hash below P modulo 100 are, so the training has to leave out
+// the same records.
+
+#include <miopen/conv/heuristic_model/solver_ranking.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::uint32_t Fnv1a(const std::string& str)
+{
+    auto hash = std::uint32_t{2166136261u};
+    for(const auto c : str)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/// Returns the times Find() measured, by solver. Entries in the old format, which are keyed by
+/// algorithm, are ignored.
+std::unordered_map<std::string, float> GetMeasuredTimes(const std::string& contents)
+{
+    auto times = std::unordered_map<std::string, float>{};
+    for(const auto& entry : miopen::SplitDelim(contents, ';'))
+    {
+        const auto colon = entry.find(':');
+        if(colon == std::string::npos)
+            continue;
+        auto data = miopen::FindDbData{};
+        if(data.Deserialize(entry.substr(colon + 1)) && data.time > 0)
+            times[entry.substr(0, colon)] = data.time;
+    }
+    return times;
+}
+
+double Percentile(std::vector<double> values, double p)
+{
+    const auto n = static_cast<std::size_t>(p * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + n, values.end());
+    return values[n];
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if(argc != 3 && !(argc == 5 && std::string{argv[3]} == "--holdout"))
+    {
+        std::cerr << "Usage: " << argv[0] << " <arch> <find-db.txt> [--holdout <percent>]"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string arch = argv[1];
+    const std::string path = argv[2];
+    const auto holdout     = argc == 5 ? std::atoi(argv[4]) : 100;
+    if(holdout <= 0 || holdout > 100)
+    {
+        std::cerr << "The holdout percentage has to be in (0, 100]" << std::endl;
+        return 1;
+    }
+
+    const auto model = miopen::ai::ranking::SolverRankingModel::Get(arch);
+    if(model == nullptr)
+    {
+        std::cerr << "No solver ranking model for " << arch << " in " << miopen::GetSystemDbPath()
+                  << std::endl;
+        return 1;
+    }
+
+    auto file = std::ifstream{path};
+    if(!file)
+    {
+        std::cerr << "Unable to open " << path << std::endl;
+        return 1;
+    }
+
+    auto regrets = std::vector<double>{};
+    auto hits    = std::size_t{0};
+    auto skipped = std::size_t{0};
+    auto line    = std::string{};
+
+    try
+    {
+        while(std::getline(file, line))
+        {
+            const auto eq = line.find('=');
+            if(eq == std::string::npos)
+                continue;
+            const auto key = line.substr(0, eq);
+            if(Fnv1a(key) % 100 >= static_cast<std::uint32_t>(holdout))
+                continue;
+
+            const auto measured = GetMeasuredTimes(line.substr(eq + 1));
+            auto predicted      = std::unordered_map<std::string, float>{};
+            if(measured.empty() || !model->Predict(key, predicted))
+            {
+                ++skipped;
+                continue;
+            }
+
+            // Only the solvers Find() measured were applicable, so the model picks among them.
+            auto best_time   = std::numeric_limits<float>::max();
+            auto best_solver = std::string{};
+            auto picked      = measured.end();
+            auto picked_time = std::numeric_limits<float>::max();
+            for(auto it = measured.begin(); it != measured.end(); ++it)
+            {
+                if(it->second < best_time)
+                {
+                    best_time   = it->second;
+                    best_solver = it->first;
+                }
+                const auto prediction = predicted.find(it->first);
+                if(prediction != predicted.end() && prediction->second < picked_time)
+                {
+                    picked      = it;
+                    picked_time = prediction->second;
+                }
+            }
+            if(picked == measured.end())
+            {
+                ++skipped;
+                continue;
+            }
+
+            if(picked->first == best_solver)
+                ++hits;
+            regrets.push_back(picked->second / best_time - 1.0);
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << "Unable to evaluate " << path << ": " << ex.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << path << ": " << regrets.size() << " records evaluated, " << skipped
+              << " skipped" << std::endl;
+    if(regrets.empty())
+        return 0;
+
+    auto log_sum = 0.0;
+    for(const auto regret : regrets)
+        log_sum += std::log1p(regret);
+    const auto mean_regret = std::accumulate(regrets.begin(), regrets.end(), 0.0) / regrets.size();
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "top-1 accuracy: " << static_cast<double>(hits) / regrets.size() << std::endl
+              << "top-1 regret (time of the top-ranked solver / best time - 1): mean "
+              << mean_regret << ", geomean " << std::expm1(log_sum / regrets.size())
+              << ", median " << Percentile(regrets, 0.5) << ", p90 " << Percentile(regrets, 0.9)
+              << ", max " << *std::max_element(regrets.begin(), regrets.end()) << std::endl;
+    return 0;
+}